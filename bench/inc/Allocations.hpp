@@ -0,0 +1,61 @@
+/**
+ * @file Allocations.hpp
+ * @brief Header file declaring the heap allocation counter of the benchmarks
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the declaration of Bench::AllocationScope, which
+ * counts the heap allocations made while it is alive. The counting comes
+ * from replacements of the global operator new and delete that are linked
+ * into bin/library_bench only; the main program keeps the standard ones.
+ */
+
+ #ifndef BENCH_ALLOCATIONS_HPP
+ #define BENCH_ALLOCATIONS_HPP
+
+ #include <cstdint>
+
+ namespace Bench {
+     /**
+      * @class AllocationScope
+      * @brief Counts the heap allocations of every thread during its lifetime
+      *
+      * Outside of any scope the replaced operators cost one relaxed atomic
+      * load on top of malloc. Allocations of all threads are counted, so
+      * work handed to the thread pool is included; the caller must make
+      * sure nothing else runs concurrently.
+      */
+     class AllocationScope {
+     public:
+         /**
+          * @brief Starts counting
+          */
+         AllocationScope();
+
+         /**
+          * @brief Stops counting
+          */
+         ~AllocationScope();
+
+         AllocationScope(const AllocationScope&) = delete;
+         AllocationScope& operator=(const AllocationScope&) = delete;
+
+         /**
+          * @brief Gets the allocations made since construction
+          * @return Calls of operator new (all forms)
+          */
+         std::uint64_t allocations() const;
+
+         /**
+          * @brief Gets the bytes requested since construction
+          * @return Sum of the requested sizes
+          */
+         std::uint64_t bytes() const;
+
+     private:
+         std::uint64_t startAllocations;
+         std::uint64_t startBytes;
+     };
+ }
+
+ #endif // BENCH_ALLOCATIONS_HPP
@@ -0,0 +1,176 @@
+/**
+ * @file Harness.hpp
+ * @brief Header file declaring the benchmark harness
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the declaration of the Bench namespace: timing of an
+ * operation with warmup and repetitions, alone or from several threads at
+ * once, the summary statistics reported for it, memory samples, and the
+ * table and JSON output of a benchmark run.
+ */
+
+ #ifndef BENCH_HARNESS_HPP
+ #define BENCH_HARNESS_HPP
+
+ #include <cstddef>
+ #include <cstdint>
+ #include <functional>
+ #include <string>
+ #include <vector>
+
+ /**
+  * @namespace Bench
+  * @brief Namespace containing the benchmark harness
+  *
+  * Every call of the measured operation is timed on its own with
+  * std::chrono::steady_clock, so latencies include the cost of reading the
+  * clock (a few tens of nanoseconds). Each repetition runs the operation
+  * until it has taken at least minTimeMs; the per-repetition means are
+  * kept in the results so two runs can be compared statistically.
+  */
+ namespace Bench {
+     /**
+      * @struct Options
+      * @brief How long and how often an operation is measured
+      */
+     struct Options {
+         std::size_t repetitions = 5;      ///< Timed repetitions
+         std::size_t warmupOps = 100;      ///< Untimed calls before the first repetition...
+         double warmupMs = 50.0;           ///< ...or fewer, once this much time has passed
+         double minTimeMs = 100.0;         ///< Minimum duration of one repetition
+         std::size_t maxOpsPerRep = 1000000;  ///< Calls after which a repetition ends early
+         std::size_t allocationOps = 100;  ///< Calls whose heap allocations are counted (at most maxOpsPerRep)
+     };
+
+     /**
+      * @struct Result
+      * @brief Summary of one operation at one catalog size
+      */
+     struct Result {
+         std::string name;                 ///< Operation name
+         std::size_t size = 0;             ///< Catalog size the operation ran against
+         std::uint64_t ops = 0;            ///< Timed calls over all repetitions
+         double meanNs = 0;                ///< Mean latency
+         double p50Ns = 0;                 ///< Median latency
+         double p99Ns = 0;                 ///< 99th percentile latency
+         double opsPerSec = 0;             ///< Calls per second of measured time
+         std::vector<double> repMeanNs;    ///< Mean latency of each repetition
+         double allocsPerOp = 0;           ///< Heap allocations per call (see Allocations.hpp)
+         double allocBytesPerOp = 0;       ///< Heap bytes requested per call
+         std::size_t threads = 0;          ///< Threads calling at once (0: measure() on one thread)
+         std::size_t shards = 0;           ///< Shards, when the result is part of a shard sweep
+
+         /**
+          * @brief Gets the name shown in the table, with threads and shards
+          * @return e.g. "findBookById x8" or "addBook x8 4sh"
+          */
+         std::string label() const;
+     };
+
+     /**
+      * @struct MemorySample
+      * @brief Memory held by one subsystem after one phase of a run
+      */
+     struct MemorySample {
+         std::size_t size = 0;             ///< Catalog size of the run
+         std::string phase;                ///< Phase the sample closes, e.g. "build"
+         std::string subsystem;            ///< Memory::subsystemName()
+         std::int64_t liveBytes = 0;       ///< Bytes held at the end of the phase
+         std::int64_t peakBytes = 0;       ///< Most bytes held during the phase
+         std::uint64_t allocations = 0;    ///< Allocations made during the phase
+     };
+
+     /**
+      * @brief Starts a memory phase: resets the peaks of the accounting
+      *
+      * @return Allocation counts of every subsystem at the start, to be
+      *         passed to sampleMemory()
+      */
+     std::vector<std::uint64_t> beginMemoryPhase();
+
+     /**
+      * @brief Samples every subsystem that held or allocated memory in a phase
+      *
+      * @param size Catalog size of the run
+      * @param phase Name of the phase
+      * @param start Value returned by beginMemoryPhase()
+      * @return One sample per active subsystem
+      */
+     std::vector<MemorySample> sampleMemory(std::size_t size, const std::string& phase,
+                                            const std::vector<std::uint64_t>& start);
+
+     /**
+      * @brief Prints memory samples as a table to standard output
+      * @param samples The samples
+      */
+     void printMemory(const std::vector<MemorySample>& samples);
+
+     /**
+      * @brief Measures an operation
+      *
+      * After the timed repetitions, up to Options::allocationOps further
+      * calls (fewer if they take longer than minTimeMs) are made with heap
+      * allocations counted.
+      *
+      * @param name Operation name
+      * @param size Catalog size the operation runs against
+      * @param options Warmup and repetition settings
+      * @param op The operation; receives a call counter that never repeats
+      *        within one measurement (warmup included)
+      * @return The summary
+      */
+     Result measure(const std::string& name, std::size_t size, const Options& options,
+                    const std::function<void(std::uint64_t)>& op);
+
+     /**
+      * @brief Measures the throughput of an operation called from several threads at once
+      *
+      * Each repetition starts the threads together and lets them call the
+      * operation until minTimeMs has passed or together they have made
+      * maxOpsPerRep calls. The result's opsPerSec is the combined
+      * throughput, its latencies are those of the single calls, and its
+      * repMeanNs hold the wall time per call (the inverse throughput) of
+      * each repetition. Allocations are not counted.
+      *
+      * @param name Operation name
+      * @param size Catalog size the operation runs against
+      * @param threads Threads calling the operation
+      * @param options Warmup and repetition settings
+      * @param op The operation; must be safe to call concurrently and
+      *        receives a call counter that never repeats across threads
+      * @return The summary
+      */
+     Result measureConcurrent(const std::string& name, std::size_t size, std::size_t threads,
+                              const Options& options, const std::function<void(std::uint64_t)>& op);
+
+     /**
+      * @brief Prints the column titles of the result table to standard output
+      */
+     void printHeader();
+
+     /**
+      * @brief Prints one result as a table row to standard output
+      * @param result The result
+      */
+     void printResult(const Result& result);
+
+     /**
+      * @brief Writes a run's results as JSON
+      *
+      * The file holds "schema", "timestamp", the "config" object passed in,
+      * a "results" array with one object per Result (latencies in
+      * nanoseconds, keys in snake_case; "threads" and "shards" only where
+      * set) and a "memory" array with one object per MemorySample.
+      *
+      * @param path File to write
+      * @param configJson Settings of the run, already serialized as a JSON object
+      * @param results The results
+      * @param memory The memory samples
+      * @return true if the file was written, false otherwise (reported to stderr)
+      */
+     bool writeJson(const std::string& path, const std::string& configJson, const std::vector<Result>& results,
+                    const std::vector<MemorySample>& memory);
+ }
+
+ #endif // BENCH_HARNESS_HPP
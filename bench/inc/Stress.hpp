@@ -0,0 +1,53 @@
+/**
+ * @file Stress.hpp
+ * @brief Header file declaring the borrow/return stress check
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the declaration of Bench::runStress, which races many
+ * threads borrowing and returning the same books of one Library and checks
+ * that every copy is won exactly once and that the borrowed count agrees
+ * with the availability flags afterwards.
+ */
+
+ #ifndef BENCH_STRESS_HPP
+ #define BENCH_STRESS_HPP
+
+ #include <cstddef>
+ #include <string>
+
+ namespace Bench {
+     /**
+      * @struct StressOptions
+      * @brief Shape of a stress run
+      */
+     struct StressOptions {
+         std::size_t books = 1000;      ///< Books in the catalog, one copy each
+         std::size_t threads = 64;      ///< Threads racing for them
+         std::size_t shards = 4;        ///< Shards the catalog is split into
+         std::size_t rounds = 10;       ///< Borrow-all/return-all rounds
+         std::size_t mixedOps = 2000;   ///< Calls per thread in the mixed phase
+     };
+
+     /**
+      * @brief Races threads borrowing and returning the same books
+      *
+      * Three phases run against one Library with auto-save off:
+      * - borrow race: every thread tries to borrow every book, starting at
+      *   a different book; exactly one borrowBook per book may succeed and
+      *   afterwards borrowedCount() is the catalog size;
+      * - return race: the same with returnBook, ending at a count of 0;
+      *   both races are repeated for the given rounds;
+      * - mixed: every thread makes random borrowBook, returnBook,
+      *   borrowBooks and returnBooks calls; the successful ones must leave
+      *   each book borrowed exactly when its flag says so, and
+      *   borrowedCount() must equal the number of borrowed flags.
+      *
+      * @param options Shape of the run
+      * @param dataFile Data file of the Library (never written)
+      * @return false if any check failed (every failure is reported to stderr)
+      */
+     bool runStress(const StressOptions& options, const std::string& dataFile);
+ }
+
+ #endif // BENCH_STRESS_HPP
@@ -0,0 +1,111 @@
+/**
+ * @file Allocations.cpp
+ * @brief Implementation of the heap allocation counter of the benchmarks
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file replaces the global operator new and delete of
+ * bin/library_bench and implements Bench::AllocationScope on top of them.
+ * The array and nothrow forms of the standard library forward to the
+ * replaced single-object forms, so replacing those (plain and aligned) is
+ * enough to see every allocation.
+ */
+
+ #include "Allocations.hpp"
+ #include <atomic>
+ #include <cstdlib>
+ #include <new>
+
+ namespace {
+
+ /// @brief Number of live AllocationScope objects
+ std::atomic<int> activeScopes{0};
+
+ /// @brief Allocations counted while a scope was alive
+ std::atomic<std::uint64_t> allocationCount{0};
+
+ /// @brief Bytes requested while a scope was alive
+ std::atomic<std::uint64_t> allocatedBytes{0};
+
+ /**
+  * @brief Counts one allocation if a scope is alive
+  * @param size Requested size
+  */
+ void count(std::size_t size) {
+     if (activeScopes.load(std::memory_order_relaxed) > 0) {
+         allocationCount.fetch_add(1, std::memory_order_relaxed);
+         allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+     }
+ }
+
+ } // namespace
+
+ void* operator new(std::size_t size) {
+     count(size);
+     if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+         return pointer;
+     }
+     throw std::bad_alloc();
+ }
+
+ void* operator new(std::size_t size, std::align_val_t alignment) {
+     count(size);
+     std::size_t align = static_cast<std::size_t>(alignment);
+     // aligned_alloc wants a size that is a multiple of the alignment
+     std::size_t rounded = (size + align - 1) / align * align;
+     if (void* pointer = std::aligned_alloc(align, rounded == 0 ? align : rounded)) {
+         return pointer;
+     }
+     throw std::bad_alloc();
+ }
+
+ void operator delete(void* pointer) noexcept {
+     std::free(pointer);
+ }
+
+ void operator delete(void* pointer, std::size_t) noexcept {
+     std::free(pointer);
+ }
+
+ void operator delete(void* pointer, std::align_val_t) noexcept {
+     std::free(pointer);
+ }
+
+ void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+     std::free(pointer);
+ }
+
+ namespace Bench {
+
+ /**
+  * @brief Constructor implementation
+  */
+ AllocationScope::AllocationScope()
+     : startAllocations(allocationCount.load()), startBytes(allocatedBytes.load()) {
+     activeScopes.fetch_add(1);
+ }
+
+ /**
+  * @brief Destructor implementation
+  */
+ AllocationScope::~AllocationScope() {
+     activeScopes.fetch_sub(1);
+ }
+
+ /**
+  * @brief Implementation of the allocations method
+  * @return Allocations since construction
+  */
+ std::uint64_t AllocationScope::allocations() const {
+     return allocationCount.load() - startAllocations;
+ }
+
+ /**
+  * @brief Implementation of the bytes method
+  * @return Bytes requested since construction
+  */
+ std::uint64_t AllocationScope::bytes() const {
+     return allocatedBytes.load() - startBytes;
+ }
+
+ } // namespace Bench
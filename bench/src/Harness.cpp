@@ -0,0 +1,396 @@
+/**
+ * @file Harness.cpp
+ * @brief Implementation of the benchmark harness
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements the Bench namespace declared in Harness.hpp.
+ */
+
+ #include "Harness.hpp"
+ #include "Allocations.hpp"
+ #include "Memory.hpp"
+ #include <algorithm>
+ #include <atomic>
+ #include <chrono>
+ #include <ctime>
+ #include <fstream>
+ #include <iomanip>
+ #include <iostream>
+ #include <sstream>
+ #include <thread>
+ #include <nlohmann/json.hpp>
+
+ using Clock = std::chrono::steady_clock;
+ using json = nlohmann::json;
+
+ namespace {
+
+ /**
+  * @brief Gets a percentile of sorted latencies
+  *
+  * @param sorted Latencies in ascending order (not empty)
+  * @param fraction Percentile as a fraction, e.g. 0.99
+  * @return The latency at that rank
+  */
+ double percentile(const std::vector<std::uint64_t>& sorted, double fraction) {
+     std::size_t rank = static_cast<std::size_t>(fraction * static_cast<double>(sorted.size() - 1));
+     return static_cast<double>(sorted[rank]);
+ }
+
+ /**
+  * @brief Formats nanoseconds with a readable unit
+  * @param ns Duration in nanoseconds
+  * @return Text such as "812 ns", "14.2 us" or "3.05 ms"
+  */
+ std::string formatDuration(double ns) {
+     std::ostringstream text;
+     text << std::fixed;
+     if (ns < 1e3) {
+         text << std::setprecision(0) << ns << " ns";
+     } else if (ns < 1e6) {
+         text << std::setprecision(1) << ns / 1e3 << " us";
+     } else if (ns < 1e9) {
+         text << std::setprecision(2) << ns / 1e6 << " ms";
+     } else {
+         text << std::setprecision(2) << ns / 1e9 << " s";
+     }
+     return text.str();
+ }
+
+ } // namespace
+
+ namespace Bench {
+
+ /**
+  * @brief Implementation of the measure function
+  *
+  * @param name Operation name
+  * @param size Catalog size the operation runs against
+  * @param options Warmup and repetition settings
+  * @param op The operation
+  * @return The summary
+  */
+ Result measure(const std::string& name, std::size_t size, const Options& options,
+                const std::function<void(std::uint64_t)>& op) {
+     std::uint64_t call = 0;
+
+     // Warm caches and lazily built state without recording anything
+     Clock::time_point warmupStart = Clock::now();
+     while (call < options.warmupOps &&
+            std::chrono::duration<double, std::milli>(Clock::now() - warmupStart).count() < options.warmupMs) {
+         op(call++);
+     }
+
+     Result result;
+     result.name = name;
+     result.size = size;
+     std::vector<std::uint64_t> latencies;
+     double totalNs = 0;
+
+     for (std::size_t rep = 0; rep < options.repetitions; ++rep) {
+         std::uint64_t repOps = 0;
+         double repNs = 0;
+         Clock::time_point repStart = Clock::now();
+         Clock::time_point end = repStart;
+         do {
+             Clock::time_point start = Clock::now();
+             op(call++);
+             end = Clock::now();
+
+             auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+             latencies.push_back(static_cast<std::uint64_t>(elapsed));
+             repNs += static_cast<double>(elapsed);
+             ++repOps;
+         } while (repOps < options.maxOpsPerRep &&
+                  std::chrono::duration<double, std::milli>(end - repStart).count() < options.minTimeMs);
+
+         result.repMeanNs.push_back(repNs / static_cast<double>(repOps));
+         totalNs += repNs;
+     }
+
+     std::sort(latencies.begin(), latencies.end());
+     result.ops = latencies.size();
+     result.meanNs = totalNs / static_cast<double>(result.ops);
+     result.p50Ns = percentile(latencies, 0.50);
+     result.p99Ns = percentile(latencies, 0.99);
+     result.opsPerSec = totalNs > 0 ? static_cast<double>(result.ops) * 1e9 / totalNs : 0;
+
+     // Count allocations on separate calls, away from the bookkeeping above;
+     // slow operations stop after minTimeMs like a repetition does
+     std::size_t limit = std::min(options.allocationOps, options.maxOpsPerRep);
+     if (limit > 0) {
+         std::size_t countedOps = 0;
+         Clock::time_point countStart = Clock::now();
+         AllocationScope scope;
+         do {
+             op(call++);
+             ++countedOps;
+         } while (countedOps < limit &&
+                  std::chrono::duration<double, std::milli>(Clock::now() - countStart).count() < options.minTimeMs);
+         result.allocsPerOp = static_cast<double>(scope.allocations()) / static_cast<double>(countedOps);
+         result.allocBytesPerOp = static_cast<double>(scope.bytes()) / static_cast<double>(countedOps);
+     }
+     return result;
+ }
+
+ /**
+  * @brief Implementation of the measureConcurrent function
+  *
+  * The threads wait at a start flag so they begin together; each times
+  * its own calls into a vector of its own, so the measurement shares no
+  * data between them. Thread t makes calls t, t + threads, t + 2 * threads
+  * and so on of the repetition.
+  *
+  * @param name Operation name
+  * @param size Catalog size the operation runs against
+  * @param threads Threads calling the operation
+  * @param options Warmup and repetition settings
+  * @param op The operation
+  * @return The summary
+  */
+ Result measureConcurrent(const std::string& name, std::size_t size, std::size_t threads,
+                          const Options& options, const std::function<void(std::uint64_t)>& op) {
+     threads = std::max<std::size_t>(threads, 1);
+     std::uint64_t call = 0;
+
+     Clock::time_point warmupStart = Clock::now();
+     while (call < options.warmupOps &&
+            std::chrono::duration<double, std::milli>(Clock::now() - warmupStart).count() < options.warmupMs) {
+         op(call++);
+     }
+
+     Result result;
+     result.name = name;
+     result.size = size;
+     result.threads = threads;
+     std::vector<std::uint64_t> latencies;
+     double totalWallNs = 0;
+     std::size_t opsPerThread = std::max<std::size_t>(1, options.maxOpsPerRep / threads);
+
+     for (std::size_t rep = 0; rep < options.repetitions; ++rep) {
+         std::atomic<bool> go{false};
+         std::atomic<bool> stop{false};
+         std::atomic<std::size_t> finished{0};
+         std::vector<std::vector<std::uint64_t>> timings(threads);
+         std::vector<std::thread> workers;
+         std::uint64_t first = call;
+         for (std::size_t t = 0; t < threads; ++t) {
+             workers.emplace_back([&, t] {
+                 std::vector<std::uint64_t>& mine = timings[t];
+                 mine.reserve(std::min<std::size_t>(opsPerThread, 1 << 20));
+                 while (!go.load(std::memory_order_acquire)) {
+                     std::this_thread::yield();
+                 }
+                 for (std::size_t i = 0; i < opsPerThread && !stop.load(std::memory_order_relaxed); ++i) {
+                     Clock::time_point start = Clock::now();
+                     op(first + i * threads + t);
+                     auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+                     mine.push_back(static_cast<std::uint64_t>(elapsed.count()));
+                 }
+                 finished.fetch_add(1);
+             });
+         }
+
+         Clock::time_point repStart = Clock::now();
+         go.store(true, std::memory_order_release);
+         while (finished.load() < threads &&
+                std::chrono::duration<double, std::milli>(Clock::now() - repStart).count() < options.minTimeMs) {
+             std::this_thread::sleep_for(std::chrono::microseconds(500));
+         }
+         stop = true;
+         for (std::thread& worker : workers) {
+             worker.join();
+         }
+         double wallNs = std::chrono::duration<double, std::nano>(Clock::now() - repStart).count();
+
+         std::size_t repOps = 0;
+         std::size_t longest = 0;
+         for (const std::vector<std::uint64_t>& mine : timings) {
+             repOps += mine.size();
+             longest = std::max(longest, mine.size());
+             latencies.insert(latencies.end(), mine.begin(), mine.end());
+         }
+         call = first + longest * threads;
+         result.repMeanNs.push_back(wallNs / static_cast<double>(std::max<std::size_t>(repOps, 1)));
+         totalWallNs += wallNs;
+     }
+
+     std::sort(latencies.begin(), latencies.end());
+     result.ops = latencies.size();
+     if (result.ops > 0) {
+         double sum = 0;
+         for (std::uint64_t latency : latencies) {
+             sum += static_cast<double>(latency);
+         }
+         result.meanNs = sum / static_cast<double>(result.ops);
+         result.p50Ns = percentile(latencies, 0.50);
+         result.p99Ns = percentile(latencies, 0.99);
+     }
+     result.opsPerSec = totalWallNs > 0 ? static_cast<double>(result.ops) * 1e9 / totalWallNs : 0;
+     return result;
+ }
+
+ /**
+  * @brief Implementation of the label method
+  * @return Name with thread and shard counts
+  */
+ std::string Result::label() const {
+     std::string text = name;
+     if (threads > 0) {
+         text += " x" + std::to_string(threads);
+     }
+     if (shards > 0) {
+         text += " " + std::to_string(shards) + "sh";
+     }
+     return text;
+ }
+
+ /**
+  * @brief Implementation of the printHeader function
+  */
+ void printHeader() {
+     std::cout << std::left << std::setw(32) << "operation" << std::right
+               << std::setw(10) << "size" << std::setw(10) << "ops"
+               << std::setw(12) << "mean" << std::setw(12) << "p50" << std::setw(12) << "p99"
+               << std::setw(14) << "ops/s" << std::setw(12) << "allocs/op" << "\n";
+ }
+
+ /**
+  * @brief Implementation of the printResult function
+  * @param result The result
+  */
+ void printResult(const Result& result) {
+     std::cout << std::left << std::setw(32) << result.label() << std::right
+               << std::setw(10) << result.size << std::setw(10) << result.ops
+               << std::setw(12) << formatDuration(result.meanNs)
+               << std::setw(12) << formatDuration(result.p50Ns)
+               << std::setw(12) << formatDuration(result.p99Ns)
+               << std::setw(14) << std::fixed << std::setprecision(0) << result.opsPerSec;
+     // Allocations are only counted for calls made on one thread
+     if (result.threads > 0) {
+         std::cout << std::setw(12) << "-" << std::endl;
+     } else {
+         std::cout << std::setw(12) << std::setprecision(1) << result.allocsPerOp << std::endl;
+     }
+ }
+
+ /**
+  * @brief Implementation of the beginMemoryPhase function
+  * @return Allocation counts at the start of the phase
+  */
+ std::vector<std::uint64_t> beginMemoryPhase() {
+     Memory::resetPeaks();
+     std::vector<std::uint64_t> start;
+     for (std::size_t i = 0; i < Memory::kSubsystemCount; ++i) {
+         start.push_back(Memory::usage(static_cast<Memory::Subsystem>(i)).allocations);
+     }
+     return start;
+ }
+
+ /**
+  * @brief Implementation of the sampleMemory function
+  *
+  * @param size Catalog size of the run
+  * @param phase Name of the phase
+  * @param start Allocation counts at the start of the phase
+  * @return The samples
+  */
+ std::vector<MemorySample> sampleMemory(std::size_t size, const std::string& phase,
+                                        const std::vector<std::uint64_t>& start) {
+     std::vector<MemorySample> samples;
+     for (std::size_t i = 0; i < Memory::kSubsystemCount; ++i) {
+         Memory::Subsystem subsystem = static_cast<Memory::Subsystem>(i);
+         Memory::Usage usage = Memory::usage(subsystem);
+         MemorySample sample;
+         sample.size = size;
+         sample.phase = phase;
+         sample.subsystem = Memory::subsystemName(subsystem);
+         sample.liveBytes = usage.liveBytes;
+         sample.peakBytes = usage.peakBytes;
+         sample.allocations = usage.allocations - (i < start.size() ? start[i] : 0);
+         if (sample.peakBytes != 0 || sample.allocations != 0) {
+             samples.push_back(std::move(sample));
+         }
+     }
+     return samples;
+ }
+
+ /**
+  * @brief Implementation of the printMemory function
+  * @param samples The samples
+  */
+ void printMemory(const std::vector<MemorySample>& samples) {
+     for (const MemorySample& sample : samples) {
+         std::cout << std::left << std::setw(32) << ("  memory " + sample.phase) << std::right
+                   << std::setw(10) << sample.size << "  " << std::left << std::setw(10) << sample.subsystem
+                   << std::right << std::fixed << std::setprecision(1)
+                   << std::setw(12) << static_cast<double>(sample.liveBytes) / 1048576.0 << " MiB live"
+                   << std::setw(10) << static_cast<double>(sample.peakBytes) / 1048576.0 << " MiB peak"
+                   << std::setw(12) << sample.allocations << " allocs" << std::endl;
+     }
+ }
+
+ /**
+  * @brief Implementation of the writeJson function
+  *
+  * @param path File to write
+  * @param configJson Settings of the run as a JSON object
+  * @param results The results
+  * @param memory The memory samples
+  * @return true if the file was written
+  */
+ bool writeJson(const std::string& path, const std::string& configJson, const std::vector<Result>& results,
+                const std::vector<MemorySample>& memory) {
+     std::time_t now = std::time(nullptr);
+     char timestamp[32];
+     std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+     json document;
+     document["schema"] = 1;
+     document["timestamp"] = timestamp;
+     document["config"] = json::parse(configJson);
+     document["results"] = json::array();
+     for (const Result& result : results) {
+         json entry = {
+             {"name", result.name},
+             {"size", result.size},
+             {"ops", result.ops},
+             {"mean_ns", result.meanNs},
+             {"p50_ns", result.p50Ns},
+             {"p99_ns", result.p99Ns},
+             {"ops_per_sec", result.opsPerSec},
+             {"rep_mean_ns", result.repMeanNs},
+             {"allocs_per_op", result.allocsPerOp},
+             {"alloc_bytes_per_op", result.allocBytesPerOp}
+         };
+         if (result.threads > 0) {
+             entry["threads"] = result.threads;
+         }
+         if (result.shards > 0) {
+             entry["shards"] = result.shards;
+         }
+         document["results"].push_back(entry);
+     }
+     document["memory"] = json::array();
+     for (const MemorySample& sample : memory) {
+         document["memory"].push_back({
+             {"size", sample.size},
+             {"phase", sample.phase},
+             {"subsystem", sample.subsystem},
+             {"live_bytes", sample.liveBytes},
+             {"peak_bytes", sample.peakBytes},
+             {"allocations", sample.allocations}
+         });
+     }
+
+     std::ofstream file(path, std::ios::trunc);
+     file << document.dump(2) << '\n';
+     if (!file) {
+         std::cerr << "Error writing benchmark results to " << path << std::endl;
+         return false;
+     }
+     return true;
+ }
+
+ } // namespace Bench
@@ -0,0 +1,244 @@
+/**
+ * @file Stress.cpp
+ * @brief Implementation of the borrow/return stress check
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements Bench::runStress declared in Stress.hpp.
+ */
+
+ #include "Stress.hpp"
+ #include <array>
+ #include <atomic>
+ #include <functional>
+ #include <iostream>
+ #include <memory>
+ #include <optional>
+ #include <random>
+ #include <thread>
+ #include <vector>
+ #include "Library.hpp"
+
+ namespace {
+
+ /**
+  * @brief Runs a function on several threads that all start at once
+  *
+  * @param threads Number of threads
+  * @param body Called with the thread number 0..threads-1
+  */
+ void race(std::size_t threads, const std::function<void(std::size_t)>& body) {
+     std::atomic<bool> go{false};
+     std::vector<std::thread> workers;
+     workers.reserve(threads);
+     for (std::size_t t = 0; t < threads; ++t) {
+         workers.emplace_back([&go, &body, t] {
+             while (!go.load(std::memory_order_acquire)) {
+                 std::this_thread::yield();
+             }
+             body(t);
+         });
+     }
+     go.store(true, std::memory_order_release);
+     for (std::thread& worker : workers) {
+         worker.join();
+     }
+ }
+
+ /**
+  * @brief Gets the book a thread visits at a step of a race
+  *
+  * Threads start at different books and odd threads walk backwards, so
+  * every book is fought over by threads arriving at different times.
+  *
+  * @param t Thread number
+  * @param step Step of the walk, 0..books-1
+  * @param options Shape of the run
+  * @return Book ID
+  */
+ int raceId(std::size_t t, std::size_t step, const Bench::StressOptions& options) {
+     std::size_t start = t * options.books / options.threads;
+     std::size_t offset = t % 2 == 0 ? step : options.books - 1 - step;
+     return static_cast<int>((start + offset) % options.books) + 1;
+ }
+
+ /**
+  * @brief Checks the borrowed count and the availability flags
+  *
+  * @param library The library
+  * @param borrowed Whether each book (ID - 1) must be borrowed
+  * @param phase Name of the phase, for the report
+  * @return false if anything disagrees (reported to stderr)
+  */
+ bool checkState(const Library& library, const std::vector<bool>& borrowed, const char* phase) {
+     bool ok = true;
+     std::size_t expected = 0;
+     std::size_t flagged = 0;
+     for (std::size_t i = 0; i < borrowed.size(); ++i) {
+         std::optional<Book> book = library.findBookById(static_cast<int>(i) + 1);
+         if (!book) {
+             std::cerr << "stress " << phase << ": book " << i + 1 << " is missing\n";
+             return false;
+         }
+         expected += borrowed[i] ? 1 : 0;
+         flagged += book->isAvailable() ? 0 : 1;
+         if (book->isAvailable() == borrowed[i]) {
+             std::cerr << "stress " << phase << ": book " << i + 1 << " is "
+                       << (book->isAvailable() ? "available" : "borrowed") << ", expected "
+                       << (borrowed[i] ? "borrowed" : "available") << "\n";
+             ok = false;
+         }
+     }
+     if (library.borrowedCount() != expected || flagged != expected) {
+         std::cerr << "stress " << phase << ": borrowedCount() is " << library.borrowedCount() << ", "
+                   << flagged << " books are flagged borrowed, expected " << expected << "\n";
+         ok = false;
+     }
+     return ok;
+ }
+
+ /**
+  * @brief Races every thread for every book with one operation
+  *
+  * @param library The library
+  * @param options Shape of the run
+  * @param borrowing true to race borrowBook, false to race returnBook
+  * @param round Round number, for the report
+  * @return false if a book was won other than exactly once (reported to stderr)
+  */
+ bool raceAll(Library& library, const Bench::StressOptions& options, bool borrowing, std::size_t round) {
+     std::unique_ptr<std::atomic<int>[]> wins(new std::atomic<int>[options.books]);
+     for (std::size_t i = 0; i < options.books; ++i) {
+         wins[i].store(0, std::memory_order_relaxed);
+     }
+     race(options.threads, [&](std::size_t t) {
+         for (std::size_t step = 0; step < options.books; ++step) {
+             int id = raceId(t, step, options);
+             if (borrowing ? library.borrowBook(id) : library.returnBook(id)) {
+                 wins[id - 1].fetch_add(1, std::memory_order_relaxed);
+             }
+         }
+     });
+
+     const char* phase = borrowing ? "borrow race" : "return race";
+     bool ok = true;
+     for (std::size_t i = 0; i < options.books; ++i) {
+         int count = wins[i].load(std::memory_order_relaxed);
+         if (count != 1) {
+             std::cerr << "stress " << phase << " round " << round << ": book " << i + 1 << " was "
+                       << (borrowing ? "borrowed" : "returned") << " " << count << " times\n";
+             ok = false;
+         }
+     }
+     return checkState(library, std::vector<bool>(options.books, borrowing), phase) && ok;
+ }
+
+ /**
+  * @brief Runs random single and batch borrows and returns from every thread
+  *
+  * Every successful call is tallied per book, so afterwards each book
+  * must have been borrowed once more than returned exactly when it is
+  * flagged borrowed. A batch that failed but still changed books would
+  * break this.
+  *
+  * @param library The library, with every book available
+  * @param options Shape of the run
+  * @return false if the tallies and flags disagree (reported to stderr)
+  */
+ bool mixed(Library& library, const Bench::StressOptions& options) {
+     std::unique_ptr<std::atomic<int>[]> net(new std::atomic<int>[options.books]);
+     for (std::size_t i = 0; i < options.books; ++i) {
+         net[i].store(0, std::memory_order_relaxed);
+     }
+     race(options.threads, [&](std::size_t t) {
+         std::mt19937 random(static_cast<std::mt19937::result_type>(t + 1));
+         for (std::size_t call = 0; call < options.mixedOps; ++call) {
+             std::size_t first = random() % options.books;
+             std::array<int, 3> ids;
+             for (std::size_t k = 0; k < ids.size(); ++k) {
+                 ids[k] = static_cast<int>((first + k * (options.books / 3 + 1)) % options.books) + 1;
+             }
+             switch (random() % 4) {
+                 case 0:
+                     if (library.borrowBook(ids[0])) {
+                         net[ids[0] - 1].fetch_add(1, std::memory_order_relaxed);
+                     }
+                     break;
+                 case 1:
+                     if (library.returnBook(ids[0])) {
+                         net[ids[0] - 1].fetch_sub(1, std::memory_order_relaxed);
+                     }
+                     break;
+                 case 2:
+                     if (library.borrowBooks(ids)) {
+                         for (int id : ids) {
+                             net[id - 1].fetch_add(1, std::memory_order_relaxed);
+                         }
+                     }
+                     break;
+                 default:
+                     if (library.returnBooks(ids)) {
+                         for (int id : ids) {
+                             net[id - 1].fetch_sub(1, std::memory_order_relaxed);
+                         }
+                     }
+                     break;
+             }
+         }
+     });
+
+     bool ok = true;
+     std::vector<bool> borrowed(options.books);
+     for (std::size_t i = 0; i < options.books; ++i) {
+         int count = net[i].load(std::memory_order_relaxed);
+         if (count != 0 && count != 1) {
+             std::cerr << "stress mixed: book " << i + 1 << " was borrowed " << count
+                       << " times more than it was returned\n";
+             ok = false;
+         }
+         borrowed[i] = count == 1;
+     }
+     return checkState(library, borrowed, "mixed") && ok;
+ }
+
+ } // namespace
+
+ namespace Bench {
+
+ /**
+  * @brief Implementation of the runStress function
+  *
+  * Stops after the first failing phase, since later ones start from its
+  * end state.
+  *
+  * @param options Shape of the run
+  * @param dataFile Data file of the Library
+  * @return false if any check failed
+  */
+ bool runStress(const StressOptions& options, const std::string& dataFile) {
+     // Three distinct books per batch
+     if (options.books < 3 || options.threads == 0) {
+         std::cerr << "stress: needs at least 3 books and 1 thread\n";
+         return false;
+     }
+     Library library(dataFile, options.shards);
+     library.setAutoSave(false);
+     for (std::size_t i = 0; i < options.books; ++i) {
+         library.addBook("Stress " + std::to_string(i), "Author " + std::to_string(i % 100), 2000);
+     }
+
+     for (std::size_t round = 1; round <= options.rounds; ++round) {
+         if (!raceAll(library, options, true, round) || !raceAll(library, options, false, round)) {
+             return false;
+         }
+     }
+     if (!mixed(library, options)) {
+         return false;
+     }
+     std::cout << "stress: " << options.books << " books, " << options.threads << " threads, "
+               << options.shards << " shards: " << options.rounds << " borrow/return rounds and "
+               << options.mixedOps << " mixed calls per thread ok\n";
+     return true;
+ }
+
+ } // namespace Bench
@@ -0,0 +1,438 @@
+/**
+ * @file library_bench.cpp
+ * @brief Benchmarks of the Library operations at several catalog sizes
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the entry point of bin/library_bench. For every
+ * requested size it builds a catalog of synthetic books in a scratch
+ * directory and measures addBook, findBookById, findBooksByTitle,
+ * borrowBook/returnBook, saving and loading with the harness from
+ * Harness.hpp, and samples the memory accounting after building the
+ * catalog, saving and loading. The lookups are also run from 1, 2, 4 and
+ * 8 reader threads at once (--threads) to show how reads scale, and
+ * addBook and borrowBook/returnBook from the largest of those thread
+ * counts against catalogs of 1, 4 and 16 shards (--writer-shards) to show
+ * how writers scale with sharding. Results are printed as a table and
+ * optionally written as JSON for later comparison. The heap allocations
+ * per call are checked against per-operation budgets, and the run fails
+ * if an operation allocates more than its budget.
+ *
+ * With --stress <threads> nothing is timed; instead that many threads
+ * race to borrow and return the books of each catalog size (Stress.hpp)
+ * and the run fails if any copy is won twice or the counts disagree.
+ */
+
+ #include <algorithm>
+ #include <cstdlib>
+ #include <filesystem>
+ #include <iostream>
+ #include <memory>
+ #include <sstream>
+ #include <string>
+ #include <unistd.h>
+ #include <vector>
+ #include <nlohmann/json.hpp>
+ #include "Harness.hpp"
+ #include "Stress.hpp"
+ #include "Catalog.hpp"
+ #include "Library.hpp"
+
+ namespace {
+
+ /// @brief Words titles are made of; a pair of them selects 1 in 256 books
+ const char* const kWords[16] = {
+     "Silent", "River", "Empire", "Shadow", "Garden", "Winter", "Glass", "Stone",
+     "Night", "House", "Secret", "Song", "Iron", "Crown", "Mirror", "Harbor"
+ };
+
+ /**
+  * @struct Budget
+  * @brief Most heap allocations one call of an operation may make
+  *
+  * The limit is fixed + perBook * catalog size, so operations whose work
+  * grows with the catalog scale their budget with it.
+  */
+ struct Budget {
+     const char* name;
+     double fixed;
+     double perBook;
+ };
+
+ /// @brief Allocation budgets; an operation allocating more fails the run
+ const Budget kBudgets[] = {
+     // The returned copy owns its title (synthetic authors fit inline)
+     {"findBookById", 1, 0},
+     // Flipping a flag in place; auto-save is off
+     {"borrowBook/returnBook", 0, 0},
+     // Copies of about 1 in 256 books plus a few partial lists per scan
+     {"findBooksByTitle", 16, 1.0 / 128},
+     // Copy-on-write of one chunk copies at most kChunkSize titles
+     {"addBook", Catalog::kChunkSize + 32, 0},
+     // The JSON documents: about 22 and 13 nodes and strings per book
+     {"saveBooks", 64, 32},
+     {"loadBooks", 64, 16},
+ };
+
+ /**
+  * @brief Checks every result against its allocation budget
+  *
+  * @param results The results
+  * @return false if any operation exceeded its budget (reported to stderr)
+  */
+ bool checkBudgets(const std::vector<Bench::Result>& results) {
+     bool withinBudget = true;
+     for (const Bench::Result& result : results) {
+         for (const Budget& budget : kBudgets) {
+             if (result.name != budget.name) {
+                 continue;
+             }
+             double limit = budget.fixed + budget.perBook * static_cast<double>(result.size);
+             if (result.allocsPerOp > limit) {
+                 std::cerr << "Allocation budget exceeded: " << result.name << " at size " << result.size
+                           << " makes " << result.allocsPerOp << " allocations per call (budget " << limit << ")\n";
+                 withinBudget = false;
+             }
+         }
+     }
+     return withinBudget;
+ }
+
+ /**
+  * @struct Settings
+  * @brief Command line settings
+  */
+ struct Settings {
+     std::vector<std::size_t> sizes{1000, 10000, 100000};
+     std::vector<std::size_t> threads{1, 2, 4, 8};   ///< Thread counts of the concurrent runs
+     std::size_t shards = 1;
+     std::vector<std::size_t> writerShards{1, 4, 16};  ///< Shard counts of the concurrent writer runs
+     std::size_t stressThreads = 0;  ///< Threads of the stress check instead of benchmarks (0: none)
+     std::string filter;     ///< Only operations whose name contains this
+     std::string jsonPath;   ///< Where to write JSON results (none if empty)
+     Bench::Options options;
+ };
+
+ /**
+  * @brief Prints the command line usage to standard error
+  * @param program Name the program was started as
+  */
+ void printUsage(const char* program) {
+     std::cerr << "Usage: " << program << " [options]\n"
+               << "  --sizes <n,n,...>   catalog sizes (default 1000,10000,100000; up to 10000000)\n"
+               << "  --shards <n>        library shards (default 1)\n"
+               << "  --threads <n,n,...> thread counts of the concurrent runs (default 1,2,4,8; 0 skips them)\n"
+               << "  --writer-shards <n,n,...>\n"
+               << "                      shard counts of the concurrent writer runs, which use the\n"
+               << "                      largest thread count (default 1,4,16; 0 skips them)\n"
+               << "  --reps <n>          timed repetitions per operation (default 5)\n"
+               << "  --warmup <n>        untimed calls before timing (default 100)\n"
+               << "  --min-time <ms>     minimum duration of a repetition (default 100)\n"
+               << "  --filter <text>     only operations whose name contains <text>\n"
+               << "  --alloc-ops <n>     most calls whose allocations are counted (default 100; 0 skips\n"
+               << "                      counting and the budget check)\n"
+               << "  --json <file>       also write the results as JSON\n"
+               << "  --stress <threads>  instead of benchmarking, race <threads> threads borrowing and\n"
+               << "                      returning the same books and check the outcome\n";
+ }
+
+ /**
+  * @brief Parses a comma-separated list of sizes or counts
+  *
+  * @param text The list
+  * @param sizes Receives the numbers
+  * @return false if an entry is not a positive number
+  */
+ bool parseSizes(const std::string& text, std::vector<std::size_t>& sizes) {
+     sizes.clear();
+     std::stringstream list(text);
+     std::string item;
+     while (std::getline(list, item, ',')) {
+         char* end = nullptr;
+         long long value = std::strtoll(item.c_str(), &end, 10);
+         if (item.empty() || *end != '\0' || value <= 0) {
+             return false;
+         }
+         sizes.push_back(static_cast<std::size_t>(value));
+     }
+     return !sizes.empty();
+ }
+
+ /**
+  * @brief Parses the command line
+  *
+  * @param argc Number of arguments
+  * @param argv Arguments
+  * @param settings Receives the settings
+  * @return false if the arguments are invalid
+  */
+ bool parseSettings(int argc, char* argv[], Settings& settings) {
+     for (int i = 1; i < argc; ++i) {
+         std::string arg = argv[i];
+         if (i + 1 >= argc) {
+             return false;
+         }
+         std::string value = argv[++i];
+         if (arg == "--sizes") {
+             if (!parseSizes(value, settings.sizes)) {
+                 return false;
+             }
+         } else if (arg == "--threads") {
+             if (value == "0") {
+                 settings.threads.clear();
+             } else if (!parseSizes(value, settings.threads)) {
+                 return false;
+             }
+         } else if (arg == "--writer-shards") {
+             if (value == "0") {
+                 settings.writerShards.clear();
+             } else if (!parseSizes(value, settings.writerShards)) {
+                 return false;
+             }
+         } else if (arg == "--stress") {
+             settings.stressThreads = static_cast<std::size_t>(std::atol(value.c_str()));
+         } else if (arg == "--shards") {
+             settings.shards = static_cast<std::size_t>(std::atol(value.c_str()));
+         } else if (arg == "--reps") {
+             settings.options.repetitions = static_cast<std::size_t>(std::atol(value.c_str()));
+         } else if (arg == "--warmup") {
+             settings.options.warmupOps = static_cast<std::size_t>(std::atol(value.c_str()));
+         } else if (arg == "--min-time") {
+             settings.options.minTimeMs = std::atof(value.c_str());
+         } else if (arg == "--alloc-ops") {
+             settings.options.allocationOps = static_cast<std::size_t>(std::atol(value.c_str()));
+         } else if (arg == "--filter") {
+             settings.filter = value;
+         } else if (arg == "--json") {
+             settings.jsonPath = value;
+         } else {
+             return false;
+         }
+     }
+     return settings.shards > 0 && settings.options.repetitions > 0 && settings.options.minTimeMs >= 0;
+ }
+
+ /**
+  * @brief Maps a call counter to a book ID, scattered over the catalog
+  *
+  * @param call Call counter
+  * @param size Number of books (IDs are 1..size)
+  * @return Book ID
+  */
+ int scatteredId(std::uint64_t call, std::size_t size) {
+     return static_cast<int>((call * 2654435761u) % size) + 1;
+ }
+
+ /**
+  * @brief Builds the title of the i-th synthetic book
+  * @param i Book number
+  * @return Title made of two words and the number
+  */
+ std::string titleOf(std::size_t i) {
+     return std::string(kWords[i % 16]) + " " + kWords[(i / 16) % 16] + " " + std::to_string(i);
+ }
+
+ /**
+  * @brief Runs every selected operation against one catalog size
+  *
+  * @param settings Command line settings
+  * @param size Catalog size
+  * @param directory Scratch directory for the data files
+  * @param results Receives the results
+  * @param memory Receives the memory samples
+  */
+ void runSize(const Settings& settings, std::size_t size, const std::filesystem::path& directory,
+              std::vector<Bench::Result>& results, std::vector<Bench::MemorySample>& memory) {
+     std::string dataFile = (directory / ("books_" + std::to_string(size) + ".json")).string();
+     auto selected = [&settings](const std::string& name) {
+         return settings.filter.empty() || name.find(settings.filter) != std::string::npos;
+     };
+     auto record = [&results](Bench::Result result) {
+         Bench::printResult(result);
+         results.push_back(std::move(result));
+     };
+     auto sample = [&memory, size](const std::string& phase, const std::vector<std::uint64_t>& start) {
+         std::vector<Bench::MemorySample> samples = Bench::sampleMemory(size, phase, start);
+         Bench::printMemory(samples);
+         memory.insert(memory.end(), samples.begin(), samples.end());
+     };
+
+     // Build the catalog in memory; nothing is written until saveBooks runs
+     std::vector<std::uint64_t> phase = Bench::beginMemoryPhase();
+     Library library(dataFile, settings.shards);
+     library.setAutoSave(false);
+     for (std::size_t i = 0; i < size; ++i) {
+         library.addBook(titleOf(i), "Author " + std::to_string(i % 1000), 1900 + static_cast<int>(i % 125));
+     }
+     sample("build", phase);
+
+     if (selected("findBookById")) {
+         record(Bench::measure("findBookById", size, settings.options, [&](std::uint64_t call) {
+             library.findBookById(scatteredId(call, size));
+         }));
+     }
+
+     if (selected("findBooksByTitle")) {
+         record(Bench::measure("findBooksByTitle", size, settings.options, [&](std::uint64_t call) {
+             // Two words select about 1 book in 256
+             library.findBooksByTitle(std::string(kWords[call % 16]) + " " + kWords[(call / 16) % 16]);
+         }));
+     }
+
+     // The same lookups from several reader threads at once
+     if (selected("findBookById")) {
+         for (std::size_t threads : settings.threads) {
+             record(Bench::measureConcurrent("findBookById", size, threads, settings.options,
+                                             [&](std::uint64_t call) {
+                 library.findBookById(scatteredId(call, size));
+             }));
+         }
+     }
+     if (selected("findBooksByTitle")) {
+         for (std::size_t threads : settings.threads) {
+             record(Bench::measureConcurrent("findBooksByTitle", size, threads, settings.options,
+                                             [&](std::uint64_t call) {
+                 library.findBooksByTitle(std::string(kWords[call % 16]) + " " + kWords[(call / 16) % 16]);
+             }));
+         }
+     }
+
+     if (selected("borrowBook/returnBook")) {
+         // Even passes over the catalog borrow every book, odd passes return them
+         record(Bench::measure("borrowBook/returnBook", size, settings.options, [&](std::uint64_t call) {
+             int id = static_cast<int>(call % size) + 1;
+             if ((call / size) % 2 == 0) {
+                 library.borrowBook(id);
+             } else {
+                 library.returnBook(id);
+             }
+         }));
+     }
+
+     if (selected("saveBooks")) {
+         phase = Bench::beginMemoryPhase();
+         record(Bench::measure("saveBooks", size, settings.options, [&](std::uint64_t) {
+             library.flush();
+         }));
+         sample("saveBooks", phase);
+     }
+
+     if (selected("loadBooks")) {
+         library.flush();
+         phase = Bench::beginMemoryPhase();
+         record(Bench::measure("loadBooks", size, settings.options, [&](std::uint64_t) {
+             Library loaded(dataFile, settings.shards);
+         }));
+         sample("loadBooks", phase);
+     }
+
+     // Writers from several threads at once, per shard count. Each shard
+     // count gets its own copy of the catalog, loaded from the data file.
+     std::size_t writers = settings.threads.empty()
+         ? 0 : *std::max_element(settings.threads.begin(), settings.threads.end());
+     bool writing = selected("addBook") || selected("borrowBook/returnBook");
+     if (writers > 0 && writing && !settings.writerShards.empty()) {
+         library.flush();
+         for (std::size_t shards : settings.writerShards) {
+             Library sharded(dataFile, shards);
+             sharded.setAutoSave(false);
+             if (selected("borrowBook/returnBook")) {
+                 Bench::Result result = Bench::measureConcurrent("borrowBook/returnBook", size, writers,
+                                                                 settings.options, [&](std::uint64_t call) {
+                     int id = static_cast<int>(call % size) + 1;
+                     if ((call / size) % 2 == 0) {
+                         sharded.borrowBook(id);
+                     } else {
+                         sharded.returnBook(id);
+                     }
+                 });
+                 result.shards = shards;
+                 record(std::move(result));
+             }
+             if (selected("addBook")) {
+                 Bench::Options options = settings.options;
+                 options.warmupOps = std::min(options.warmupOps, size / 20 + 1);
+                 options.maxOpsPerRep = std::max<std::size_t>(writers, size / 10 / options.repetitions);
+                 Bench::Result result = Bench::measureConcurrent("addBook", size, writers, options,
+                                                                 [&](std::uint64_t call) {
+                     sharded.addBook(titleOf(size + call), "Author " + std::to_string(call % 1000), 2000);
+                 });
+                 result.shards = shards;
+                 record(std::move(result));
+             }
+         }
+     }
+
+     // Last, because it grows the catalog: cap it at a tenth of the size
+     if (selected("addBook")) {
+         Bench::Options options = settings.options;
+         options.warmupOps = std::min(options.warmupOps, size / 20 + 1);
+         options.maxOpsPerRep = std::max<std::size_t>(1, size / 10 / options.repetitions);
+         record(Bench::measure("addBook", size, options, [&](std::uint64_t call) {
+             library.addBook(titleOf(size + call), "Author " + std::to_string(call % 1000), 2000);
+         }));
+     }
+ }
+
+ } // namespace
+
+ /**
+  * @brief Entry point of the Library benchmarks
+  *
+  * @param argc Number of command line arguments
+  * @param argv Command line arguments
+  * @return 0 on success, 1 on invalid arguments, if the JSON file could not be
+  *         written, if an operation exceeded its allocation budget or if a
+  *         stress check failed
+  */
+ int main(int argc, char* argv[]) {
+     Settings settings;
+     if (!parseSettings(argc, argv, settings)) {
+         printUsage(argv[0]);
+         return 1;
+     }
+
+     std::filesystem::path directory =
+         std::filesystem::temp_directory_path() / ("library_bench_" + std::to_string(getpid()));
+     std::filesystem::create_directories(directory);
+
+     if (settings.stressThreads > 0) {
+         bool passed = true;
+         for (std::size_t size : settings.sizes) {
+             Bench::StressOptions options;
+             options.books = size;
+             options.threads = settings.stressThreads;
+             options.shards = settings.shards;
+             std::string dataFile = (directory / ("stress_" + std::to_string(size) + ".json")).string();
+             passed = Bench::runStress(options, dataFile) && passed;
+         }
+         std::filesystem::remove_all(directory);
+         return passed ? 0 : 1;
+     }
+
+     std::vector<Bench::Result> results;
+     std::vector<Bench::MemorySample> memory;
+     Bench::printHeader();
+     for (std::size_t size : settings.sizes) {
+         runSize(settings, size, directory, results, memory);
+     }
+     std::filesystem::remove_all(directory);
+
+     if (!settings.jsonPath.empty()) {
+         nlohmann::json config = {
+             {"shards", settings.shards},
+             {"repetitions", settings.options.repetitions},
+             {"warmup_ops", settings.options.warmupOps},
+             {"min_time_ms", settings.options.minTimeMs},
+             {"filter", settings.filter},
+             {"allocation_ops", settings.options.allocationOps},
+             {"sizes", settings.sizes},
+             {"threads", settings.threads},
+             {"writer_shards", settings.writerShards}
+         };
+         if (!Bench::writeJson(settings.jsonPath, config.dump(), results, memory)) {
+             return 1;
+         }
+     }
+     return checkBudgets(results) ? 0 : 1;
+ }
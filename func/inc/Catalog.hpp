@@ -0,0 +1,285 @@
+/**
+ * @file Catalog.hpp
+ * @brief Header file defining the immutable, chunked book collection
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the definition of the Catalog class, the versioned storage
+ * behind the Library. A Catalog is never modified once it has been published;
+ * writers derive the next version from the current one, sharing every chunk
+ * they did not touch, and swap it in atomically.
+ */
+
+// func/inc/Catalog.hpp
+#ifndef CATALOG_HPP
+#define CATALOG_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+#include "models.hpp"
+#include "Memory.hpp"
+
+/**
+ * @class Catalog
+ * @brief Immutable version of the library's book collection
+ *
+ * Books are kept sorted by ID and split into fixed-size chunks held by
+ * shared pointers. Deriving a new version (withInserted, without) copies the
+ * table of chunk pointers plus the single chunk being changed; all other
+ * chunks are shared with the previous version. Old versions are reclaimed
+ * automatically when the last reader holding them lets go.
+ *
+ * The one field that is updated in place is a book's availability flag,
+ * which is atomic (see Book::tryBorrow) and reached through findForLoan;
+ * everything else only sees const books. Callers that flip it must make
+ * sure no writer is copying the chunk at the same time.
+ */
+class Catalog {
+public:
+    /// @brief Maximum number of books stored in a single chunk
+    static constexpr std::size_t kChunkSize = 512;
+
+    /// @brief Vector holding the books of a chunk, charged to Memory::Subsystem::Storage
+    using ChunkBooks = std::vector<Book, Memory::Allocator<Book, Memory::Subsystem::Storage>>;
+
+    /**
+     * @struct Chunk
+     * @brief A run of books sorted by ID
+     *
+     * Once a chunk is complete, seal() charges the text of its titles and
+     * authors to Memory::Subsystem::Strings as one block, and the
+     * destructor releases it. Book copies handed to callers are not
+     * counted, so copying books costs nothing extra.
+     */
+    struct Chunk : ChunkBooks {
+        using ChunkBooks::ChunkBooks;
+
+        Chunk() = default;
+
+        /// @brief Copies the books; the copy is not sealed
+        Chunk(const Chunk& other) : ChunkBooks(other) {}
+
+        Chunk& operator=(const Chunk&) = delete;
+
+        /// @brief Releases the text charged by seal()
+        ~Chunk();
+
+        /// @brief Charges the text of the books to Memory::Subsystem::Strings
+        void seal();
+
+    private:
+        std::size_t textBytes = 0;  ///< Bytes charged by seal()
+        bool sealed = false;
+    };
+
+    /// @brief Table of chunk pointers, charged to Memory::Subsystem::Storage
+    using ChunkList = std::vector<std::shared_ptr<Chunk>,
+                                  Memory::Allocator<std::shared_ptr<Chunk>, Memory::Subsystem::Storage>>;
+
+    /**
+     * @class const_iterator
+     * @brief Forward iterator over the books of a version, in ID order
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Book;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Book*;
+        using reference = const Book&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return (*(*chunks)[chunk])[offset]; }
+        pointer operator->() const { return &**this; }
+
+        const_iterator& operator++() {
+            if (++offset == (*chunks)[chunk]->size()) {
+                ++chunk;
+                offset = 0;
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return chunk == other.chunk && offset == other.offset;
+        }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class Catalog;
+
+        const_iterator(const ChunkList* chunks, std::size_t chunk, std::size_t offset)
+            : chunks(chunks), chunk(chunk), offset(offset) {}
+
+        const ChunkList* chunks = nullptr;
+        std::size_t chunk = 0;
+        std::size_t offset = 0;
+    };
+
+    /**
+     * @brief Creates an empty catalog
+     */
+    Catalog() = default;
+
+    /**
+     * @brief Creates a catalog from an unordered collection of books
+     *
+     * @param books Books to store; they are sorted by ID before chunking
+     */
+    explicit Catalog(std::vector<Book> books);
+
+    /**
+     * @brief Gets the number of books in this version
+     * @return Number of books
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Checks whether this version holds no books
+     * @return true if the catalog is empty, false otherwise
+     */
+    bool empty() const;
+
+    /**
+     * @brief Gets the highest book ID in this version
+     * @return Highest ID, or 0 if the catalog is empty
+     */
+    int maxId() const;
+
+    /**
+     * @brief Finds a book by its ID
+     *
+     * @param id Unique identifier of the book to find
+     * @return Pointer to the book inside this version, nullptr if not found
+     */
+    const Book* find(int id) const;
+
+    /**
+     * @brief Finds a book to borrow or return in place
+     *
+     * Versions are shared by readers, so the only change allowed through
+     * the returned pointer is flipping the atomic availability flag.
+     *
+     * @param id Unique identifier of the book to find
+     * @return Pointer to the book inside this version, nullptr if not found
+     */
+    Book* findForLoan(int id) const;
+
+    /**
+     * @brief Gets an iterator to the first book
+     * @return Iterator to the book with the lowest ID
+     */
+    const_iterator begin() const;
+
+    /**
+     * @brief Gets the past-the-end iterator
+     * @return Iterator one past the book with the highest ID
+     */
+    const_iterator end() const;
+
+    /**
+     * @brief Gets an iterator to the first book whose ID is not less than id
+     *
+     * @param id Book ID to seek to
+     * @return Iterator to that book, or end() if every ID is lower
+     */
+    const_iterator lowerBound(int id) const;
+
+    /**
+     * @brief Calls a function for every book, in ID order
+     *
+     * @param fn Callable taking a const Book&
+     */
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const auto& chunk : chunks) {
+            for (const auto& book : *chunk) {
+                fn(book);
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the number of chunks in this version
+     * @return Chunk count
+     */
+    std::size_t chunkCount() const;
+
+    /**
+     * @brief Calls a function for every book in a range of chunks, in ID order
+     *
+     * Lets callers split a scan into independent pieces of work.
+     *
+     * @param first Index of the first chunk to visit
+     * @param last One past the index of the last chunk to visit
+     * @param fn Callable taking a const Book&
+     */
+    template <typename Fn>
+    void forEachInChunks(std::size_t first, std::size_t last, Fn&& fn) const {
+        for (std::size_t i = first; i < last && i < chunks.size(); ++i) {
+            for (const auto& book : *chunks[i]) {
+                fn(book);
+            }
+        }
+    }
+
+    /**
+     * @brief Copies every book of this version into a vector
+     * @return Vector of books in ID order
+     */
+    std::vector<Book> toVector() const;
+
+    /**
+     * @brief Derives a new version with one more book
+     *
+     * Appending (an ID above maxId()) is the common case and only touches
+     * the last chunk; lower IDs are inserted into the chunk covering them,
+     * which is split in two once it grows past kChunkSize.
+     *
+     * @param book Book to insert
+     * @return The new version, sharing all but one chunk with this one
+     */
+    std::shared_ptr<const Catalog> withInserted(Book book) const;
+
+    /**
+     * @brief Derives a new version in which one book is replaced
+     *
+     * @param book Replacement; the book with the same ID is swapped out
+     * @return The new version, or nullptr if no book has that ID
+     */
+    std::shared_ptr<const Catalog> withReplaced(Book book) const;
+
+    /**
+     * @brief Derives a new version without the given book
+     *
+     * @param id Unique identifier of the book to drop
+     * @return The new version, or nullptr if no book has that ID
+     */
+    std::shared_ptr<const Catalog> without(int id) const;
+
+private:
+    /// @brief Chunks in ID order; none of them is empty
+    ChunkList chunks;
+
+    /// @brief Total number of books across all chunks
+    std::size_t count = 0;
+
+    /**
+     * @brief Finds the index of the chunk that would hold an ID
+     *
+     * @param id Book ID to look up
+     * @return Index into chunks, or chunks.size() if no chunk can hold it
+     */
+    std::size_t chunkFor(int id) const;
+};
+
+#endif // CATALOG_HPP
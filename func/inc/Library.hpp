@@ -17,7 +17,45 @@
 
 #include <string>
 #include <vector>
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <mutex>
+#include <shared_mutex>
 #include "models.hpp"
+#include "Catalog.hpp"
+#include "Snapshot.hpp"
+#include "Task.hpp"
+#include "SlowLog.hpp"
+
+namespace Trace {
+class Recorder;
+}
+
+/**
+ * @enum UpdateResult
+ * @brief Outcome of an optimistic edit (see Library::updateBook)
+ */
+enum class UpdateResult {
+    Updated,   ///< The edit was applied and the version incremented
+    NotFound,  ///< No book has the given ID
+    Conflict   ///< The book changed since the caller read it
+};
+
+/**
+ * @struct BookPage
+ * @brief One page of a cursor-based listing (see Library::pageAfter)
+ */
+struct BookPage {
+    std::vector<Book> books;  ///< Books of the page in ID order
+    bool hasMore = false;     ///< Whether further books follow the last one
+};
 
 /**
  * @class Library
@@ -28,17 +66,221 @@
  * from/to persistent storage (JSON files), and provides methods for adding,
  * removing, finding, borrowing, and returning books. It also maintains the
  * state of the library, including the next available book ID.
+ *
+ * The Library is safe to share between threads. The collection is published
+ * as an immutable Catalog version through an atomically swapped pointer:
+ * queries pin the current version and read it without taking any lock, and
+ * writers build the next version (sharing unchanged chunks) and swap it in.
+ * Queries hand out copies of the books, never pointers into a version.
+ *
+ * For write-heavy workloads the collection can be split into several
+ * shards, partitioned by a hash of the book ID. Each shard has its own
+ * versions, chunk index and lock, so writes to different shards never
+ * contend; queries that are not keyed by ID fan out to every shard and
+ * merge the results in ID order.
  */
 class Library {
 private:
-    /// @brief Collection of books in the library
-    std::vector<Book> books;
+    /**
+     * @struct Shard
+     * @brief One independently locked partition of the collection
+     */
+    struct Shard {
+        /// @brief Current published version of this shard
+        std::atomic<std::shared_ptr<const Catalog>> books{std::make_shared<const Catalog>()};
+        
+        /// @brief Held exclusively by writers that derive and publish a new
+        ///        version, and shared by borrow/return, which flip availability
+        ///        flags in place; queries never take it
+        mutable std::shared_mutex mutex;
+    };
+    
+    /// @brief Partitions of the collection, indexed by Snapshot::shardIndex
+    std::vector<std::unique_ptr<Shard>> shards;
     
     /// @brief Path to the JSON file where book data is stored
     std::string dataFile;
     
-    /// @brief Next available ID for new books
-    int nextId;
+    /// @brief Next available ID for new books, handed out by fetch_add
+    std::atomic<int> nextId;
+    
+    /// @brief Number of borrowed books, kept up to date by every state change
+    std::atomic<std::int64_t> borrowed{0};
+    
+    /// @brief Serializes writers of the data file so saves land in order
+    std::mutex persistMutex;
+    
+    /// @brief Whether every modifying operation writes the data file
+    std::atomic<bool> autoSave{true};
+    
+    /// @brief Pool running parallel loads and searches (ThreadPool::shared())
+    ThreadPool& pool;
+    
+    /// @brief Guards the async persistence queue below
+    std::mutex persistQueueMutex;
+    
+    /// @brief Coroutines waiting for the next flush to the data file
+    std::vector<std::coroutine_handle<>> persistWaiters;
+    
+    /// @brief Whether a flush is queued or running on the I/O pool
+    bool flushScheduled = false;
+    
+    /// @brief Signalled when the persistence queue drains
+    std::condition_variable persistIdle;
+    
+    /// @brief Whether a synchronous auto-save waits for a flush that has not started
+    bool syncWaiting = false;
+    
+    /// @brief Number of flushes started and finished, for synchronous auto-saves
+    std::uint64_t flushesStarted = 0;
+    std::uint64_t flushesFinished = 0;
+    
+    /// @brief Signalled when a flush finishes
+    std::condition_variable persistFlushed;
+    
+    /// @brief Outcome of the most recent flush
+    std::atomic<bool> lastFlushSucceeded{true};
+    
+    /// @brief Slow-log timing of the most recent flush; only used on ThreadPool::io()
+    SlowLog::State flushTiming;
+    
+    /// @brief Whether flushTiming holds the timing of the most recent flush
+    bool flushTimed = false;
+    
+    /// @brief Where calls are recorded (see setRecorder), or null
+    std::shared_ptr<Trace::Recorder> recorder;
+    
+    /**
+     * @struct PersistAwaiter
+     * @brief Awaitable that suspends until the current state is on disk
+     */
+    struct PersistAwaiter {
+        Library& library;
+        SlowLog::State* slow = nullptr;  ///< Slow-log timing of the suspended operation
+        
+        bool await_ready() const noexcept { return !library.autoSave.load(); }
+        void await_suspend(std::coroutine_handle<> handle);
+        bool await_resume() const noexcept;
+    };
+    
+    /**
+     * @brief Suspends the calling coroutine until the data file is written
+     * 
+     * Concurrent callers are batched: one write covers every coroutine
+     * that was waiting when it started (group commit). The coroutine is
+     * resumed on the I/O pool, and its slow-log timing moves with it.
+     * 
+     * @return Awaitable yielding true if the write succeeded
+     */
+    PersistAwaiter persistAsync();
+    
+    /**
+     * @brief Writes the data file once and resumes the waiting batch
+     * 
+     * Runs on ThreadPool::io().
+     */
+    void flushPersistQueue();
+    
+    /**
+     * @brief Adds a book in memory without persisting it
+     * 
+     * @param title Title of the book
+     * @param author Author of the book
+     * @param year Publication year of the book
+     * @return The ID assigned to the new book
+     */
+    int insertBook(const std::string& title, const std::string& author, int year);
+    
+    /**
+     * @brief Removes a book in memory without persisting the change
+     * 
+     * @param id Unique identifier of the book to remove
+     * @return true if the book was found and removed, false otherwise
+     */
+    bool eraseBook(int id);
+    
+    /**
+     * @brief Marks a book as borrowed in memory without persisting it
+     * 
+     * @param id Unique identifier of the book to borrow
+     * @return true if this call borrowed the book, false otherwise
+     */
+    bool markBorrowed(int id);
+    
+    /**
+     * @brief Marks a book as returned in memory without persisting it
+     * 
+     * @param id Unique identifier of the book to return
+     * @return true if this call returned the book, false otherwise
+     */
+    bool markReturned(int id);
+    
+    /**
+     * @brief Borrows or returns a set of books in memory, all or nothing
+     * 
+     * @param ids Unique identifiers of the books
+     * @param borrowing true to borrow, false to return
+     * @return true if every book changed state, false if none did
+     */
+    bool markAll(std::span<const int> ids, bool borrowing);
+    
+    /**
+     * @brief Applies an optimistic edit in memory without persisting it
+     * 
+     * @param id Unique identifier of the book to edit
+     * @param expectedVersion Version the caller's copy of the book has
+     * @param title New title
+     * @param author New author
+     * @param year New publication year
+     * @return Outcome of the edit
+     */
+    UpdateResult replaceBook(int id, std::uint64_t expectedVersion,
+                             const std::string& title, const std::string& author, int year);
+    
+    /**
+     * @brief Gets the shard that owns a book ID
+     * 
+     * @param id Book ID
+     * @return The owning shard
+     */
+    Shard& shardFor(int id) const;
+    
+    /**
+     * @brief Pins the current version of one shard
+     * 
+     * @param shard The shard to read
+     * @return The shard's current version
+     */
+    static std::shared_ptr<const Catalog> current(const Shard& shard);
+    
+    /**
+     * @brief Publishes a new version of one shard
+     * 
+     * The caller must hold the shard's mutex exclusively.
+     * 
+     * @param shard The shard to update
+     * @param next The version to make current
+     */
+    static void publish(Shard& shard, std::shared_ptr<const Catalog> next);
+    
+    /**
+     * @brief Reserves a contiguous block of book IDs
+     * 
+     * A single atomic fetch_add, so concurrent writers in different shards
+     * never serialize on ID allocation.
+     * 
+     * @param count Number of IDs to reserve
+     * @return The first reserved ID
+     */
+    int reserveIds(int count);
+    
+    /**
+     * @brief Scans every shard in parallel and collects matching books
+     * 
+     * @param matches Predicate selecting the books to return
+     * @return Matching books in ID order
+     */
+    std::vector<Book> collectMatching(const std::function<bool(const Book&)>& matches) const;
     
     /**
      * @brief Loads books from the data file into memory
@@ -54,8 +296,22 @@ private:
      * 
      * This method is called after any operation that modifies the
      * books collection to ensure the changes are persisted to disk.
+     * It must be called without holding a shard lock; it serializes the
+     * current version while holding persistMutex, so neither readers nor
+     * borrowers are ever blocked by disk I/O.
+     * 
+     * @return true if the data file was written, false otherwise
+     */
+    bool saveBooks();
+    
+    /**
+     * @brief Saves the collection unless auto-save has been turned off
+     * 
+     * The save goes through the persistence queue, so concurrent
+     * synchronous and async writers share one write (group commit). The
+     * caller blocks until a write that started after its change is done.
      */
-    void saveBooks();
+    void autoSaveBooks();
     
 public:
     /**
@@ -67,8 +323,17 @@ public:
      * 
      * @param dataFile Path to the JSON file where book data is stored
      *                 (defaults to "data/books.json")
+     * @param shardCount Number of independently locked partitions
+     *                   (defaults to 1; values below 1 are treated as 1)
      */
-    Library(const std::string& dataFile = "data/books.json");
+    Library(const std::string& dataFile = "data/books.json", std::size_t shardCount = 1);
+    
+    /**
+     * @brief Destructor for the Library class
+     * 
+     * Waits for any pending asynchronous write of the data file.
+     */
+    ~Library();
     
     /**
      * @brief Adds a new book to the library
@@ -79,9 +344,9 @@ public:
      * @param title Title of the book
      * @param author Author of the book
      * @param year Publication year of the book
-     * @return true if the book was successfully added, false otherwise
+     * @return The ID assigned to the new book
      */
-    bool addBook(const std::string& title, const std::string& author, int year);
+    int addBook(const std::string& title, const std::string& author, int year);
     
     /**
      * @brief Removes a book from the library
@@ -97,16 +362,15 @@ public:
     /**
      * @brief Finds a book by its ID
      * 
-     * Searches for a book with the specified ID and returns a pointer to it.
+     * Searches for a book with the specified ID and returns a copy of it.
      * 
      * @param id Unique identifier of the book to find
-     * @return Pointer to the Book object if found, nullptr otherwise
+     * @return Copy of the Book if found, std::nullopt otherwise
      * 
-     * @note The returned pointer points to an object within the Library's
-     *       internal collection, so it becomes invalid if the collection
-     *       is modified (e.g., by adding or removing books).
+     * @note A copy is returned rather than a pointer so the result stays
+     *       valid while other threads modify the collection.
      */
-    Book* findBookById(int id);
+    std::optional<Book> findBookById(int id) const;
     
     /**
      * @brief Finds books by title (partial match)
@@ -117,7 +381,7 @@ public:
      * @param title String to search for in book titles
      * @return Vector of Book objects with matching titles
      */
-    std::vector<Book> findBooksByTitle(const std::string& title);
+    std::vector<Book> findBooksByTitle(const std::string& title) const;
     
     /**
      * @brief Finds books by author (partial match)
@@ -128,7 +392,7 @@ public:
      * @param author String to search for in book authors
      * @return Vector of Book objects with matching authors
      */
-    std::vector<Book> findBooksByAuthor(const std::string& author);
+    std::vector<Book> findBooksByAuthor(const std::string& author) const;
     
     /**
      * @brief Marks a book as borrowed
@@ -154,6 +418,57 @@ public:
      */
     bool returnBook(int id);
     
+    /**
+     * @brief Edits a book's details if nobody else has edited it meanwhile
+     * 
+     * Optimistic concurrency: the caller passes the version it read (see
+     * Book::getVersion). If the stored version still matches, the new
+     * details are applied, the version is incremented and the library is
+     * saved; otherwise the call fails immediately without waiting.
+     * 
+     * @param id Unique identifier of the book to edit
+     * @param expectedVersion Version the caller's copy of the book has
+     * @param title New title
+     * @param author New author
+     * @param year New publication year
+     * @return UpdateResult::Updated on success, UpdateResult::NotFound if
+     *         there is no such book, UpdateResult::Conflict if the version
+     *         has moved on
+     * 
+     * @note Borrowing and returning do not change the version; they are
+     *       protected by their own compare-and-swap.
+     */
+    UpdateResult updateBook(int id, std::uint64_t expectedVersion,
+                            const std::string& title, const std::string& author, int year);
+    
+    /**
+     * @brief Borrows several books as one all-or-nothing operation
+     * 
+     * Resolves every ID in one pass and checks that all of the books are
+     * available before any of them is marked as borrowed. Either every
+     * book is borrowed and the library is saved once, or nothing changes.
+     * 
+     * @param ids Unique identifiers of the books to borrow (no duplicates)
+     * @return true if all books were borrowed, false if the batch was
+     *         rejected (unknown or duplicate ID, or a book already borrowed)
+     * 
+     * @note The shards of the batch are locked exclusively while it is
+     *       checked and applied, so other threads see all of it or none.
+     */
+    bool borrowBooks(std::span<const int> ids);
+    
+    /**
+     * @brief Returns several books as one all-or-nothing operation
+     * 
+     * The counterpart of borrowBooks: either every book is returned and
+     * the library is saved once, or nothing changes.
+     * 
+     * @param ids Unique identifiers of the books to return (no duplicates)
+     * @return true if all books were returned, false if the batch was
+     *         rejected (unknown or duplicate ID, or a book not borrowed)
+     */
+    bool returnBooks(std::span<const int> ids);
+    
     /**
      * @brief Gets all books in the library
      * 
@@ -161,6 +476,168 @@ public:
      */
     std::vector<Book> getAllBooks() const;
     
+    /**
+     * @brief Gets the books that follow an ID, one page at a time
+     * 
+     * The ID of the last book of a page is the cursor of the next one, so
+     * a listing can be walked without holding anything between calls and
+     * books added or removed meanwhile never shift the pages. Every call
+     * seeks straight to the cursor and stops after limit matches, so the
+     * first page of a huge listing costs the same as that of a short one.
+     * 
+     * @param afterId Cursor: only books with a higher ID are returned (0 to start)
+     * @param limit Maximum number of books to return
+     * @param matches Optional predicate selecting the books to list (all if empty)
+     * @return The page, in ID order
+     */
+    BookPage pageAfter(int afterId, std::size_t limit,
+                       const std::function<bool(const Book&)>& matches = {}) const;
+    
+    // Asynchronous API
+    //
+    // The coroutine versions below run their in-memory work inline, on the
+    // thread that awaits them. Mutations then suspend while the data file
+    // is written on ThreadPool::io(), and resume on that thread once the
+    // write is done; writes from concurrent callers are coalesced, so a
+    // single event-loop thread can keep thousands of requests in flight.
+    // String parameters are taken by value because the coroutine may
+    // outlive the caller's arguments.
+    
+    /**
+     * @brief Awaitable version of addBook
+     * 
+     * @param title Title of the book
+     * @param author Author of the book
+     * @param year Publication year of the book
+     * @return Task yielding true once the book is added and persisted
+     */
+    Task<bool> addBookAsync(std::string title, std::string author, int year);
+    
+    /**
+     * @brief Awaitable version of removeBook
+     * 
+     * @param id Unique identifier of the book to remove
+     * @return Task yielding true if the book was found and removed
+     */
+    Task<bool> removeBookAsync(int id);
+    
+    /**
+     * @brief Awaitable version of borrowBook
+     * 
+     * @param id Unique identifier of the book to borrow
+     * @return Task yielding true if the book was borrowed
+     */
+    Task<bool> borrowBookAsync(int id);
+    
+    /**
+     * @brief Awaitable version of returnBook
+     * 
+     * @param id Unique identifier of the book to return
+     * @return Task yielding true if the book was returned
+     */
+    Task<bool> returnBookAsync(int id);
+    
+    /**
+     * @brief Awaitable version of updateBook
+     * 
+     * @param id Unique identifier of the book to edit
+     * @param expectedVersion Version the caller's copy of the book has
+     * @param title New title
+     * @param author New author
+     * @param year New publication year
+     * @return Task yielding the outcome once an applied edit is persisted
+     */
+    Task<UpdateResult> updateBookAsync(int id, std::uint64_t expectedVersion,
+                                       std::string title, std::string author, int year);
+    
+    /**
+     * @brief Awaitable version of findBookById (completes inline)
+     * 
+     * @param id Unique identifier of the book to find
+     * @return Task yielding a copy of the book, or std::nullopt
+     */
+    Task<std::optional<Book>> findBookByIdAsync(int id) const;
+    
+    /**
+     * @brief Awaitable version of findBooksByTitle (completes inline)
+     * 
+     * @param title String to search for in book titles
+     * @return Task yielding the matching books
+     */
+    Task<std::vector<Book>> findBooksByTitleAsync(std::string title) const;
+    
+    /**
+     * @brief Awaitable version of findBooksByAuthor (completes inline)
+     * 
+     * @param author String to search for in book authors
+     * @return Task yielding the matching books
+     */
+    Task<std::vector<Book>> findBooksByAuthorAsync(std::string author) const;
+    
+    /**
+     * @brief Pins the current version of the collection
+     * 
+     * The returned versions never change, no matter what writers do
+     * afterwards, so long-running reports can iterate them consistently
+     * without blocking anyone. They are released when the last copy of
+     * the snapshot goes away.
+     * 
+     * @return Snapshot holding the current version of every shard
+     * 
+     * @note Availability flags are the exception: they are atomic and
+     *       updated in place by borrowBook/returnBook.
+     */
+    Snapshot snapshot() const;
+    
+    /**
+     * @brief Turns the write-after-every-change behaviour on or off
+     * 
+     * With auto-save off, modifying operations only change the in-memory
+     * collection (the async ones complete without waiting for a write)
+     * and the caller is responsible for calling flush(). Bulk callers such
+     * as the batch mode use this to write the data file once at the end.
+     * 
+     * @param enabled true to save after every change (the default)
+     */
+    void setAutoSave(bool enabled);
+    
+    /**
+     * @brief Records every call from now on into a workload trace
+     * 
+     * Additions, removals, lookups, searches, borrows, returns and edits
+     * (synchronous and asynchronous) are appended to the recorder with
+     * their arguments and the time they were made, so bin/replay can
+     * drive another Library with the same traffic. Without a recorder the
+     * cost is one null check per call.
+     * 
+     * @param recorder The trace to append to, or null to stop recording
+     * 
+     * @note Must be called before the library is shared between threads.
+     */
+    void setRecorder(std::shared_ptr<Trace::Recorder> recorder);
+    
+    /**
+     * @brief Writes the current collection to the data file
+     * @return true if the data file was written, false otherwise
+     */
+    bool flush();
+    
+    /**
+     * @brief Gets the number of shards the collection is split into
+     * @return Shard count
+     */
+    std::size_t shardCount() const;
+    
+    /**
+     * @brief Gets the number of books currently borrowed
+     * 
+     * Maintained incrementally by borrows, returns, removals and loads, so
+     * monitoring can read it without scanning the collection.
+     * 
+     * @return Borrowed book count
+     */
+    std::size_t borrowedCount() const;
+    
     /**
      * @brief Displays all books in the library to the console
      * 
@@ -0,0 +1,169 @@
+/**
+ * @file Snapshot.hpp
+ * @brief Header file defining a pinned, read-only view over all shards
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the definition of the Snapshot class, which a Library
+ * hands out to readers. A Snapshot holds one pinned Catalog version per
+ * shard and presents them as a single collection in ID order.
+ */
+
+// func/inc/Snapshot.hpp
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "Catalog.hpp"
+
+/**
+ * @class Snapshot
+ * @brief Read-only view of a Library pinned at one Catalog version per shard
+ *
+ * Holding a Snapshot keeps its versions alive; writers publishing newer
+ * versions never affect it. Each shard's version is internally consistent.
+ * With more than one shard the versions are pinned one after another, so
+ * a write that lands between two pins may be visible in one shard only.
+ */
+class Snapshot {
+public:
+    /**
+     * @brief Creates a snapshot from pinned shard versions
+     *
+     * @param shards One pinned version per shard, indexed by shard number
+     */
+    explicit Snapshot(std::vector<std::shared_ptr<const Catalog>> shards);
+
+    /**
+     * @brief Maps a book ID to the shard that owns it
+     *
+     * Consecutive IDs are scattered across shards by a multiplicative hash
+     * so that a burst of new books does not pile onto a single shard.
+     *
+     * @param id Book ID
+     * @param shardCount Total number of shards (at least 1)
+     * @return Shard number in [0, shardCount)
+     */
+    static std::size_t shardIndex(int id, std::size_t shardCount);
+
+    /**
+     * @brief Gets the number of shards in this snapshot
+     * @return Shard count
+     */
+    std::size_t shardCount() const;
+
+    /**
+     * @brief Gets the pinned version of one shard
+     *
+     * @param index Shard number
+     * @return The shard's catalog
+     */
+    const Catalog& shard(std::size_t index) const;
+
+    /**
+     * @brief Gets the number of books across all shards
+     * @return Number of books
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Checks whether the snapshot holds no books
+     * @return true if every shard is empty, false otherwise
+     */
+    bool empty() const;
+
+    /**
+     * @brief Gets the highest book ID across all shards
+     * @return Highest ID, or 0 if the snapshot is empty
+     */
+    int maxId() const;
+
+    /**
+     * @brief Finds a book by its ID
+     *
+     * @param id Unique identifier of the book to find
+     * @return Pointer to the book inside the pinned version, nullptr if not found
+     */
+    const Book* find(int id) const;
+
+    /**
+     * @brief Calls a function for every book, merging the shards in ID order
+     *
+     * @param fn Callable taking a const Book&
+     */
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        if (shards.size() == 1) {
+            shards.front()->forEach(fn);
+            return;
+        }
+
+        // Merge the shards: repeatedly emit the lowest ID among the heads
+        std::vector<Catalog::const_iterator> heads, ends;
+        for (const auto& shard : shards) {
+            heads.push_back(shard->begin());
+            ends.push_back(shard->end());
+        }
+
+        for (;;) {
+            std::size_t lowest = shards.size();
+            for (std::size_t i = 0; i < shards.size(); ++i) {
+                if (heads[i] != ends[i] &&
+                    (lowest == shards.size() || heads[i]->getId() < heads[lowest]->getId())) {
+                    lowest = i;
+                }
+            }
+            if (lowest == shards.size()) {
+                return;
+            }
+            fn(*heads[lowest]);
+            ++heads[lowest];
+        }
+    }
+
+    /**
+     * @brief Calls a function for the books from an ID onwards, in ID order
+     *
+     * Each shard is entered with a binary search, so the cost does not
+     * depend on how many books precede the starting ID.
+     *
+     * @param id Lowest ID to visit
+     * @param fn Callable taking a const Book& and returning false to stop
+     */
+    template <typename Fn>
+    void forEachFrom(int id, Fn&& fn) const {
+        std::vector<Catalog::const_iterator> heads, ends;
+        for (const auto& shard : shards) {
+            heads.push_back(shard->lowerBound(id));
+            ends.push_back(shard->end());
+        }
+
+        for (;;) {
+            std::size_t lowest = shards.size();
+            for (std::size_t i = 0; i < shards.size(); ++i) {
+                if (heads[i] != ends[i] &&
+                    (lowest == shards.size() || heads[i]->getId() < heads[lowest]->getId())) {
+                    lowest = i;
+                }
+            }
+            if (lowest == shards.size() || !fn(*heads[lowest])) {
+                return;
+            }
+            ++heads[lowest];
+        }
+    }
+
+    /**
+     * @brief Copies every book into a vector
+     * @return Vector of books in ID order
+     */
+    std::vector<Book> toVector() const;
+
+private:
+    /// @brief Pinned version of each shard
+    std::vector<std::shared_ptr<const Catalog>> shards;
+};
+
+#endif // SNAPSHOT_HPP
@@ -0,0 +1,353 @@
+/**
+ * @file Catalog.cpp
+ * @brief Implementation of the immutable, chunked book collection
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements the Catalog class declared in Catalog.hpp. Each
+ * derivation copies only the chunk it changes, so publishing a new version
+ * costs O(number of chunks + chunk size) instead of a full copy.
+ */
+
+// func/src/Catalog.cpp
+#include "Catalog.hpp"
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+/**
+ * @brief Creates a chunk whose control block is charged to storage too
+ * 
+ * @param args Arguments of the Chunk constructor
+ * @return The new chunk
+ */
+template <typename... Args>
+std::shared_ptr<Catalog::Chunk> makeChunk(Args&&... args) {
+    return std::allocate_shared<Catalog::Chunk>(Memory::Allocator<Catalog::Chunk, Memory::Subsystem::Storage>(),
+                                                std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Creates a catalog version charged to storage
+ * 
+ * @param source The version to copy
+ * @return The copy
+ */
+std::shared_ptr<Catalog> makeCatalog(const Catalog& source) {
+    return std::allocate_shared<Catalog>(Memory::Allocator<Catalog, Memory::Subsystem::Storage>(), source);
+}
+
+} // namespace
+
+/**
+ * @brief Implementation of the Chunk destructor
+ */
+Catalog::Chunk::~Chunk() {
+    if (sealed) {
+        Memory::released(Memory::Subsystem::Strings, textBytes);
+    }
+}
+
+/**
+ * @brief Implementation of the Chunk::seal method
+ *
+ * Sums the lengths of the titles and authors once, when the chunk is
+ * built. Sealing again (never needed) replaces the earlier charge.
+ */
+void Catalog::Chunk::seal() {
+    if (sealed) {
+        Memory::released(Memory::Subsystem::Strings, textBytes);
+    }
+    textBytes = 0;
+    for (const Book& book : *this) {
+        textBytes += book.getTitle().size() + book.getAuthor().size();
+    }
+    Memory::allocated(Memory::Subsystem::Strings, textBytes);
+    sealed = true;
+}
+
+/**
+ * @brief Constructor implementation taking an unordered collection
+ *
+ * Sorts the books by ID (keeping file order for duplicate IDs) and cuts
+ * them into chunks of at most kChunkSize books.
+ *
+ * @param books Books to store
+ */
+Catalog::Catalog(std::vector<Book> books) : count(books.size()) {
+    std::stable_sort(books.begin(), books.end(),
+        [](const Book& a, const Book& b) { return a.getId() < b.getId(); });
+
+    for (std::size_t begin = 0; begin < books.size(); begin += kChunkSize) {
+        std::size_t end = std::min(begin + kChunkSize, books.size());
+        auto chunk = makeChunk();
+        chunk->reserve(kChunkSize);
+        std::move(books.begin() + begin, books.begin() + end, std::back_inserter(*chunk));
+        chunk->seal();
+        chunks.push_back(std::move(chunk));
+    }
+}
+
+/**
+ * @brief Implementation of the size method
+ * @return Number of books
+ */
+std::size_t Catalog::size() const {
+    return count;
+}
+
+/**
+ * @brief Implementation of the empty method
+ * @return true if the catalog is empty, false otherwise
+ */
+bool Catalog::empty() const {
+    return count == 0;
+}
+
+/**
+ * @brief Implementation of the maxId method
+ *
+ * Chunks are sorted, so the highest ID is the last book of the last chunk.
+ *
+ * @return Highest ID, or 0 if the catalog is empty
+ */
+int Catalog::maxId() const {
+    return chunks.empty() ? 0 : chunks.back()->back().getId();
+}
+
+/**
+ * @brief Implementation of the chunkFor method
+ *
+ * Binary-searches the chunk table for the last chunk whose first ID is
+ * not greater than the requested one.
+ *
+ * @param id Book ID to look up
+ * @return Index into chunks, or chunks.size() if no chunk can hold it
+ */
+std::size_t Catalog::chunkFor(int id) const {
+    auto it = std::upper_bound(chunks.begin(), chunks.end(), id,
+        [](int value, const std::shared_ptr<Chunk>& chunk) {
+            return value < chunk->front().getId();
+        });
+
+    if (it == chunks.begin()) {
+        return chunks.size();
+    }
+    return static_cast<std::size_t>(std::distance(chunks.begin(), it)) - 1;
+}
+
+/**
+ * @brief Implementation of the find method
+ *
+ * @param id Unique identifier of the book to find
+ * @return Pointer to the book inside this version, nullptr if not found
+ */
+const Book* Catalog::find(int id) const {
+    return findForLoan(id);
+}
+
+/**
+ * @brief Implementation of the findForLoan method
+ *
+ * Two binary searches: one over the chunk table, one inside the chunk.
+ *
+ * @param id Unique identifier of the book to find
+ * @return Pointer to the book inside this version, nullptr if not found
+ */
+Book* Catalog::findForLoan(int id) const {
+    std::size_t index = chunkFor(id);
+    if (index == chunks.size()) {
+        return nullptr;
+    }
+
+    Chunk& chunk = *chunks[index];
+    auto it = std::lower_bound(chunk.begin(), chunk.end(), id,
+        [](const Book& book, int value) { return book.getId() < value; });
+
+    if (it != chunk.end() && it->getId() == id) {
+        return &(*it);
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Implementation of the begin method
+ * @return Iterator to the book with the lowest ID
+ */
+Catalog::const_iterator Catalog::begin() const {
+    return const_iterator(&chunks, 0, 0);
+}
+
+/**
+ * @brief Implementation of the end method
+ * @return Iterator one past the book with the highest ID
+ */
+Catalog::const_iterator Catalog::end() const {
+    return const_iterator(&chunks, chunks.size(), 0);
+}
+
+/**
+ * @brief Implementation of the lowerBound method
+ *
+ * @param id Book ID to seek to
+ * @return Iterator to the first book whose ID is not less than id
+ */
+Catalog::const_iterator Catalog::lowerBound(int id) const {
+    std::size_t index = chunkFor(id);
+    if (index == chunks.size()) {
+        // Either the catalog is empty or id is below every stored ID
+        return begin();
+    }
+
+    const Chunk& chunk = *chunks[index];
+    auto it = std::lower_bound(chunk.begin(), chunk.end(), id,
+        [](const Book& book, int value) { return book.getId() < value; });
+
+    if (it == chunk.end()) {
+        return const_iterator(&chunks, index + 1, 0);
+    }
+    return const_iterator(&chunks, index, static_cast<std::size_t>(std::distance(chunk.begin(), it)));
+}
+
+/**
+ * @brief Implementation of the chunkCount method
+ * @return Chunk count
+ */
+std::size_t Catalog::chunkCount() const {
+    return chunks.size();
+}
+
+/**
+ * @brief Implementation of the toVector method
+ * @return Vector of books in ID order
+ */
+std::vector<Book> Catalog::toVector() const {
+    std::vector<Book> result;
+    result.reserve(count);
+    forEach([&result](const Book& book) { result.push_back(book); });
+    return result;
+}
+
+/**
+ * @brief Implementation of the withInserted method
+ *
+ * The new version shares every chunk with this one except the one the book
+ * lands in. A book above maxId() goes to the end of the last chunk, or into
+ * a fresh chunk when the last one is full, so IDs handed out in order keep
+ * the chunks dense. Any other book is inserted into the chunk covering its
+ * ID, and that chunk is split in half if it overflows.
+ *
+ * @param book Book to insert
+ * @return The new version
+ */
+std::shared_ptr<const Catalog> Catalog::withInserted(Book book) const {
+    auto next = makeCatalog(*this);
+    ++next->count;
+
+    // Appending: extend the last chunk or start a new one
+    if (chunks.empty() || book.getId() > maxId()) {
+        if (next->chunks.empty() || next->chunks.back()->size() >= kChunkSize) {
+            auto chunk = makeChunk();
+            chunk->reserve(kChunkSize);
+            next->chunks.push_back(std::move(chunk));
+        } else {
+            auto copy = makeChunk(*next->chunks.back());
+            copy->reserve(kChunkSize);
+            next->chunks.back() = std::move(copy);
+        }
+        next->chunks.back()->push_back(std::move(book));
+        next->chunks.back()->seal();
+        return next;
+    }
+
+    // Inserting: IDs below the first chunk go into the first chunk
+    std::size_t index = chunkFor(book.getId());
+    if (index == chunks.size()) {
+        index = 0;
+    }
+
+    auto copy = makeChunk(*chunks[index]);
+    auto position = std::upper_bound(copy->begin(), copy->end(), book.getId(),
+        [](int value, const Book& existing) { return value < existing.getId(); });
+    copy->insert(position, std::move(book));
+
+    if (copy->size() <= kChunkSize) {
+        copy->seal();
+        next->chunks[index] = std::move(copy);
+        return next;
+    }
+
+    // The chunk overflowed: split it into two halves
+    auto middle = copy->begin() + static_cast<std::ptrdiff_t>(copy->size() / 2);
+    auto upper = makeChunk(std::make_move_iterator(middle), std::make_move_iterator(copy->end()));
+    copy->erase(middle, copy->end());
+    copy->seal();
+    upper->seal();
+    next->chunks[index] = std::move(copy);
+    next->chunks.insert(next->chunks.begin() + static_cast<std::ptrdiff_t>(index) + 1, std::move(upper));
+    return next;
+}
+
+/**
+ * @brief Implementation of the withReplaced method
+ *
+ * @param book Replacement; the book with the same ID is swapped out
+ * @return The new version, or nullptr if no book has that ID
+ */
+std::shared_ptr<const Catalog> Catalog::withReplaced(Book book) const {
+    std::size_t index = chunkFor(book.getId());
+    if (index == chunks.size()) {
+        return nullptr;
+    }
+
+    const Chunk& chunk = *chunks[index];
+    auto it = std::lower_bound(chunk.begin(), chunk.end(), book.getId(),
+        [](const Book& existing, int value) { return existing.getId() < value; });
+    if (it == chunk.end() || it->getId() != book.getId()) {
+        return nullptr;
+    }
+
+    auto next = makeCatalog(*this);
+    auto copy = makeChunk(chunk);
+    (*copy)[static_cast<std::size_t>(std::distance(chunk.begin(), it))] = std::move(book);
+    copy->seal();
+    next->chunks[index] = std::move(copy);
+    return next;
+}
+
+/**
+ * @brief Implementation of the without method
+ *
+ * Copies the chunk holding the book, erases the book from the copy and
+ * drops the chunk entirely if it becomes empty.
+ *
+ * @param id Unique identifier of the book to drop
+ * @return The new version, or nullptr if no book has that ID
+ */
+std::shared_ptr<const Catalog> Catalog::without(int id) const {
+    std::size_t index = chunkFor(id);
+    if (index == chunks.size()) {
+        return nullptr;
+    }
+
+    const Chunk& chunk = *chunks[index];
+    auto it = std::lower_bound(chunk.begin(), chunk.end(), id,
+        [](const Book& book, int value) { return book.getId() < value; });
+    if (it == chunk.end() || it->getId() != id) {
+        return nullptr;
+    }
+
+    auto next = makeCatalog(*this);
+    if (chunk.size() == 1) {
+        next->chunks.erase(next->chunks.begin() + static_cast<std::ptrdiff_t>(index));
+    } else {
+        auto copy = makeChunk(chunk);
+        copy->erase(copy->begin() + std::distance(chunk.begin(), it));
+        copy->seal();
+        next->chunks[index] = std::move(copy);
+    }
+
+    --next->count;
+    return next;
+}
@@ -13,8 +13,76 @@
 // func/src/Library.cpp
 #include "Library.hpp"
 #include "JsonUtils.hpp"
+#include "BookTable.hpp"
+#include "ThreadPool.hpp"
+#include "Trace.hpp"
+#include "Latency.hpp"
+#include "TraceEvents.hpp"
+#include "Metrics.hpp"
+#include "SlowLog.hpp"
 #include <iostream>
+#include <limits>
 #include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <shared_mutex>
+
+namespace {
+
+/// @brief Number of chunks scanned by a single search task
+constexpr std::size_t kChunksPerScanTask = 64;
+
+/**
+ * @brief Merges partial result lists into one list in ID order
+ * 
+ * Each partial list is already sorted by ID because chunks are walked
+ * in ID order, so a chain of in-place merges is enough. Consecutive runs
+ * of one shard follow each other in ID order and are just appended; only
+ * the shard boundaries need a merge (and its temporary buffer).
+ * 
+ * @param partial Sorted result lists
+ * @return All results, sorted by ID
+ */
+std::vector<Book> mergeById(std::vector<std::vector<Book>>& partial) {
+    std::size_t total = 0;
+    for (const auto& part : partial) {
+        total += part.size();
+    }
+    
+    std::vector<Book> result;
+    result.reserve(total);
+    for (auto& part : partial) {
+        auto middle = static_cast<std::ptrdiff_t>(result.size());
+        std::move(part.begin(), part.end(), std::back_inserter(result));
+        if (middle > 0 && middle < static_cast<std::ptrdiff_t>(result.size()) &&
+            result[middle - 1].getId() > result[middle].getId()) {
+            std::inplace_merge(result.begin(), result.begin() + middle, result.end(),
+                [](const Book& a, const Book& b) { return a.getId() < b.getId(); });
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Adds the IDs of a batch call to a slow-operation log entry
+ * 
+ * @param entry The entry
+ * @param ids The IDs; only the first 16 are listed
+ */
+void describeIds(SlowLog::Entry& entry, std::span<const int> ids) {
+    constexpr std::size_t kListed = 16;
+    std::string list;
+    for (std::size_t i = 0; i < std::min(ids.size(), kListed); ++i) {
+        list += (i > 0 ? "," : "") + std::to_string(ids[i]);
+    }
+    if (ids.size() > kListed) {
+        list += ",...";
+    }
+    entry.arg("count", static_cast<long long>(ids.size()));
+    entry.arg("ids", list);
+}
+
+} // namespace
 
 /**
  * @brief Constructor implementation for the Library class
@@ -24,11 +92,27 @@
  * based on the highest book ID found in the loaded collection.
  * 
  * @param dataFile Path to the JSON file where book data is stored
+ * @param shardCount Number of independently locked partitions
  */
-Library::Library(const std::string& dataFile) : dataFile(dataFile), nextId(1) {
+Library::Library(const std::string& dataFile, std::size_t shardCount)
+    : dataFile(dataFile), nextId(1), pool(ThreadPool::shared()) {
+    for (std::size_t i = 0; i < std::max<std::size_t>(shardCount, 1); ++i) {
+        shards.push_back(std::make_unique<Shard>());
+    }
     loadBooks();
 }
 
+/**
+ * @brief Destructor implementation
+ * 
+ * Waits until no flush of the async persistence queue is scheduled or
+ * running, so the I/O thread never touches a destroyed Library.
+ */
+Library::~Library() {
+    std::unique_lock<std::mutex> lock(persistQueueMutex);
+    persistIdle.wait(lock, [this] { return !flushScheduled; });
+}
+
 /**
  * @brief Implementation of the loadBooks method
  * 
@@ -39,18 +123,168 @@ Library::Library(const std::string& dataFile) : dataFile(dataFile), nextId(1) {
  * initial value of 1.
  */
 void Library::loadBooks() {
-    // Load books from the JSON file
-    books = JsonUtils::readBooksFromFile(dataFile);
-    
-    // Find the highest ID to set nextId correctly
-    if (!books.empty()) {
-        // Use std::max_element with a lambda function to find the book with the highest ID
-        auto maxIdBook = std::max_element(books.begin(), books.end(),
-            [](const Book& a, const Book& b) { return a.getId() < b.getId(); });
+    Latency::Timer timer(Latency::Op::LoadBooks);
+    TraceEvents::Span span("Library::loadBooks");
+    
+    // Load books from the JSON file and partition them by owning shard
+    std::vector<Book> books = JsonUtils::readBooksFromFile(dataFile);
+    span.arg("books", static_cast<long long>(books.size()));
+    std::vector<std::vector<Book>> partitioned(shards.size());
+    {
+        TraceEvents::Span partitioning("partition by shard");
+        for (auto& book : books) {
+            std::size_t index = Snapshot::shardIndex(book.getId(), shards.size());
+            partitioned[index].push_back(std::move(book));
+        }
+        books.clear();
+    }
+    
+    // Each Catalog sorts its books by ID; shards are built in parallel
+    std::vector<std::shared_ptr<const Catalog>> loaded(shards.size());
+    pool.parallelFor(0, shards.size(), 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            TraceEvents::Span building("build Catalog");
+            building.arg("books", static_cast<long long>(partitioned[i].size()));
+            loaded[i] = std::make_shared<const Catalog>(std::move(partitioned[i]));
+        }
+    });
+    
+    TraceEvents::Span publishing("publish and compute nextId");
+    int highest = 0;
+    std::int64_t unavailable = 0;
+    for (std::size_t i = 0; i < shards.size(); ++i) {
+        highest = std::max(highest, loaded[i]->maxId());
+        loaded[i]->forEach([&unavailable](const Book& book) {
+            unavailable += book.isAvailable() ? 0 : 1;
+        });
         
-        // Set nextId to one more than the highest ID found
-        nextId = maxIdBook->getId() + 1;
+        std::unique_lock<std::shared_mutex> lock(shards[i]->mutex);
+        publish(*shards[i], std::move(loaded[i]));
     }
+    
+    // Set nextId to one more than the highest ID found
+    nextId.store(highest + 1);
+    borrowed.store(unavailable);
+    
+    static Metrics::Gauge& loadSeconds = Metrics::registry().gauge(
+        "library_load_duration_seconds", "Time the last load of the data file took");
+    loadSeconds.set(static_cast<double>(timer.elapsedNs()) / 1e9);
+}
+
+/**
+ * @brief Implementation of the shardFor method
+ * 
+ * @param id Book ID
+ * @return The owning shard
+ */
+Library::Shard& Library::shardFor(int id) const {
+    return *shards[Snapshot::shardIndex(id, shards.size())];
+}
+
+/**
+ * @brief Implementation of the current method
+ * 
+ * @param shard The shard to read
+ * @return The shard's current version
+ */
+std::shared_ptr<const Catalog> Library::current(const Shard& shard) {
+    return shard.books.load();
+}
+
+/**
+ * @brief Implementation of the publish method
+ * 
+ * Swaps the shard's version pointer atomically. Readers that already
+ * pinned the previous version keep it alive until they release it.
+ * 
+ * @param shard The shard to update
+ * @param next The version to make current
+ */
+void Library::publish(Shard& shard, std::shared_ptr<const Catalog> next) {
+    shard.books.store(std::move(next));
+}
+
+/**
+ * @brief Implementation of the reserveIds method
+ * 
+ * @param count Number of IDs to reserve
+ * @return The first reserved ID
+ */
+int Library::reserveIds(int count) {
+    return nextId.fetch_add(count);
+}
+
+/**
+ * @brief Implementation of the collectMatching method
+ * 
+ * Splits every shard of a pinned snapshot into runs of chunks and scans
+ * the runs on the thread pool. Each run produces a sorted partial list;
+ * the lists are merged by ID at the end.
+ * 
+ * @param matches Predicate selecting the books to return
+ * @return Matching books in ID order
+ */
+std::vector<Book> Library::collectMatching(const std::function<bool(const Book&)>& matches) const {
+    Snapshot pinned = snapshot();
+    
+    // One work item per (shard, run of chunks)
+    struct Range { std::size_t shard, first, last; };
+    std::vector<Range> ranges;
+    for (std::size_t s = 0; s < pinned.shardCount(); ++s) {
+        for (std::size_t c = 0; c < pinned.shard(s).chunkCount(); c += kChunksPerScanTask) {
+            ranges.push_back({s, c, c + kChunksPerScanTask});
+        }
+    }
+    
+    std::vector<std::vector<Book>> partial(ranges.size());
+    pool.parallelFor(0, ranges.size(), 1, [&](std::size_t first, std::size_t last) {
+        TraceEvents::Span scanning("scan chunks");
+        scanning.arg("ranges", static_cast<long long>(last - first));
+        for (std::size_t r = first; r < last; ++r) {
+            const Range& range = ranges[r];
+            pinned.shard(range.shard).forEachInChunks(range.first, range.last,
+                [&matches, &part = partial[r]](const Book& book) {
+                    if (matches(book)) {
+                        part.push_back(book);
+                    }
+                });
+        }
+    });
+    
+    TraceEvents::Span merging("merge results");
+    std::vector<Book> result = mergeById(partial);
+    SlowLog::mark(SlowLog::Phase::Lookup);
+    return result;
+}
+
+/**
+ * @brief Implementation of the snapshot method
+ * 
+ * @return Snapshot holding the current version of every shard
+ */
+Snapshot Library::snapshot() const {
+    std::vector<std::shared_ptr<const Catalog>> pinned;
+    pinned.reserve(shards.size());
+    for (const auto& shard : shards) {
+        pinned.push_back(current(*shard));
+    }
+    return Snapshot(std::move(pinned));
+}
+
+/**
+ * @brief Implementation of the shardCount method
+ * @return Shard count
+ */
+std::size_t Library::shardCount() const {
+    return shards.size();
+}
+
+/**
+ * @brief Implementation of the borrowedCount method
+ * @return Borrowed book count
+ */
+std::size_t Library::borrowedCount() const {
+    return static_cast<std::size_t>(std::max<std::int64_t>(0, borrowed.load(std::memory_order_relaxed)));
 }
 
 /**
@@ -59,9 +293,91 @@ void Library::loadBooks() {
  * Writes the current books collection to the JSON data file
  * using JsonUtils. This method is called after any operation
  * that modifies the books collection to ensure data persistence.
+ * 
+ * persistMutex is taken before the version is pinned, so the last
+ * writer to acquire it always writes the newest state. No library
+ * lock is held while serializing or writing.
  */
-void Library::saveBooks() {
-    JsonUtils::writeBooksToFile(dataFile, books);
+bool Library::saveBooks() {
+    Latency::Timer timer(Latency::Op::SaveBooks);
+    SlowLog::Operation slow(Latency::Op::SaveBooks, [&](SlowLog::Entry& entry) {
+        entry.books(snapshot().size());
+    });
+    TraceEvents::Span span("Library::saveBooks");
+    std::lock_guard<std::mutex> persistLock(persistMutex);
+    SlowLog::mark(SlowLog::Phase::Wait);
+    
+    std::vector<Book> books;
+    {
+        TraceEvents::Span copying("Snapshot::toVector");
+        books = snapshot().toVector();
+    }
+    SlowLog::mark(SlowLog::Phase::Serialize);
+    span.arg("books", static_cast<long long>(books.size()));
+    bool saved = JsonUtils::writeBooksToFile(dataFile, books);
+    // Freeing the JSON document is part of serializing
+    SlowLog::mark(SlowLog::Phase::Serialize);
+    return saved;
+}
+
+/**
+ * @brief Implementation of the autoSaveBooks method
+ * 
+ * A flush that has already started may have pinned the catalog before
+ * this change, so the caller waits for the next one to finish. On the
+ * I/O thread, where flushes run, it saves inline instead of waiting for
+ * itself.
+ */
+void Library::autoSaveBooks() {
+    if (!autoSave.load()) {
+        return;
+    }
+    if (ThreadPool::io().isWorker()) {
+        saveBooks();
+        return;
+    }
+    
+    std::unique_lock<std::mutex> lock(persistQueueMutex);
+    std::uint64_t needed = flushesStarted + 1;
+    syncWaiting = true;
+    if (!flushScheduled) {
+        flushScheduled = true;
+        lock.unlock();
+        ThreadPool::io().submit([this] { flushPersistQueue(); });
+        lock.lock();
+    }
+    persistFlushed.wait(lock, [this, needed] { return flushesFinished >= needed; });
+    lock.unlock();
+    // The shared write is logged on its own; the caller only waited for it
+    SlowLog::mark(SlowLog::Phase::Write);
+}
+
+/**
+ * @brief Implementation of the setAutoSave method
+ * @param enabled true to save after every change
+ */
+void Library::setAutoSave(bool enabled) {
+    autoSave = enabled;
+}
+
+/**
+ * @brief Implementation of the setRecorder method
+ * @param recorder The trace to append to, or null
+ */
+void Library::setRecorder(std::shared_ptr<Trace::Recorder> recorder) {
+    this->recorder = std::move(recorder);
+}
+
+/**
+ * @brief Implementation of the flush method
+ * @return true if the data file was written, false otherwise
+ */
+bool Library::flush() {
+    Latency::Timer timer(Latency::Op::Flush);
+    SlowLog::Operation slow(Latency::Op::Flush, [&](SlowLog::Entry& entry) {
+        entry.books(snapshot().size());
+    });
+    return saveBooks();
 }
 
 /**
@@ -74,23 +390,51 @@ void Library::saveBooks() {
  * @param title Title of the book
  * @param author Author of the book
  * @param year Publication year of the book
- * @return true (operation always succeeds in current implementation)
- * 
- * @note In a more robust implementation, this method might perform
- *       validation on the input parameters and return false if validation
- *       fails or if there's an error saving the data.
+ * @return The ID assigned to the new book (adding always succeeds in
+ *         the current implementation)
  */
-bool Library::addBook(const std::string& title, const std::string& author, int year) {
-    // Create a new book with the next available ID
-    Book newBook(nextId++, title, author, year);
+int Library::addBook(const std::string& title, const std::string& author, int year) {
+    Latency::Timer timer(Latency::Op::AddBook);
+    SlowLog::Operation slow(Latency::Op::AddBook, [&](SlowLog::Entry& entry) {
+        entry.arg("title", title);
+        entry.arg("author", author);
+        entry.arg("year", year);
+        entry.books(snapshot().size());
+    });
+    if (recorder) {
+        recorder->recordAdd(title, author, year);
+    }
     
-    // Add the book to our collection
-    books.push_back(newBook);
+    int id = insertBook(title, author, year);
     
     // Save the updated collection to the data file
-    saveBooks();
+    autoSaveBooks();
     
-    return true;
+    return id;
+}
+
+/**
+ * @brief Implementation of the insertBook method
+ * 
+ * @param title Title of the book
+ * @param author Author of the book
+ * @param year Publication year of the book
+ * @return The ID assigned to the new book
+ */
+int Library::insertBook(const std::string& title, const std::string& author, int year) {
+    // Create a new book with the next available ID
+    Book newBook(reserveIds(1), title, author, year);
+    int id = newBook.getId();
+    
+    // Only the owning shard is locked
+    Shard& shard = shardFor(id);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    SlowLog::mark(SlowLog::Phase::Wait);
+    
+    // Derive the next version with the book inserted and publish it
+    publish(shard, current(shard)->withInserted(std::move(newBook)));
+    SlowLog::mark(SlowLog::Phase::Mutate);
+    return id;
 }
 
 /**
@@ -104,46 +448,85 @@ bool Library::addBook(const std::string& title, const std::string& author, int y
  * @return true if the book was found and removed, false otherwise
  */
 bool Library::removeBook(int id) {
-    // Find the book with the specified ID using a lambda function
-    auto it = std::find_if(books.begin(), books.end(),
-        [id](const Book& book) { return book.getId() == id; });
+    Latency::Timer timer(Latency::Op::RemoveBook);
+    SlowLog::Operation slow(Latency::Op::RemoveBook, [&](SlowLog::Entry& entry) {
+        entry.arg("id", id);
+        entry.books(snapshot().size());
+    });
+    if (recorder) {
+        recorder->record(Trace::Op::Remove, id);
+    }
     
-    // If the book was found, remove it and save changes
-    if (it != books.end()) {
-        books.erase(it);
-        saveBooks();
-        return true;
+    // Book not found
+    if (!eraseBook(id)) {
+        return false;
     }
     
+    // The book was removed, save changes
+    autoSaveBooks();
+    return true;
+}
+
+/**
+ * @brief Implementation of the eraseBook method
+ * 
+ * @param id Unique identifier of the book to remove
+ * @return true if the book was found and removed, false otherwise
+ */
+bool Library::eraseBook(int id) {
+    Shard& shard = shardFor(id);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    SlowLog::mark(SlowLog::Phase::Wait);
+    
+    // Derive the next version without the book
+    auto version = current(shard);
+    auto next = version->without(id);
+    
     // Book not found
-    return false;
+    if (!next) {
+        SlowLog::mark(SlowLog::Phase::Lookup);
+        return false;
+    }
+    
+    // Availability cannot change while the exclusive lock is held
+    if (!version->find(id)->isAvailable()) {
+        borrowed.fetch_sub(1, std::memory_order_relaxed);
+    }
+    publish(shard, std::move(next));
+    SlowLog::mark(SlowLog::Phase::Mutate);
+    return true;
 }
 
 /**
  * @brief Implementation of the findBookById method
  * 
- * Searches for a book with the specified ID in the library's collection
- * and returns a pointer to it if found.
+ * Searches for a book with the specified ID in the current version
+ * of the collection and returns a copy of it if found.
  * 
  * @param id Unique identifier of the book to find
- * @return Pointer to the Book object if found, nullptr otherwise
- * 
- * @note The returned pointer points to an object within the books vector,
- *       so it becomes invalid if the vector is modified (e.g., by adding
- *       or removing books).
+ * @return Copy of the Book if found, std::nullopt otherwise
  */
-Book* Library::findBookById(int id) {
-    // Find the book with the specified ID using a lambda function
-    auto it = std::find_if(books.begin(), books.end(),
-        [id](const Book& book) { return book.getId() == id; });
+std::optional<Book> Library::findBookById(int id) const {
+    Latency::Timer timer(Latency::Op::FindBookById);
+    SlowLog::Operation slow(Latency::Op::FindBookById, [&](SlowLog::Entry& entry) {
+        entry.arg("id", id);
+        entry.books(snapshot().size());
+    });
+    if (recorder) {
+        recorder->record(Trace::Op::FindById, id);
+    }
     
-    // If the book was found, return a pointer to it
-    if (it != books.end()) {
-        return &(*it);
+    auto version = current(shardFor(id));
+    
+    // If the book was found, return a copy of it
+    if (const Book* book = version->find(id)) {
+        SlowLog::mark(SlowLog::Phase::Lookup);
+        return *book;
     }
     
     // Book not found
-    return nullptr;
+    SlowLog::mark(SlowLog::Phase::Lookup);
+    return std::nullopt;
 }
 
 /**
@@ -155,17 +538,22 @@ Book* Library::findBookById(int id) {
  * @param title String to search for in book titles
  * @return Vector of Book objects with matching titles
  */
-std::vector<Book> Library::findBooksByTitle(const std::string& title) {
-    std::vector<Book> result;
-    
-    // Use std::copy_if with a lambda function to find books with matching titles
-    std::copy_if(books.begin(), books.end(), std::back_inserter(result),
-        [&title](const Book& book) {
-            // Check if the book's title contains the search string
-            return book.getTitle().find(title) != std::string::npos;
-        });
+std::vector<Book> Library::findBooksByTitle(const std::string& title) const {
+    Latency::Timer timer(Latency::Op::FindBooksByTitle);
+    SlowLog::Operation slow(Latency::Op::FindBooksByTitle, [&](SlowLog::Entry& entry) {
+        entry.arg("title", title);
+        entry.books(snapshot().size());
+    });
+    if (recorder) {
+        recorder->record(Trace::Op::FindByTitle, title);
+    }
+    TraceEvents::Span span("Library::findBooksByTitle");
     
-    return result;
+    // Fan out over all shards and collect books with matching titles
+    return collectMatching([&title](const Book& book) {
+        // Check if the book's title contains the search string
+        return book.getTitle().find(title) != std::string::npos;
+    });
 }
 
 /**
@@ -177,17 +565,22 @@ std::vector<Book> Library::findBooksByTitle(const std::string& title) {
  * @param author String to search for in book authors
  * @return Vector of Book objects with matching authors
  */
-std::vector<Book> Library::findBooksByAuthor(const std::string& author) {
-    std::vector<Book> result;
-    
-    // Use std::copy_if with a lambda function to find books with matching authors
-    std::copy_if(books.begin(), books.end(), std::back_inserter(result),
-        [&author](const Book& book) {
-            // Check if the book's author contains the search string
-            return book.getAuthor().find(author) != std::string::npos;
-        });
+std::vector<Book> Library::findBooksByAuthor(const std::string& author) const {
+    Latency::Timer timer(Latency::Op::FindBooksByAuthor);
+    SlowLog::Operation slow(Latency::Op::FindBooksByAuthor, [&](SlowLog::Entry& entry) {
+        entry.arg("author", author);
+        entry.books(snapshot().size());
+    });
+    if (recorder) {
+        recorder->record(Trace::Op::FindByAuthor, author);
+    }
+    TraceEvents::Span span("Library::findBooksByAuthor");
     
-    return result;
+    // Fan out over all shards and collect books with matching authors
+    return collectMatching([&author](const Book& book) {
+        // Check if the book's author contains the search string
+        return book.getAuthor().find(author) != std::string::npos;
+    });
 }
 
 /**
@@ -201,18 +594,46 @@ std::vector<Book> Library::findBooksByAuthor(const std::string& author) {
  *         false if the book was not found or is already borrowed
  */
 bool Library::borrowBook(int id) {
-    // Find the book with the specified ID
-    Book* book = findBookById(id);
+    Latency::Timer timer(Latency::Op::BorrowBook);
+    SlowLog::Operation slow(Latency::Op::BorrowBook, [&](SlowLog::Entry& entry) {
+        entry.arg("id", id);
+        entry.books(snapshot().size());
+    });
+    if (recorder) {
+        recorder->record(Trace::Op::Borrow, id);
+    }
     
-    // If the book was found and is available, mark it as borrowed
-    if (book && book->isAvailable()) {
-        book->borrow();
-        saveBooks();
-        return true;
+    // Book not found, or another caller got there first
+    if (!markBorrowed(id)) {
+        return false;
     }
     
-    // Book not found or not available
-    return false;
+    autoSaveBooks();
+    return true;
+}
+
+/**
+ * @brief Implementation of the markBorrowed method
+ * 
+ * @param id Unique identifier of the book to borrow
+ * @return true if this call borrowed the book, false otherwise
+ */
+bool Library::markBorrowed(int id) {
+    // Borrowing flips the atomic flag in place; the shared lock only
+    // keeps writers from copying the book's chunk at the same time
+    Shard& shard = shardFor(id);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    SlowLog::mark(SlowLog::Phase::Wait);
+    
+    // Find the book with the specified ID
+    Book* book = current(shard)->findForLoan(id);
+    SlowLog::mark(SlowLog::Phase::Lookup);
+    if (!book || !book->tryBorrow()) {
+        return false;
+    }
+    borrowed.fetch_add(1, std::memory_order_relaxed);
+    SlowLog::mark(SlowLog::Phase::Mutate);
+    return true;
 }
 
 /**
@@ -226,18 +647,495 @@ bool Library::borrowBook(int id) {
  *         false if the book was not found or is already available
  */
 bool Library::returnBook(int id) {
+    Latency::Timer timer(Latency::Op::ReturnBook);
+    SlowLog::Operation slow(Latency::Op::ReturnBook, [&](SlowLog::Entry& entry) {
+        entry.arg("id", id);
+        entry.books(snapshot().size());
+    });
+    if (recorder) {
+        recorder->record(Trace::Op::Return, id);
+    }
+    
+    // Book not found or already available
+    if (!markReturned(id)) {
+        return false;
+    }
+    
+    autoSaveBooks();
+    return true;
+}
+
+/**
+ * @brief Implementation of the markReturned method
+ * 
+ * @param id Unique identifier of the book to return
+ * @return true if this call returned the book, false otherwise
+ */
+bool Library::markReturned(int id) {
+    Shard& shard = shardFor(id);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    SlowLog::mark(SlowLog::Phase::Wait);
+    
     // Find the book with the specified ID
-    Book* book = findBookById(id);
+    Book* book = current(shard)->findForLoan(id);
+    SlowLog::mark(SlowLog::Phase::Lookup);
+    if (!book || !book->tryReturn()) {
+        return false;
+    }
+    borrowed.fetch_sub(1, std::memory_order_relaxed);
+    SlowLog::mark(SlowLog::Phase::Mutate);
+    return true;
+}
+
+/**
+ * @brief Implementation of the replaceBook method
+ * 
+ * The version check and the publish of the edited copy happen under the
+ * owning shard's exclusive lock, which is held only for the copy of one
+ * chunk.
+ * 
+ * @param id Unique identifier of the book to edit
+ * @param expectedVersion Version the caller's copy of the book has
+ * @param title New title
+ * @param author New author
+ * @param year New publication year
+ * @return Outcome of the edit
+ */
+UpdateResult Library::replaceBook(int id, std::uint64_t expectedVersion,
+                                  const std::string& title, const std::string& author, int year) {
+    Shard& shard = shardFor(id);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    SlowLog::mark(SlowLog::Phase::Wait);
     
-    // If the book was found and is borrowed, mark it as returned
-    if (book && !book->isAvailable()) {
-        book->returnBook();
-        saveBooks();
+    auto version = current(shard);
+    const Book* existing = version->find(id);
+    SlowLog::mark(SlowLog::Phase::Lookup);
+    if (!existing) {
+        return UpdateResult::NotFound;
+    }
+    if (existing->getVersion() != expectedVersion) {
+        return UpdateResult::Conflict;
+    }
+    
+    // Build the edited copy; availability is carried over unchanged
+    Book edited(*existing);
+    edited.setTitle(title);
+    edited.setAuthor(author);
+    edited.setYear(year);
+    edited.setVersion(expectedVersion + 1);
+    
+    publish(shard, version->withReplaced(std::move(edited)));
+    SlowLog::mark(SlowLog::Phase::Mutate);
+    return UpdateResult::Updated;
+}
+
+/**
+ * @brief Implementation of the updateBook method
+ * 
+ * The data file is written after the shard lock has been released.
+ * 
+ * @param id Unique identifier of the book to edit
+ * @param expectedVersion Version the caller's copy of the book has
+ * @param title New title
+ * @param author New author
+ * @param year New publication year
+ * @return Outcome of the edit
+ */
+UpdateResult Library::updateBook(int id, std::uint64_t expectedVersion,
+                                 const std::string& title, const std::string& author, int year) {
+    Latency::Timer timer(Latency::Op::UpdateBook);
+    SlowLog::Operation slow(Latency::Op::UpdateBook, [&](SlowLog::Entry& entry) {
+        entry.arg("id", id);
+        entry.arg("version", static_cast<long long>(expectedVersion));
+        entry.arg("title", title);
+        entry.arg("author", author);
+        entry.arg("year", year);
+        entry.books(snapshot().size());
+    });
+    if (recorder) {
+        recorder->recordUpdate(id, expectedVersion, title, author, year);
+    }
+    
+    UpdateResult result = replaceBook(id, expectedVersion, title, author, year);
+    if (result == UpdateResult::Updated) {
+        autoSaveBooks();
+    }
+    return result;
+}
+
+/**
+ * @brief Implementation of the borrowBooks method
+ * 
+ * @param ids Unique identifiers of the books to borrow
+ * @return true if all books were borrowed, false otherwise
+ */
+bool Library::borrowBooks(std::span<const int> ids) {
+    Latency::Timer timer(Latency::Op::BorrowBooks);
+    SlowLog::Operation slow(Latency::Op::BorrowBooks, [&](SlowLog::Entry& entry) {
+        describeIds(entry, ids);
+        entry.books(snapshot().size());
+    });
+    if (recorder) {
+        recorder->record(Trace::Op::BorrowMany, ids);
+    }
+    
+    if (!markAll(ids, true)) {
+        return false;
+    }
+    
+    // One save for the whole batch
+    autoSaveBooks();
+    return true;
+}
+
+/**
+ * @brief Implementation of the returnBooks method
+ * 
+ * @param ids Unique identifiers of the books to return
+ * @return true if all books were returned, false otherwise
+ */
+bool Library::returnBooks(std::span<const int> ids) {
+    Latency::Timer timer(Latency::Op::ReturnBooks);
+    SlowLog::Operation slow(Latency::Op::ReturnBooks, [&](SlowLog::Entry& entry) {
+        describeIds(entry, ids);
+        entry.books(snapshot().size());
+    });
+    if (recorder) {
+        recorder->record(Trace::Op::ReturnMany, ids);
+    }
+    
+    if (!markAll(ids, false)) {
+        return false;
+    }
+    
+    // One save for the whole batch
+    autoSaveBooks();
+    return true;
+}
+
+/**
+ * @brief Implementation of the markAll method
+ * 
+ * Works in three steps:
+ * 1. Lock (exclusive) every shard touched by the batch, in shard order so
+ *    that two batches can never wait on each other
+ * 2. Resolve all IDs and check every book's state; reject the batch if
+ *    any ID is unknown, repeated, or in the wrong state
+ * 3. Flip each flag
+ * 
+ * Single borrows and returns flip flags under the shared lock, so the
+ * exclusive locks keep them out between steps 2 and 3: every flip of
+ * step 3 succeeds and no other caller ever sees part of the batch.
+ * 
+ * @param ids Unique identifiers of the books
+ * @param borrowing true to borrow, false to return
+ * @return true if every book changed state, false if none did
+ */
+bool Library::markAll(std::span<const int> ids, bool borrowing) {
+    if (ids.empty()) {
         return true;
     }
     
-    // Book not found or already available
-    return false;
+    // Duplicates would make the batch fail against itself
+    std::vector<int> sorted(ids.begin(), ids.end());
+    std::sort(sorted.begin(), sorted.end());
+    if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+        return false;
+    }
+    
+    // Step 1: lock every involved shard once, in shard order
+    std::vector<std::size_t> involved;
+    for (int id : sorted) {
+        involved.push_back(Snapshot::shardIndex(id, shards.size()));
+    }
+    std::sort(involved.begin(), involved.end());
+    involved.erase(std::unique(involved.begin(), involved.end()), involved.end());
+    
+    std::vector<std::unique_lock<std::shared_mutex>> locks;
+    std::vector<std::shared_ptr<const Catalog>> versions(shards.size());
+    for (std::size_t index : involved) {
+        locks.emplace_back(shards[index]->mutex);
+        versions[index] = current(*shards[index]);
+    }
+    SlowLog::mark(SlowLog::Phase::Wait);
+    
+    // Step 2: resolve and validate every book before touching any
+    std::vector<Book*> books;
+    books.reserve(sorted.size());
+    for (int id : sorted) {
+        Book* book = versions[Snapshot::shardIndex(id, shards.size())]->findForLoan(id);
+        if (!book || book->isAvailable() != borrowing) {
+            return false;
+        }
+        books.push_back(book);
+    }
+    SlowLog::mark(SlowLog::Phase::Lookup);
+    
+    // Step 3: flip the flags; nobody else can flip them while the locks are held
+    for (Book* book : books) {
+        book->setAvailable(!borrowing);
+    }
+    
+    std::int64_t changed = static_cast<std::int64_t>(books.size());
+    borrowed.fetch_add(borrowing ? changed : -changed, std::memory_order_relaxed);
+    SlowLog::mark(SlowLog::Phase::Mutate);
+    return true;
+}
+
+/**
+ * @brief Implementation of the PersistAwaiter::await_suspend method
+ * 
+ * Parks the coroutine in the persistence queue. The first waiter of a
+ * batch schedules a flush on the I/O pool; everyone who arrives before
+ * that flush starts shares its single write.
+ * 
+ * The slow-log timing of the operation is detached first: once the
+ * handle is queued the coroutine may resume on the I/O thread at once.
+ * 
+ * @param handle The suspended coroutine
+ */
+void Library::PersistAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    slow = SlowLog::detach();
+    bool schedule = false;
+    {
+        std::lock_guard<std::mutex> lock(library.persistQueueMutex);
+        library.persistWaiters.push_back(handle);
+        if (!library.flushScheduled) {
+            library.flushScheduled = true;
+            schedule = true;
+        }
+    }
+    
+    if (schedule) {
+        ThreadPool::io().submit([lib = &library] { lib->flushPersistQueue(); });
+    }
+}
+
+/**
+ * @brief Implementation of the PersistAwaiter::await_resume method
+ * 
+ * Runs on the I/O pool inside flushPersistQueue (or inline if the write
+ * was skipped), where the slow-log timing is picked up again together
+ * with that of the flush.
+ * 
+ * @return true if the flush that covered this caller succeeded
+ */
+bool Library::PersistAwaiter::await_resume() const noexcept {
+    if (slow) {
+        SlowLog::resume(slow, library.flushTimed ? &library.flushTiming : nullptr);
+    }
+    return library.lastFlushSucceeded.load();
+}
+
+/**
+ * @brief Implementation of the persistAsync method
+ * @return Awaitable that resumes once the current state is on disk
+ */
+Library::PersistAwaiter Library::persistAsync() {
+    return PersistAwaiter{*this};
+}
+
+/**
+ * @brief Implementation of the flushPersistQueue method
+ * 
+ * Runs on the I/O pool. Takes the whole batch of waiters, writes the data
+ * file once, then wakes the synchronous callers and resumes every waiter
+ * of the batch. Waiters that arrived during the write form the next
+ * batch, which is flushed right after.
+ * 
+ * The write is timed for the slow log as one save, and its timing is
+ * kept in flushTiming for the waiters to add to their own.
+ */
+void Library::flushPersistQueue() {
+    std::vector<std::coroutine_handle<>> batch;
+    std::uint64_t flush = 0;
+    {
+        std::lock_guard<std::mutex> lock(persistQueueMutex);
+        batch.swap(persistWaiters);
+        syncWaiting = false;
+        flush = ++flushesStarted;
+    }
+    
+    flushTimed = SlowLog::begin(Latency::Op::SaveBooks, flushTiming);
+    lastFlushSucceeded = saveBooks();
+    if (flushTimed && SlowLog::end(flushTiming)) {
+        SlowLog::Entry entry;
+        entry.arg("waiters", static_cast<long long>(batch.size()));
+        entry.books(snapshot().size());
+        SlowLog::write(flushTiming, entry);
+    }
+    {
+        std::lock_guard<std::mutex> lock(persistQueueMutex);
+        flushesFinished = flush;
+    }
+    persistFlushed.notify_all();
+    for (auto handle : batch) {
+        handle.resume();
+    }
+    
+    std::lock_guard<std::mutex> lock(persistQueueMutex);
+    if (persistWaiters.empty() && !syncWaiting) {
+        flushScheduled = false;
+        persistIdle.notify_all();
+    } else {
+        ThreadPool::io().submit([this] { flushPersistQueue(); });
+    }
+}
+
+/**
+ * @brief Implementation of the addBookAsync method
+ * 
+ * @param title Title of the book
+ * @param author Author of the book
+ * @param year Publication year of the book
+ * @return Task yielding true once the book is added and persisted
+ */
+Task<bool> Library::addBookAsync(std::string title, std::string author, int year) {
+    Latency::Timer timer(Latency::Op::AddBookAsync);
+    SlowLog::Operation slow(Latency::Op::AddBookAsync, [&](SlowLog::Entry& entry) {
+        entry.arg("title", title);
+        entry.arg("author", author);
+        entry.arg("year", year);
+        entry.books(snapshot().size());
+    });
+    if (recorder) {
+        recorder->recordAdd(title, author, year);
+    }
+    
+    insertBook(title, author, year);
+    co_await persistAsync();
+    co_return true;
+}
+
+/**
+ * @brief Implementation of the removeBookAsync method
+ * 
+ * @param id Unique identifier of the book to remove
+ * @return Task yielding true if the book was found and removed
+ */
+Task<bool> Library::removeBookAsync(int id) {
+    Latency::Timer timer(Latency::Op::RemoveBookAsync);
+    SlowLog::Operation slow(Latency::Op::RemoveBookAsync, [&](SlowLog::Entry& entry) {
+        entry.arg("id", id);
+        entry.books(snapshot().size());
+    });
+    if (recorder) {
+        recorder->record(Trace::Op::Remove, id);
+    }
+    
+    if (!eraseBook(id)) {
+        co_return false;
+    }
+    co_await persistAsync();
+    co_return true;
+}
+
+/**
+ * @brief Implementation of the borrowBookAsync method
+ * 
+ * @param id Unique identifier of the book to borrow
+ * @return Task yielding true if the book was borrowed
+ */
+Task<bool> Library::borrowBookAsync(int id) {
+    Latency::Timer timer(Latency::Op::BorrowBookAsync);
+    SlowLog::Operation slow(Latency::Op::BorrowBookAsync, [&](SlowLog::Entry& entry) {
+        entry.arg("id", id);
+        entry.books(snapshot().size());
+    });
+    if (recorder) {
+        recorder->record(Trace::Op::Borrow, id);
+    }
+    
+    if (!markBorrowed(id)) {
+        co_return false;
+    }
+    co_await persistAsync();
+    co_return true;
+}
+
+/**
+ * @brief Implementation of the updateBookAsync method
+ * 
+ * @param id Unique identifier of the book to edit
+ * @param expectedVersion Version the caller's copy of the book has
+ * @param title New title
+ * @param author New author
+ * @param year New publication year
+ * @return Task yielding the outcome once an applied edit is persisted
+ */
+Task<UpdateResult> Library::updateBookAsync(int id, std::uint64_t expectedVersion,
+                                            std::string title, std::string author, int year) {
+    Latency::Timer timer(Latency::Op::UpdateBookAsync);
+    SlowLog::Operation slow(Latency::Op::UpdateBookAsync, [&](SlowLog::Entry& entry) {
+        entry.arg("id", id);
+        entry.arg("version", static_cast<long long>(expectedVersion));
+        entry.arg("title", title);
+        entry.arg("author", author);
+        entry.arg("year", year);
+        entry.books(snapshot().size());
+    });
+    if (recorder) {
+        recorder->recordUpdate(id, expectedVersion, title, author, year);
+    }
+    
+    UpdateResult result = replaceBook(id, expectedVersion, title, author, year);
+    if (result == UpdateResult::Updated) {
+        co_await persistAsync();
+    }
+    co_return result;
+}
+
+/**
+ * @brief Implementation of the returnBookAsync method
+ * 
+ * @param id Unique identifier of the book to return
+ * @return Task yielding true if the book was returned
+ */
+Task<bool> Library::returnBookAsync(int id) {
+    Latency::Timer timer(Latency::Op::ReturnBookAsync);
+    SlowLog::Operation slow(Latency::Op::ReturnBookAsync, [&](SlowLog::Entry& entry) {
+        entry.arg("id", id);
+        entry.books(snapshot().size());
+    });
+    if (recorder) {
+        recorder->record(Trace::Op::Return, id);
+    }
+    
+    if (!markReturned(id)) {
+        co_return false;
+    }
+    co_await persistAsync();
+    co_return true;
+}
+
+/**
+ * @brief Implementation of the findBookByIdAsync method
+ * 
+ * @param id Unique identifier of the book to find
+ * @return Task yielding a copy of the book, or std::nullopt
+ */
+Task<std::optional<Book>> Library::findBookByIdAsync(int id) const {
+    co_return findBookById(id);
+}
+
+/**
+ * @brief Implementation of the findBooksByTitleAsync method
+ * 
+ * @param title String to search for in book titles
+ * @return Task yielding the matching books
+ */
+Task<std::vector<Book>> Library::findBooksByTitleAsync(std::string title) const {
+    co_return findBooksByTitle(title);
+}
+
+/**
+ * @brief Implementation of the findBooksByAuthorAsync method
+ * 
+ * @param author String to search for in book authors
+ * @return Task yielding the matching books
+ */
+Task<std::vector<Book>> Library::findBooksByAuthorAsync(std::string author) const {
+    co_return findBooksByAuthor(author);
 }
 
 /**
@@ -246,7 +1144,48 @@ bool Library::returnBook(int id) {
  * @return Vector containing all Book objects in the library
  */
 std::vector<Book> Library::getAllBooks() const {
-    return books;
+    Latency::Timer timer(Latency::Op::GetAllBooks);
+    SlowLog::Operation slow(Latency::Op::GetAllBooks, [&](SlowLog::Entry& entry) {
+        entry.books(snapshot().size());
+    });
+    return snapshot().toVector();
+}
+
+/**
+ * @brief Implementation of the pageAfter method
+ * 
+ * Looks one match past the page to tell whether another page follows.
+ * 
+ * @param afterId Cursor: only books with a higher ID are returned
+ * @param limit Maximum number of books to return
+ * @param matches Optional predicate selecting the books to list
+ * @return The page, in ID order
+ */
+BookPage Library::pageAfter(int afterId, std::size_t limit,
+                            const std::function<bool(const Book&)>& matches) const {
+    Latency::Timer timer(Latency::Op::PageAfter);
+    SlowLog::Operation slow(Latency::Op::PageAfter, [&](SlowLog::Entry& entry) {
+        entry.arg("after", afterId);
+        entry.arg("limit", static_cast<long long>(limit));
+        entry.books(snapshot().size());
+    });
+    BookPage page;
+    if (afterId == std::numeric_limits<int>::max()) {
+        return page;
+    }
+    
+    snapshot().forEachFrom(afterId + 1, [&](const Book& book) {
+        if (matches && !matches(book)) {
+            return true;
+        }
+        if (page.books.size() == limit) {
+            page.hasMore = true;
+            return false;
+        }
+        page.books.push_back(book);
+        return true;
+    });
+    return page;
 }
 
 /**
@@ -254,30 +1193,25 @@ std::vector<Book> Library::getAllBooks() const {
  * 
  * Prints a formatted table of all books in the library to the standard
  * output, showing each book's ID, title, author, year, and availability.
- * If the library is empty, displays a message indicating that.
+ * If the library is empty, displays a message indicating that. The pinned
+ * snapshot is walked twice: once to size the columns and once to print.
  */
 void Library::displayAllBooks() const {
+    // Pin one version so the table is consistent from top to bottom
+    Snapshot pinned = snapshot();
+    
     // Check if the library is empty
-    if (books.empty()) {
+    if (pinned.empty()) {
         std::cout << "No books in the library." << std::endl;
         return;
     }
     
-    // Display header for the book table
-    std::cout << "Library Books:" << std::endl;
-    std::cout << "----------------------------------------" << std::endl;
-    std::cout << "ID | Title | Author | Year | Available" << std::endl;
-    std::cout << "----------------------------------------" << std::endl;
-    
-    // Display each book's details in a formatted row
-    for (const auto& book : books) {
-        std::cout << book.getId() << " | "
-                  << book.getTitle() << " | "
-                  << book.getAuthor() << " | "
-                  << book.getYear() << " | "
-                  << (book.isAvailable() ? "Yes" : "No") << std::endl;
-    }
-    
-    // Display footer for the book table
-    std::cout << "----------------------------------------" << std::endl;
+    // Size the columns from the data, then render in large chunks
+    BookTable table(std::cout);
+    pinned.forEach([&table](const Book& book) { table.measure(book); });
+
+    std::cout << "Library Books:\n";
+    table.writeHeader();
+    pinned.forEach([&table](const Book& book) { table.writeRow(book); });
+    table.writeRule();
 }
\ No newline at end of file
@@ -0,0 +1,111 @@
+/**
+ * @file Snapshot.cpp
+ * @brief Implementation of the pinned, read-only view over all shards
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements the Snapshot class declared in Snapshot.hpp.
+ */
+
+// func/src/Snapshot.cpp
+#include "Snapshot.hpp"
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * @brief Constructor implementation
+ *
+ * @param shards One pinned version per shard, indexed by shard number
+ */
+Snapshot::Snapshot(std::vector<std::shared_ptr<const Catalog>> shards)
+    : shards(std::move(shards)) {}
+
+/**
+ * @brief Implementation of the shardIndex method
+ *
+ * Uses Knuth's multiplicative hash and folds the high bits back in before
+ * taking the remainder, so both small and large shard counts spread evenly.
+ *
+ * @param id Book ID
+ * @param shardCount Total number of shards (at least 1)
+ * @return Shard number in [0, shardCount)
+ */
+std::size_t Snapshot::shardIndex(int id, std::size_t shardCount) {
+    std::uint32_t hash = static_cast<std::uint32_t>(id) * 2654435761u;
+    hash ^= hash >> 16;
+    return hash % shardCount;
+}
+
+/**
+ * @brief Implementation of the shardCount method
+ * @return Shard count
+ */
+std::size_t Snapshot::shardCount() const {
+    return shards.size();
+}
+
+/**
+ * @brief Implementation of the shard method
+ *
+ * @param index Shard number
+ * @return The shard's catalog
+ */
+const Catalog& Snapshot::shard(std::size_t index) const {
+    return *shards[index];
+}
+
+/**
+ * @brief Implementation of the size method
+ * @return Number of books
+ */
+std::size_t Snapshot::size() const {
+    std::size_t total = 0;
+    for (const auto& shard : shards) {
+        total += shard->size();
+    }
+    return total;
+}
+
+/**
+ * @brief Implementation of the empty method
+ * @return true if every shard is empty, false otherwise
+ */
+bool Snapshot::empty() const {
+    return std::all_of(shards.begin(), shards.end(),
+        [](const std::shared_ptr<const Catalog>& shard) { return shard->empty(); });
+}
+
+/**
+ * @brief Implementation of the maxId method
+ * @return Highest ID, or 0 if the snapshot is empty
+ */
+int Snapshot::maxId() const {
+    int highest = 0;
+    for (const auto& shard : shards) {
+        highest = std::max(highest, shard->maxId());
+    }
+    return highest;
+}
+
+/**
+ * @brief Implementation of the find method
+ *
+ * Routes the lookup to the owning shard; no other shard is touched.
+ *
+ * @param id Unique identifier of the book to find
+ * @return Pointer to the book inside the pinned version, nullptr if not found
+ */
+const Book* Snapshot::find(int id) const {
+    return shards[shardIndex(id, shards.size())]->find(id);
+}
+
+/**
+ * @brief Implementation of the toVector method
+ * @return Vector of books in ID order
+ */
+std::vector<Book> Snapshot::toVector() const {
+    std::vector<Book> result;
+    result.reserve(size());
+    forEach([&result](const Book& book) { result.push_back(book); });
+    return result;
+}
@@ -14,10 +14,117 @@
  * the business logic (Library class) and the user interface (Display namespace).
  */
 
+ #include <csignal>
+ #include <cstdlib>
+ #include <fstream>
  #include <iostream>
+ #include <memory>
  #include <string>
  #include "Library.hpp"
  #include "Display.hpp"
+ #include "Batch.hpp"
+ #include "Export.hpp"
+ #include "EventLoop.hpp"
+ #include "HttpServer.hpp"
+ #include "HttpApi.hpp"
+ #include "MetricsExporter.hpp"
+ #include "BinaryServer.hpp"
+ #include "Trace.hpp"
+ #include "TraceEvents.hpp"
+ #include "SlowLog.hpp"
+ #include "Metrics.hpp"
+ #include "ThreadPool.hpp"
+ 
+ /// @brief Loop of the running server, stopped by SIGINT/SIGTERM
+ static EventLoop* serverLoop = nullptr;
+ 
+ /**
+  * @brief Signal handler that shuts the server down gracefully
+  * 
+  * @param signal The received signal (unused)
+  */
+ static void stopServer(int /*signal*/) {
+     if (serverLoop) {
+         serverLoop->stop();
+     }
+ }
+ 
+ /**
+  * @brief Runs the requested servers until SIGINT or SIGTERM
+  * 
+  * Both servers share one event loop and one in-memory library.
+  * 
+  * @param library The library to serve
+  * @param httpPort Loopback port for HTTP (0 picks a free port), or -1 for none
+  * @param socketPath Unix domain socket for the binary protocol, or empty for none
+  * @return 0 after a clean shutdown, 1 if a server could not start
+  */
+ static int runServer(Library& library, long httpPort, const std::string& socketPath) {
+     EventLoop loop;
+     if (!loop.valid()) {
+         return 1;
+     }
+     
+     HttpServer http(loop, [&library](const HttpRequest& request, HttpServer::Responder respond) {
+         HttpApi::handle(library, request, std::move(respond));
+     });
+     if (httpPort >= 0) {
+         if (!http.listen(static_cast<std::uint16_t>(httpPort))) {
+             return 1;
+         }
+         std::cout << "Listening on http://127.0.0.1:" << http.port() << "/books" << std::endl;
+     }
+     
+     BinaryServer binary(loop, library);
+     if (!socketPath.empty()) {
+         if (!binary.listen(socketPath)) {
+             return 1;
+         }
+         std::cout << "Listening on unix:" << socketPath << std::endl;
+     }
+     
+     serverLoop = &loop;
+     std::signal(SIGINT, stopServer);
+     std::signal(SIGTERM, stopServer);
+     loop.run();
+     
+     // Finish the requests whose saves are still in flight before exiting
+     http.shutdown();
+     binary.shutdown();
+     serverLoop = nullptr;
+     return 0;
+ }
+ 
+ /**
+  * @brief Prints the command line usage to standard error
+  * 
+  * @param program Name the program was started as
+  */
+ static void printUsage(const char* program) {
+     std::cerr << "Usage: " << program << " [--data <file>] [--shards <n>] [--pool-threads <n>] [--pin-threads] [--record <trace>] [--trace-events <file>] [--metrics-port <port>] [--metrics-file <file>] [--slow-log <file>] [--batch <script|-> | --export <format> | --serve <port> | --socket <path>]\n"
+               << "  --data <file>    JSON data file (default: data/books.json)\n"
+               << "  --shards <n>     Number of library shards (default: 1)\n"
+               << "  --pool-threads <n> Worker threads for parallel loads and searches\n"
+               << "                   (default: 0, one per hardware thread)\n"
+               << "  --pin-threads    Pin worker i of that pool to CPU i (Linux only)\n"
+               << "  --record <trace> Record every library call into <trace> for bin/replay\n"
+               << "  --trace-events <file> Write load, save and search spans as Chrome trace-event\n"
+               << "                   JSON (also enabled by LIBRARY_TRACE_EVENTS=<file>)\n"
+               << "  --metrics-port <port> Serve Prometheus metrics on http://127.0.0.1:<port>/metrics\n"
+               << "  --metrics-file <file> Write Prometheus metrics to <file> periodically and at exit\n"
+               << "  --metrics-interval <s> Seconds between --metrics-file writes (default: 10)\n"
+               << "  --slow-log <file> Log library operations slower than --slow-ms to <file>,\n"
+               << "                   with their arguments and time per phase (rotated at 16 MiB)\n"
+               << "  --slow-ms <ms>   Threshold of --slow-log in milliseconds (default: 100)\n"
+               << "  --batch <script> Run the commands in <script> ('-' for stdin)\n"
+               << "                   instead of the interactive menu\n"
+               << "  --export <format> Write the books to stdout as csv, jsonl or json\n"
+               << "  --title <text>   With --export: only books whose title contains <text>\n"
+               << "  --author <text>  With --export: only books whose author contains <text>\n"
+               << "  --serve <port>   Serve the JSON/HTTP API on 127.0.0.1:<port>\n"
+               << "  --socket <path>  Serve the binary protocol on a Unix domain socket\n"
+               << "                   (may be combined with --serve)\n";
+ }
  
  /**
   * @brief Main entry point for the library management system
@@ -32,12 +139,248 @@
   * coordinating between the user interface (Display namespace) and the business
   * logic (Library class).
   * 
-  * @return 0 on successful execution
+  * When started with --batch, the commands of a script are executed instead
+  * of the menu loop (see Batch.hpp) and the data file is written once at the end.
+  * --export streams the (optionally filtered) books to stdout (see Export.hpp).
+  * --record writes a trace of every library call made in any mode (see Trace.hpp),
+  * and --trace-events a Chrome trace of where time goes (see TraceEvents.hpp).
+  * --metrics-port and --metrics-file publish counters, gauges and latency
+  * histograms in Prometheus format alongside any mode (see MetricsExporter.hpp).
+  * --slow-log records every library operation slower than --slow-ms (see SlowLog.hpp).
+  * --pool-threads and --pin-threads size the shared worker pool (see ThreadPool.hpp)
+  * before the library first uses it.
+  * With --serve and/or --socket, the library is served over HTTP and/or the
+  * binary protocol until SIGINT or SIGTERM (see HttpApi.hpp, BinaryProtocol.hpp).
+  * 
+  * @param argc Number of command line arguments
+  * @param argv Command line arguments
+  * @return 0 on successful execution, 1 on invalid arguments, a failed batch
+  *         save or export, or a server that could not start
   */
- int main() {
+ int main(int argc, char* argv[]) {
+     std::string dataFile = "data/books.json";
+     std::size_t shards = 1;
+     std::size_t poolThreads = 0;
+     bool pinThreads = false;
+     std::string batchScript;
+     bool batchMode = false;
+     long servePort = -1;
+     std::string socketPath;
+     std::string exportFormat;
+     std::string exportField;
+     std::string exportText;
+     std::string tracePath;
+     std::string traceEventsPath;
+     long metricsPort = -1;
+     std::string metricsFile;
+     long metricsInterval = 10;
+     std::string slowLogPath;
+     double slowMs = 100;
+     
+     // Parse the command line options
+     for (int i = 1; i < argc; ++i) {
+         std::string arg = argv[i];
+         if ((arg == "--data" || arg == "--shards" || arg == "--batch" || arg == "--serve" ||
+              arg == "--socket" || arg == "--export" || arg == "--title" || arg == "--author" ||
+              arg == "--record" || arg == "--trace-events" || arg == "--metrics-port" ||
+              arg == "--metrics-file" || arg == "--metrics-interval" || arg == "--slow-log" ||
+              arg == "--slow-ms" || arg == "--pool-threads") && i + 1 >= argc) {
+             std::cerr << "Missing value for " << arg << "\n";
+             printUsage(argv[0]);
+             return 1;
+         }
+         
+         if (arg == "--data") {
+             dataFile = argv[++i];
+         } else if (arg == "--shards") {
+             char* end = nullptr;
+             long value = std::strtol(argv[++i], &end, 10);
+             if (*end != '\0' || value < 1) {
+                 std::cerr << "Invalid shard count: " << argv[i] << "\n";
+                 return 1;
+             }
+             shards = static_cast<std::size_t>(value);
+         } else if (arg == "--pool-threads") {
+             char* end = nullptr;
+             long value = std::strtol(argv[++i], &end, 10);
+             if (*end != '\0' || value < 0) {
+                 std::cerr << "Invalid pool thread count: " << argv[i] << "\n";
+                 return 1;
+             }
+             poolThreads = static_cast<std::size_t>(value);
+         } else if (arg == "--pin-threads") {
+             pinThreads = true;
+         } else if (arg == "--batch") {
+             batchScript = argv[++i];
+             batchMode = true;
+         } else if (arg == "--serve") {
+             char* end = nullptr;
+             servePort = std::strtol(argv[++i], &end, 10);
+             if (*end != '\0' || servePort < 0 || servePort > 65535) {
+                 std::cerr << "Invalid port: " << argv[i] << "\n";
+                 return 1;
+             }
+         } else if (arg == "--socket") {
+             socketPath = argv[++i];
+         } else if (arg == "--record") {
+             tracePath = argv[++i];
+         } else if (arg == "--trace-events") {
+             traceEventsPath = argv[++i];
+         } else if (arg == "--metrics-port") {
+             char* end = nullptr;
+             metricsPort = std::strtol(argv[++i], &end, 10);
+             if (*end != '\0' || metricsPort < 0 || metricsPort > 65535) {
+                 std::cerr << "Invalid port: " << argv[i] << "\n";
+                 return 1;
+             }
+         } else if (arg == "--metrics-file") {
+             metricsFile = argv[++i];
+         } else if (arg == "--metrics-interval") {
+             char* end = nullptr;
+             metricsInterval = std::strtol(argv[++i], &end, 10);
+             if (*end != '\0' || metricsInterval < 1) {
+                 std::cerr << "Invalid metrics interval: " << argv[i] << "\n";
+                 return 1;
+             }
+         } else if (arg == "--slow-log") {
+             slowLogPath = argv[++i];
+         } else if (arg == "--slow-ms") {
+             char* end = nullptr;
+             slowMs = std::strtod(argv[++i], &end);
+             if (*end != '\0' || !(slowMs > 0)) {
+                 std::cerr << "Invalid slow-operation threshold: " << argv[i] << "\n";
+                 return 1;
+             }
+         } else if (arg == "--export") {
+             exportFormat = argv[++i];
+         } else if (arg == "--title" || arg == "--author") {
+             exportField = arg;
+             exportText = argv[++i];
+         } else if (arg == "--help" || arg == "-h") {
+             printUsage(argv[0]);
+             return 0;
+         } else {
+             std::cerr << "Unknown option: " << arg << "\n";
+             printUsage(argv[0]);
+             return 1;
+         }
+     }
+     
+     Export::Format format = Export::Format::Csv;
+     if (!exportFormat.empty() && !Export::parseFormat(exportFormat, format)) {
+         std::cerr << "Unknown export format: " << exportFormat << " (expected csv, jsonl or json)\n";
+         return 1;
+     }
+     if (!exportField.empty() && exportFormat.empty()) {
+         std::cerr << exportField << " requires --export\n";
+         return 1;
+     }
+     
+     // Size the shared pool before anything creates it; the library loads on it
+     ThreadPool::configureShared(poolThreads, pinThreads);
+     
+     // Start profiling before the data file is loaded, so startup is covered
+     if (!(traceEventsPath.empty() ? TraceEvents::startFromEnvironment() : TraceEvents::start(traceEventsPath))) {
+         return 1;
+     }
+     if (!slowLogPath.empty() && !SlowLog::start(slowLogPath, slowMs)) {
+         return 1;
+     }
+     
      // Initialize the Library object with the path to the JSON data file
      // This will load any existing books from the file
-     Library library("data/books.json");
+     Library library(dataFile, shards);
+     
+     // Record the calls of this session for later replay
+     if (!tracePath.empty()) {
+         auto recorder = std::make_shared<Trace::Recorder>(tracePath);
+         if (!recorder->valid()) {
+             return 1;
+         }
+         library.setRecorder(std::move(recorder));
+     }
+     
+     // Publish metrics; the exporter is destroyed before the library it reads
+     MetricsExporter exporter;
+     if (metricsPort >= 0 || !metricsFile.empty()) {
+         Metrics::Registry& registry = Metrics::registry();
+         registry.gaugeFunction("library_books", "Books in the library", [&library] {
+             return static_cast<double>(library.snapshot().size());
+         });
+         registry.gaugeFunction("library_books_borrowed", "Books currently borrowed", [&library] {
+             return static_cast<double>(library.borrowedCount());
+         });
+         registry.gaugeFunction("library_index_chunks", "Chunks of the copy-on-write catalog, over all shards",
+                                [&library] {
+             Snapshot snapshot = library.snapshot();
+             std::size_t chunks = 0;
+             for (std::size_t i = 0; i < snapshot.shardCount(); ++i) {
+                 chunks += snapshot.shard(i).chunkCount();
+             }
+             return static_cast<double>(chunks);
+         });
+         registry.gaugeFunction("library_shards", "Shards the collection is split into", [&library] {
+             return static_cast<double>(library.shardCount());
+         });
+         registry.gaugeFunction("library_pool_workers", "Worker threads of the shared pool", [] {
+             return static_cast<double>(ThreadPool::shared().stats().workers);
+         });
+         registry.gaugeFunction("library_pool_busy_workers", "Shared pool workers running a task", [] {
+             return static_cast<double>(ThreadPool::shared().stats().busyWorkers);
+         });
+         registry.gaugeFunction("library_pool_queued_tasks", "Tasks waiting in the shared pool", [] {
+             return static_cast<double>(ThreadPool::shared().stats().queuedTasks);
+         });
+         registry.gaugeFunction("library_pool_tasks_executed", "Tasks the shared pool has finished", [] {
+             return static_cast<double>(ThreadPool::shared().stats().executed);
+         });
+         registry.gaugeFunction("library_pool_steals", "Tasks taken from another worker's deque", [] {
+             return static_cast<double>(ThreadPool::shared().stats().steals);
+         });
+         
+         if (metricsPort >= 0) {
+             if (!exporter.serve(static_cast<std::uint16_t>(metricsPort))) {
+                 return 1;
+             }
+             std::cerr << "Serving metrics on http://127.0.0.1:" << exporter.port() << "/metrics" << std::endl;
+         }
+         if (!metricsFile.empty() && !exporter.dumpEvery(metricsFile, std::chrono::seconds(metricsInterval))) {
+             return 1;
+         }
+     }
+     
+     if (servePort >= 0 || !socketPath.empty()) {
+         return runServer(library, servePort, socketPath);
+     }
+     
+     if (!exportFormat.empty()) {
+         std::ios::sync_with_stdio(false);
+         
+         std::function<bool(const Book&)> matches;
+         if (exportField == "--title") {
+             matches = [&exportText](const Book& book) { return book.getTitle().find(exportText) != std::string::npos; };
+         } else if (exportField == "--author") {
+             matches = [&exportText](const Book& book) { return book.getAuthor().find(exportText) != std::string::npos; };
+         }
+         Export::write(library.snapshot(), std::cout, format, matches);
+         return std::cout ? 0 : 1;
+     }
+     
+     if (batchMode) {
+         // Results can run to millions of lines, so detach from C stdio
+         std::ios::sync_with_stdio(false);
+         
+         if (batchScript == "-") {
+             return Batch::run(library, std::cin, std::cout) ? 0 : 1;
+         }
+         
+         std::ifstream script(batchScript);
+         if (!script) {
+             std::cerr << "Cannot open batch script: " << batchScript << "\n";
+             return 1;
+         }
+         return Batch::run(library, script, std::cout) ? 0 : 1;
+     }
      
      // Variable to store the user's menu choice
      int choice;
@@ -67,13 +410,27 @@
                  Display::returnBookMenu(library);
                  break;
              case 5:
-                 // Display all books in the library
-                 library.displayAllBooks();
+                 // Page through all books in the library
+                 if (!Display::browseBooks(library)) {
+                     std::cout << "No books in the library.\n";
+                 }
                  break;
              case 6:
                  // Remove a book from the library
                  Display::removeBookMenu(library);
                  break;
+             case 7:
+                 // Search titles and authors while typing
+                 Display::liveSearchMenu(library);
+                 break;
+             case 8:
+                 // Show latency percentiles per operation
+                 Display::showStatistics();
+                 break;
+             case 9:
+                 // Show memory held per subsystem
+                 Display::showMemoryUsage();
+                 break;
              case 0:
                  // Exit the program
                  std::cout << "Exiting. Goodbye!\n";
@@ -0,0 +1,157 @@
+/**
+ * @file BinaryClient.hpp
+ * @brief Header file declaring the client of the binary protocol
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the declaration of the BinaryClient class, a small
+ * blocking client for the BinaryServer. It offers one-call-per-operation
+ * convenience methods as well as the queue/flush/receive primitives needed
+ * to pipeline many requests over one connection.
+ */
+
+ #ifndef BINARY_CLIENT_HPP
+ #define BINARY_CLIENT_HPP
+
+ #include <cstdint>
+ #include <optional>
+ #include <string>
+ #include <vector>
+ #include "BinaryProtocol.hpp"
+
+ /**
+  * @class BinaryClient
+  * @brief Blocking client connection to a BinaryServer
+  *
+  * A client is not thread-safe; use one per thread.
+  */
+ class BinaryClient {
+ public:
+     BinaryClient() = default;
+
+     /**
+      * @brief Closes the connection
+      */
+     ~BinaryClient();
+
+     BinaryClient(const BinaryClient&) = delete;
+     BinaryClient& operator=(const BinaryClient&) = delete;
+
+     /**
+      * @brief Connects to a server
+      *
+      * @param path File system path of the server's socket
+      * @return true if connected, false otherwise (reported to stderr)
+      */
+     bool connect(const std::string& path);
+
+     /**
+      * @brief Closes the connection
+      */
+     void close();
+
+     // Pipelining primitives
+
+     /**
+      * @brief Appends a request to the send buffer without sending it
+      * @param request The request; its tag is echoed in the response
+      */
+     void queue(const BinaryProtocol::Request& request);
+
+     /**
+      * @brief Sends every queued request
+      *
+      * Receive responses before more than a few hundred requests are
+      * outstanding: the server stops reading a connection whose pipeline
+      * is full, and a blocked send would then wait forever.
+      *
+      * @return false if the connection failed
+      */
+     bool flush();
+
+     /**
+      * @brief Waits for the next response (responses arrive in request order)
+      *
+      * @param response Receives the response
+      * @return false if the connection failed or the response was malformed
+      */
+     bool receive(BinaryProtocol::Response& response);
+
+     // One round trip per call
+
+     /**
+      * @brief Finds a book by its ID
+      * @param id Unique identifier of the book
+      * @return The book, or std::nullopt if not found or on failure
+      */
+     std::optional<Book> findBookById(int id);
+
+     /**
+      * @brief Finds books whose titles contain a string
+      * @param title String to search for
+      * @return Matching books in ID order
+      */
+     std::vector<Book> findBooksByTitle(const std::string& title);
+
+     /**
+      * @brief Finds books whose authors contain a string
+      * @param author String to search for
+      * @return Matching books in ID order
+      */
+     std::vector<Book> findBooksByAuthor(const std::string& author);
+
+     /**
+      * @brief Adds a book
+      *
+      * @param title Title of the book
+      * @param author Author of the book
+      * @param year Publication year of the book
+      * @return Status of the request
+      */
+     BinaryProtocol::Status addBook(const std::string& title, const std::string& author, int year);
+
+     /**
+      * @brief Removes a book
+      * @param id Unique identifier of the book
+      * @return Status of the request
+      */
+     BinaryProtocol::Status removeBook(int id);
+
+     /**
+      * @brief Borrows a book
+      * @param id Unique identifier of the book
+      * @return Status of the request (Conflict if already borrowed)
+      */
+     BinaryProtocol::Status borrowBook(int id);
+
+     /**
+      * @brief Returns a book
+      * @param id Unique identifier of the book
+      * @return Status of the request (Conflict if not borrowed)
+      */
+     BinaryProtocol::Status returnBook(int id);
+
+     /**
+      * @brief Edits a book if its version still matches
+      *
+      * @param id Unique identifier of the book
+      * @param expectedVersion Version the caller read
+      * @param title New title
+      * @param author New author
+      * @param year New publication year
+      * @return Status of the request (Conflict if the version is stale)
+      */
+     BinaryProtocol::Status updateBook(int id, std::uint64_t expectedVersion,
+                                       const std::string& title, const std::string& author, int year);
+
+ private:
+     int fd = -1;
+     std::uint32_t nextTag = 1;
+     std::string sendBuffer;
+     std::string receiveBuffer;
+     std::size_t receiveOffset = 0;
+
+     BinaryProtocol::Response roundTrip(BinaryProtocol::Request request);
+ };
+
+ #endif // BINARY_CLIENT_HPP
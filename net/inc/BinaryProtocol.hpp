@@ -0,0 +1,144 @@
+/**
+ * @file BinaryProtocol.hpp
+ * @brief Header file defining the length-prefixed binary request protocol
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the message types of the binary protocol served over
+ * a Unix domain socket and the functions that encode and decode them. It
+ * is shared by BinaryServer and BinaryClient.
+ *
+ * Every message is a frame: a 4-byte payload length followed by the
+ * payload. All integers are little-endian; strings are a 4-byte length
+ * followed by UTF-8 bytes.
+ *
+ *     request  = u8 op, u32 tag, fields of the op
+ *     response = u32 tag, u8 status, u32 book count, books
+ *     book     = i32 id, string title, string author, i32 year,
+ *                u8 available, u64 version
+ *
+ * Request fields by op: FindById/Remove/Borrow/Return: i32 id;
+ * FindByTitle/FindByAuthor: string text; Add: string title, string author,
+ * i32 year; Update: i32 id, u64 version, string title, string author,
+ * i32 year. The tag is chosen by the client and echoed in the response.
+ */
+
+ #ifndef BINARY_PROTOCOL_HPP
+ #define BINARY_PROTOCOL_HPP
+
+ #include <cstddef>
+ #include <cstdint>
+ #include <string>
+ #include <string_view>
+ #include <vector>
+ #include "models.hpp"
+
+ /**
+  * @namespace BinaryProtocol
+  * @brief Message types and codec of the binary request protocol
+  */
+ namespace BinaryProtocol {
+     /// @brief Size of the length prefix of every frame
+     constexpr std::size_t kFrameHeaderSize = 4;
+
+     /// @brief Largest accepted payload
+     constexpr std::uint32_t kMaxPayloadSize = 16 * 1024 * 1024;
+
+     /**
+      * @enum Op
+      * @brief Library operation requested by a client
+      */
+     enum class Op : std::uint8_t {
+         FindById = 1,
+         FindByTitle = 2,
+         FindByAuthor = 3,
+         Add = 4,
+         Remove = 5,
+         Borrow = 6,
+         Return = 7,
+         Update = 8
+     };
+
+     /**
+      * @enum Status
+      * @brief Outcome of a request
+      */
+     enum class Status : std::uint8_t {
+         Ok = 0,          ///< The operation succeeded
+         NotFound = 1,    ///< No book has the given ID
+         Conflict = 2,    ///< Wrong availability, or stale version for Update
+         BadRequest = 3,  ///< The request could not be decoded
+         Failed = 4       ///< The operation failed for another reason
+     };
+
+     /**
+      * @struct Request
+      * @brief A decoded request; only the fields used by op are meaningful
+      */
+     struct Request {
+         Op op = Op::FindById;
+         std::uint32_t tag = 0;
+         int id = 0;
+         std::uint64_t version = 0;
+         int year = 0;
+         std::string title;   ///< Title for Add/Update, search text for FindByTitle/FindByAuthor
+         std::string author;
+     };
+
+     /**
+      * @struct Response
+      * @brief A decoded response
+      */
+     struct Response {
+         std::uint32_t tag = 0;
+         Status status = Status::Ok;
+         std::vector<Book> books;
+     };
+
+     /**
+      * @brief Appends an encoded request frame to a buffer
+      *
+      * @param request The request to encode
+      * @param out Buffer the frame is appended to
+      */
+     void encodeRequest(const Request& request, std::string& out);
+
+     /**
+      * @brief Appends an encoded response frame to a buffer
+      *
+      * @param tag Tag of the request being answered
+      * @param status Outcome of the request
+      * @param books Books to return (may be empty)
+      * @param out Buffer the frame is appended to
+      */
+     void encodeResponse(std::uint32_t tag, Status status, const std::vector<Book>& books, std::string& out);
+
+     /**
+      * @brief Checks whether a buffer starts with a complete frame
+      *
+      * @param data Buffered bytes
+      * @param payloadSize Receives the payload size once the header is available
+      * @return true if the whole frame is buffered
+      */
+     bool completeFrame(std::string_view data, std::uint32_t& payloadSize);
+
+     /**
+      * @brief Decodes a request payload
+      *
+      * @param payload The payload (without the length prefix)
+      * @param request Receives the request
+      * @return false if the payload is malformed
+      */
+     bool decodeRequest(std::string_view payload, Request& request);
+
+     /**
+      * @brief Decodes a response payload
+      *
+      * @param payload The payload (without the length prefix)
+      * @param response Receives the response
+      * @return false if the payload is malformed
+      */
+     bool decodeResponse(std::string_view payload, Response& response);
+ }
+
+ #endif // BINARY_PROTOCOL_HPP
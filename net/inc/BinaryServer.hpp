@@ -0,0 +1,67 @@
+/**
+ * @file BinaryServer.hpp
+ * @brief Header file declaring the binary protocol server
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the declaration of the BinaryServer class, which
+ * serves the Library operations over a Unix domain socket using the
+ * length-prefixed protocol of BinaryProtocol.hpp. It is meant for
+ * colocated services, for which HTTP parsing would cost more than the
+ * lookups themselves.
+ */
+
+ #ifndef BINARY_SERVER_HPP
+ #define BINARY_SERVER_HPP
+
+ #include <string>
+ #include "BinaryProtocol.hpp"
+ #include "Library.hpp"
+ #include "StreamServer.hpp"
+
+ /**
+  * @class BinaryServer
+  * @brief Unix domain socket server for the binary protocol
+  *
+  * Clients may pipeline requests; responses come back in request order,
+  * and all responses that are ready together are written with one send.
+  * Queries are answered inline on the loop thread; mutations use the
+  * Library's coroutine API, so saves never block the loop.
+  */
+ class BinaryServer : public StreamServer {
+ public:
+     /**
+      * @brief Creates a server on an event loop
+      *
+      * @param loop The loop that drives the server's sockets
+      * @param library The library to serve
+      */
+     BinaryServer(EventLoop& loop, Library& library);
+
+     /**
+      * @brief Removes the socket file
+      */
+     ~BinaryServer() override;
+
+     /**
+      * @brief Starts listening on a Unix domain socket
+      *
+      * A stale socket file left by an earlier run is replaced; any other
+      * existing file makes the call fail.
+      *
+      * @param path File system path of the socket
+      * @return true if the socket is listening, false otherwise
+      */
+     bool listen(const std::string& path);
+
+ protected:
+     bool parseOne(Connection& connection) override;
+
+ private:
+     Library& library;
+     std::string socketPath;
+
+     void execute(const BinaryProtocol::Request& request, Completion done);
+ };
+
+ #endif // BINARY_SERVER_HPP
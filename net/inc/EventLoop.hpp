@@ -0,0 +1,141 @@
+/**
+ * @file EventLoop.hpp
+ * @brief Header file declaring the epoll-based event loop
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the declaration of the EventLoop class, the reactor
+ * shared by the network front ends of the library management system. One
+ * thread runs the loop and dispatches readiness events on non-blocking
+ * file descriptors to their handlers; other threads hand work back to it
+ * with post().
+ */
+
+ #ifndef EVENT_LOOP_HPP
+ #define EVENT_LOOP_HPP
+
+ #include <atomic>
+ #include <cstdint>
+ #include <functional>
+ #include <memory>
+ #include <mutex>
+ #include <thread>
+ #include <unordered_map>
+ #include <vector>
+
+ /**
+  * @class EventLoop
+  * @brief Single-threaded epoll reactor with a cross-thread task queue
+  *
+  * Descriptors are registered level-triggered with the epoll event mask
+  * they are interested in (EPOLLIN, EPOLLOUT, ...). Everything except
+  * post() and stop() must be called on the loop thread.
+  */
+ class EventLoop {
+ public:
+     /// @brief Called with the ready event mask of a descriptor
+     using Handler = std::function<void(std::uint32_t events)>;
+
+     /**
+      * @brief Creates the epoll instance and the wake-up descriptor
+      *
+      * Failures are reported to stderr; valid() tells whether the loop
+      * can be used.
+      */
+     EventLoop();
+
+     /**
+      * @brief Closes the epoll instance (registered descriptors are not closed)
+      */
+     ~EventLoop();
+
+     EventLoop(const EventLoop&) = delete;
+     EventLoop& operator=(const EventLoop&) = delete;
+
+     /**
+      * @brief Checks whether the loop was created successfully
+      * @return true if the epoll and wake-up descriptors are open
+      */
+     bool valid() const;
+
+     /**
+      * @brief Starts watching a descriptor
+      *
+      * @param fd Non-blocking descriptor
+      * @param events Epoll event mask to watch
+      * @param handler Called on the loop thread when the descriptor is ready
+      * @return true if the descriptor was registered
+      */
+     bool add(int fd, std::uint32_t events, Handler handler);
+
+     /**
+      * @brief Changes the event mask of a registered descriptor
+      *
+      * @param fd Registered descriptor
+      * @param events New epoll event mask
+      */
+     void modify(int fd, std::uint32_t events);
+
+     /**
+      * @brief Stops watching a descriptor (the caller closes it)
+      * @param fd Registered descriptor
+      */
+     void remove(int fd);
+
+     /**
+      * @brief Queues a function to run on the loop thread
+      *
+      * Safe to call from any thread.
+      *
+      * @param task The function to run
+      */
+     void post(std::function<void()> task);
+
+     /**
+      * @brief Waits for events once and dispatches them, then runs posted tasks
+      *
+      * @param timeoutMs Maximum time to wait in milliseconds (-1 waits forever)
+      */
+     void runOnce(int timeoutMs);
+
+     /**
+      * @brief Dispatches events until stop() is called
+      */
+     void run();
+
+     /**
+      * @brief Makes run() return after the current iteration
+      *
+      * Safe to call from any thread and from a signal handler.
+      */
+     void stop();
+
+     /**
+      * @brief Checks whether stop() has been called
+      * @return true once the loop has been asked to stop
+      */
+     bool stopping() const;
+
+     /**
+      * @brief Checks whether the caller is the thread running the loop
+      * @return true on the loop thread
+      */
+     bool inLoopThread() const;
+
+ private:
+     int epollFd = -1;
+     int wakeFd = -1;
+     std::atomic<bool> stopRequested{false};
+     std::atomic<std::thread::id> loopThread{};
+
+     /// @brief Handlers by descriptor; shared so a handler may remove itself
+     std::unordered_map<int, std::shared_ptr<Handler>> handlers;
+
+     std::mutex postedMutex;
+     std::vector<std::function<void()>> posted;
+
+     void wake();
+     void runPosted();
+ };
+
+ #endif // EVENT_LOOP_HPP
@@ -0,0 +1,54 @@
+/**
+ * @file HttpApi.hpp
+ * @brief Header file declaring the JSON/HTTP interface to a Library
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the declaration of the HttpApi namespace, which maps
+ * HTTP requests received by an HttpServer onto Library operations.
+ */
+
+ #ifndef HTTP_API_HPP
+ #define HTTP_API_HPP
+
+ #include "HttpServer.hpp"
+ #include "Library.hpp"
+
+ /**
+  * @namespace HttpApi
+  * @brief REST routes of the library server
+  *
+  * All bodies are JSON. Books are represented as
+  * {"id", "title", "author", "year", "available", "version"}.
+  *
+  *     GET    /books                   {"books": [...], "next": <id>}: one page of
+  *                                     books in ID order (?limit=, default 100,
+  *                                     at most 1000; ?after=<next> for the next
+  *                                     page; "next" is absent on the last page),
+  *                                     optionally only matches of ?title= or
+  *                                     ?author=
+  *     GET    /books/{id}              one book, 404 if unknown
+  *     POST   /books                   add {"title", "author", "year"} -> 201,
+  *                                     400 if the year does not fit in an int
+  *     PUT    /books/{id}              edit {"version", "title", "author", "year"},
+  *                                     409 if the version is stale
+  *     DELETE /books/{id}              remove
+  *     POST   /books/{id}/borrow       borrow, 409 if already borrowed
+  *     POST   /books/{id}/return       return, 409 if not borrowed
+  *
+  * Queries are answered inline on the loop thread. Mutations use the
+  * Library's coroutine API, so the loop keeps serving other clients while
+  * the data file is written, and concurrent writes share one save.
+  */
+ namespace HttpApi {
+     /**
+      * @brief Handles one request against a library
+      *
+      * @param library The library to operate on
+      * @param request The parsed request
+      * @param respond Receives the response, possibly later and on another thread
+      */
+     void handle(Library& library, const HttpRequest& request, HttpServer::Responder respond);
+ }
+
+ #endif // HTTP_API_HPP
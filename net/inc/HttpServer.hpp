@@ -0,0 +1,104 @@
+/**
+ * @file HttpServer.hpp
+ * @brief Header file declaring the HTTP/1.1 server
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the declarations of the HttpRequest and HttpResponse
+ * types and of the HttpServer class, a small non-blocking HTTP/1.1 server
+ * running on an EventLoop. The server knows nothing about books; requests
+ * are passed to a handler (see HttpApi.hpp for the Library routes).
+ */
+
+ #ifndef HTTP_SERVER_HPP
+ #define HTTP_SERVER_HPP
+
+ #include <cstdint>
+ #include <functional>
+ #include <string>
+ #include <unordered_map>
+ #include "StreamServer.hpp"
+
+ /**
+  * @struct HttpRequest
+  * @brief A parsed HTTP request
+  */
+ struct HttpRequest {
+     std::string method;  /// @brief Request method, e.g. "GET"
+     std::string path;    /// @brief Target path without the query string
+     std::string query;   /// @brief Raw query string (without the '?')
+     std::unordered_map<std::string, std::string> headers;  /// @brief Headers, names lower-cased
+     std::string body;    /// @brief Request body
+
+     /**
+      * @brief Gets a decoded query string parameter
+      *
+      * @param name Parameter name
+      * @param value Receives the decoded value
+      * @return true if the parameter is present
+      */
+     bool queryParam(const std::string& name, std::string& value) const;
+ };
+
+ /**
+  * @struct HttpResponse
+  * @brief A response to be sent to the client
+  */
+ struct HttpResponse {
+     int status = 200;                              /// @brief Status code
+     std::string contentType = "application/json";  /// @brief Content-Type header
+     std::string body;                              /// @brief Response body
+ };
+
+ /**
+  * @class HttpServer
+  * @brief Non-blocking HTTP/1.1 server with keep-alive and pipelining
+  *
+  * The server listens on the loopback interface only. Every complete request
+  * is handed to the handler together with a Responder; the handler may
+  * respond immediately or later from any thread (for example after an
+  * asynchronous save), and pipelined responses are still sent in request
+  * order (see StreamServer).
+  */
+ class HttpServer : public StreamServer {
+ public:
+     /// @brief Sends the response to one request; call exactly once, from any thread
+     using Responder = std::function<void(HttpResponse)>;
+
+     /// @brief Handles one request
+     using Handler = std::function<void(const HttpRequest&, Responder)>;
+
+     /**
+      * @brief Creates a server on an event loop
+      *
+      * @param loop The loop that drives the server's sockets
+      * @param handler Called for every request
+      */
+     HttpServer(EventLoop& loop, Handler handler);
+
+     /**
+      * @brief Starts listening on 127.0.0.1
+      *
+      * @param port TCP port; 0 picks a free port (see port())
+      * @return true if the socket is listening, false otherwise
+      */
+     bool listen(std::uint16_t port);
+
+     /**
+      * @brief Gets the port the server listens on
+      * @return The bound port, or 0 if not listening
+      */
+     std::uint16_t port() const;
+
+ protected:
+     bool parseOne(Connection& connection) override;
+     void configureClient(int fd) override;
+
+ private:
+     Handler handler;
+     std::uint16_t boundPort = 0;
+
+     void respondError(Connection& connection, int status, const std::string& message);
+ };
+
+ #endif // HTTP_SERVER_HPP
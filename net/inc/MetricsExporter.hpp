@@ -0,0 +1,86 @@
+/**
+ * @file MetricsExporter.hpp
+ * @brief Header file declaring the metrics exporter
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the declaration of the MetricsExporter class, which
+ * publishes the Metrics registry in Prometheus text format, either served
+ * over HTTP for a scraper or written to a file for the node_exporter
+ * textfile collector.
+ */
+
+ #ifndef METRICS_EXPORTER_HPP
+ #define METRICS_EXPORTER_HPP
+
+ #include <chrono>
+ #include <condition_variable>
+ #include <cstdint>
+ #include <memory>
+ #include <mutex>
+ #include <string>
+ #include <thread>
+ #include "EventLoop.hpp"
+ #include "HttpServer.hpp"
+
+ /**
+  * @class MetricsExporter
+  * @brief Serves and/or periodically writes the metrics exposition
+  *
+  * Both outputs run on threads of their own, so they work in every mode of
+  * the program (menu, batch, server) without touching its event loop. The
+  * exposition is rendered on demand; nothing is computed between scrapes.
+  */
+ class MetricsExporter {
+ public:
+     MetricsExporter() = default;
+
+     /**
+      * @brief Stops serving and writing; the file gets one final dump
+      */
+     ~MetricsExporter();
+
+     MetricsExporter(const MetricsExporter&) = delete;
+     MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+     /**
+      * @brief Serves GET /metrics on 127.0.0.1
+      *
+      * @param port TCP port; 0 picks a free port (see port())
+      * @return false if the server could not start (reported to stderr)
+      */
+     bool serve(std::uint16_t port);
+
+     /**
+      * @brief Gets the port /metrics is served on
+      * @return The bound port, or 0 if not serving
+      */
+     std::uint16_t port() const;
+
+     /**
+      * @brief Writes the exposition to a file now and then every interval
+      *
+      * Each dump goes to "<path>.tmp" first and is renamed over the file,
+      * so readers never see a partial exposition.
+      *
+      * @param path File to write
+      * @param interval Time between dumps
+      * @return false if the first dump failed (reported to stderr)
+      */
+     bool dumpEvery(const std::string& path, std::chrono::seconds interval);
+
+ private:
+     std::unique_ptr<EventLoop> loop;
+     std::unique_ptr<HttpServer> http;
+     std::thread serverThread;
+
+     std::string dumpPath;
+     std::mutex dumpMutex;
+     std::condition_variable dumpWake;
+     bool stopping = false;
+     std::thread dumpThread;
+
+     bool dump() const;
+ };
+
+ #endif // METRICS_EXPORTER_HPP
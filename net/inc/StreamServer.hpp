@@ -0,0 +1,178 @@
+/**
+ * @file StreamServer.hpp
+ * @brief Header file declaring the base class of the stream socket servers
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the declaration of the StreamServer class, which owns
+ * the connection handling shared by the HTTP and binary protocol servers:
+ * accepting clients, buffering, in-order delivery of pipelined responses
+ * and back-pressure. Derived classes only parse requests and produce
+ * response bytes.
+ */
+
+ #ifndef STREAM_SERVER_HPP
+ #define STREAM_SERVER_HPP
+
+ #include <cstddef>
+ #include <cstdint>
+ #include <deque>
+ #include <functional>
+ #include <memory>
+ #include <string>
+ #include <string_view>
+ #include <unordered_map>
+ #include "EventLoop.hpp"
+
+ /**
+  * @class StreamServer
+  * @brief Non-blocking server for request/response protocols over stream sockets
+  *
+  * Every request parsed by the derived class reserves a slot in its
+  * connection's response order. The slot is completed through a callback
+  * that may run on any thread; responses are still sent in request order,
+  * and all responses that are ready when the socket is written go out in
+  * a single send. Everything except those callbacks runs on the loop thread.
+  */
+ class StreamServer {
+ public:
+     /// @brief Completes a request slot with the serialized response; call exactly once, from any thread
+     using Completion = std::function<void(std::string bytes, bool closeAfter)>;
+
+     StreamServer(const StreamServer&) = delete;
+     StreamServer& operator=(const StreamServer&) = delete;
+
+     /**
+      * @brief Closes the listening socket and every connection
+      *
+      * Call shutdown() first if requests may still be in flight.
+      */
+     virtual ~StreamServer();
+
+     /**
+      * @brief Stops accepting, waits for in-flight requests and closes all connections
+      *
+      * Must be called on the loop thread (after EventLoop::run() returned);
+      * it keeps running the loop until every Completion has been called.
+      */
+     void shutdown();
+
+ protected:
+     /**
+      * @struct Slot
+      * @brief Place of one pipelined request in its connection's response order
+      */
+     struct Slot {
+         bool ready = false;        /// @brief The response has been produced
+         std::string bytes;         /// @brief Serialized response
+         bool close = false;        /// @brief Close the connection after this response
+     };
+
+     /**
+      * @struct Connection
+      * @brief Buffers and state of one client connection
+      */
+     struct Connection {
+         int fd = -1;
+         std::uint64_t id = 0;
+         std::string in;                    /// @brief Received bytes
+         std::size_t inOffset = 0;          /// @brief Bytes of in already parsed
+         std::string out;                   /// @brief Serialized responses not yet sent
+         std::size_t outOffset = 0;         /// @brief Bytes of out already sent
+         std::deque<Slot> slots;            /// @brief Outstanding requests in arrival order
+         std::uint64_t firstSlot = 0;       /// @brief Sequence number of slots.front()
+         std::uint32_t interest = 0;        /// @brief Event mask currently registered
+         bool peerClosed = false;           /// @brief The client shut down its side
+         bool closing = false;              /// @brief No more requests will be read
+         bool processing = false;           /// @brief Guards process() against re-entry
+
+         /**
+          * @brief Gets the received bytes that have not been parsed yet
+          * @return View of the unparsed input
+          */
+         std::string_view input() const {
+             return std::string_view(in).substr(inOffset);
+         }
+
+         /**
+          * @brief Marks bytes at the head of the unparsed input as parsed
+          * @param count Number of bytes consumed
+          */
+         void consume(std::size_t count) {
+             inOffset += count;
+         }
+     };
+
+     /**
+      * @brief Creates a server on an event loop
+      *
+      * @param loop The loop that drives the server's sockets
+      * @param maxPipelined Requests per connection that may await their response at once
+      */
+     StreamServer(EventLoop& loop, std::size_t maxPipelined);
+
+     /**
+      * @brief Starts accepting clients on a listening socket
+      *
+      * @param fd Non-blocking listening socket; the server takes ownership
+      * @return true if the socket was registered with the loop
+      */
+     bool startListening(int fd);
+
+     /**
+      * @brief Parses at most one request from the head of the unparsed input
+      *
+      * Only called while the connection accepts requests and has room in
+      * its pipeline. Implementations consume() the request's bytes and call
+      * reserveSlot() for it, or queueFinal() to reject the input.
+      *
+      * @param connection The connection whose input to parse
+      * @return true if a request was consumed, false if more input is needed
+      *         or the connection must not accept further requests
+      */
+     virtual bool parseOne(Connection& connection) = 0;
+
+     /**
+      * @brief Applies socket options to a newly accepted client
+      * @param fd The client socket
+      */
+     virtual void configureClient(int fd);
+
+     /**
+      * @brief Reserves the response slot of a parsed request
+      *
+      * @param connection The connection the request arrived on
+      * @return Callback that completes the slot
+      */
+     Completion reserveSlot(Connection& connection);
+
+     /**
+      * @brief Queues a final response produced by the server itself
+      *
+      * Used to reject malformed input: nothing more is read from the
+      * connection, which is closed once the response has been sent.
+      *
+      * @param connection The connection to answer
+      * @param bytes Serialized response
+      */
+     void queueFinal(Connection& connection, std::string bytes);
+
+     /// @brief The loop driving the sockets
+     EventLoop& loop;
+
+ private:
+     std::size_t maxPipelined;
+     int listenFd = -1;
+     std::uint64_t nextConnectionId = 1;
+     std::size_t inFlight = 0;
+     std::unordered_map<std::uint64_t, std::unique_ptr<Connection>> connections;
+
+     void acceptClients();
+     void onEvent(std::uint64_t id, std::uint32_t events);
+     bool readAvailable(Connection& connection);
+     void complete(std::uint64_t id, std::uint64_t sequence, std::string bytes, bool closeAfter);
+     void process(Connection& connection);
+     void closeConnection(Connection& connection);
+ };
+
+ #endif // STREAM_SERVER_HPP
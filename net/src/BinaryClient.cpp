@@ -0,0 +1,268 @@
+/**
+ * @file BinaryClient.cpp
+ * @brief Implementation of the client of the binary protocol
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements the BinaryClient class declared in BinaryClient.hpp
+ * on top of a blocking Unix domain socket.
+ */
+
+ #include "BinaryClient.hpp"
+ #include <cerrno>
+ #include <cstring>
+ #include <iostream>
+ #include <sys/socket.h>
+ #include <sys/un.h>
+ #include <unistd.h>
+
+ using BinaryProtocol::Op;
+ using BinaryProtocol::Request;
+ using BinaryProtocol::Response;
+ using BinaryProtocol::Status;
+
+ /**
+  * @brief Destructor implementation
+  */
+ BinaryClient::~BinaryClient() {
+     close();
+ }
+
+ /**
+  * @brief Implementation of the connect method
+  *
+  * @param path File system path of the server's socket
+  * @return true if connected, false otherwise
+  */
+ bool BinaryClient::connect(const std::string& path) {
+     close();
+
+     sockaddr_un address{};
+     if (path.size() >= sizeof(address.sun_path)) {
+         std::cerr << "Socket path too long: " << path << std::endl;
+         return false;
+     }
+     address.sun_family = AF_UNIX;
+     std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+     fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+     if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+         std::cerr << "Error connecting to " << path << ": " << std::strerror(errno) << std::endl;
+         close();
+         return false;
+     }
+     return true;
+ }
+
+ /**
+  * @brief Implementation of the close method
+  */
+ void BinaryClient::close() {
+     if (fd >= 0) {
+         ::close(fd);
+         fd = -1;
+     }
+     sendBuffer.clear();
+     receiveBuffer.clear();
+     receiveOffset = 0;
+ }
+
+ /**
+  * @brief Implementation of the queue method
+  * @param request The request
+  */
+ void BinaryClient::queue(const Request& request) {
+     BinaryProtocol::encodeRequest(request, sendBuffer);
+ }
+
+ /**
+  * @brief Implementation of the flush method
+  * @return false if the connection failed
+  */
+ bool BinaryClient::flush() {
+     std::size_t offset = 0;
+     while (offset < sendBuffer.size()) {
+         ssize_t sent = send(fd, sendBuffer.data() + offset, sendBuffer.size() - offset, MSG_NOSIGNAL);
+         if (sent < 0 && errno == EINTR) {
+             continue;
+         }
+         if (sent <= 0) {
+             return false;
+         }
+         offset += static_cast<std::size_t>(sent);
+     }
+     sendBuffer.clear();
+     return true;
+ }
+
+ /**
+  * @brief Implementation of the receive method
+  *
+  * Reads in large pieces and decodes one frame at a time from the buffer,
+  * so a batch of pipelined responses costs few system calls.
+  *
+  * @param response Receives the response
+  * @return false if the connection failed or the response was malformed
+  */
+ bool BinaryClient::receive(Response& response) {
+     for (;;) {
+         std::string_view buffered = std::string_view(receiveBuffer).substr(receiveOffset);
+         std::uint32_t payloadSize = 0;
+         if (BinaryProtocol::completeFrame(buffered, payloadSize)) {
+             bool valid = BinaryProtocol::decodeResponse(
+                 buffered.substr(BinaryProtocol::kFrameHeaderSize, payloadSize), response);
+             receiveOffset += BinaryProtocol::kFrameHeaderSize + payloadSize;
+             return valid;
+         }
+         if (payloadSize > BinaryProtocol::kMaxPayloadSize) {
+             return false;
+         }
+
+         // Drop consumed bytes before reading more
+         receiveBuffer.erase(0, receiveOffset);
+         receiveOffset = 0;
+
+         char chunk[65536];
+         ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+         if (received < 0 && errno == EINTR) {
+             continue;
+         }
+         if (received <= 0) {
+             return false;
+         }
+         receiveBuffer.append(chunk, static_cast<std::size_t>(received));
+     }
+ }
+
+ /**
+  * @brief Implementation of the roundTrip method
+  *
+  * @param request The request (its tag is assigned here)
+  * @return The response; status Failed if the connection broke
+  */
+ Response BinaryClient::roundTrip(Request request) {
+     request.tag = nextTag++;
+     queue(request);
+
+     Response response;
+     if (!flush() || !receive(response)) {
+         response.status = Status::Failed;
+         response.books.clear();
+     }
+     return response;
+ }
+
+ /**
+  * @brief Implementation of the findBookById method
+  * @param id Unique identifier of the book
+  * @return The book, or std::nullopt
+  */
+ std::optional<Book> BinaryClient::findBookById(int id) {
+     Request request;
+     request.op = Op::FindById;
+     request.id = id;
+     Response response = roundTrip(std::move(request));
+     if (response.status != Status::Ok || response.books.empty()) {
+         return std::nullopt;
+     }
+     return std::move(response.books.front());
+ }
+
+ /**
+  * @brief Implementation of the findBooksByTitle method
+  * @param title String to search for
+  * @return Matching books
+  */
+ std::vector<Book> BinaryClient::findBooksByTitle(const std::string& title) {
+     Request request;
+     request.op = Op::FindByTitle;
+     request.title = title;
+     return roundTrip(std::move(request)).books;
+ }
+
+ /**
+  * @brief Implementation of the findBooksByAuthor method
+  * @param author String to search for
+  * @return Matching books
+  */
+ std::vector<Book> BinaryClient::findBooksByAuthor(const std::string& author) {
+     Request request;
+     request.op = Op::FindByAuthor;
+     request.title = author;
+     return roundTrip(std::move(request)).books;
+ }
+
+ /**
+  * @brief Implementation of the addBook method
+  *
+  * @param title Title of the book
+  * @param author Author of the book
+  * @param year Publication year of the book
+  * @return Status of the request
+  */
+ Status BinaryClient::addBook(const std::string& title, const std::string& author, int year) {
+     Request request;
+     request.op = Op::Add;
+     request.title = title;
+     request.author = author;
+     request.year = year;
+     return roundTrip(std::move(request)).status;
+ }
+
+ /**
+  * @brief Implementation of the removeBook method
+  * @param id Unique identifier of the book
+  * @return Status of the request
+  */
+ Status BinaryClient::removeBook(int id) {
+     Request request;
+     request.op = Op::Remove;
+     request.id = id;
+     return roundTrip(std::move(request)).status;
+ }
+
+ /**
+  * @brief Implementation of the borrowBook method
+  * @param id Unique identifier of the book
+  * @return Status of the request
+  */
+ Status BinaryClient::borrowBook(int id) {
+     Request request;
+     request.op = Op::Borrow;
+     request.id = id;
+     return roundTrip(std::move(request)).status;
+ }
+
+ /**
+  * @brief Implementation of the returnBook method
+  * @param id Unique identifier of the book
+  * @return Status of the request
+  */
+ Status BinaryClient::returnBook(int id) {
+     Request request;
+     request.op = Op::Return;
+     request.id = id;
+     return roundTrip(std::move(request)).status;
+ }
+
+ /**
+  * @brief Implementation of the updateBook method
+  *
+  * @param id Unique identifier of the book
+  * @param expectedVersion Version the caller read
+  * @param title New title
+  * @param author New author
+  * @param year New publication year
+  * @return Status of the request
+  */
+ Status BinaryClient::updateBook(int id, std::uint64_t expectedVersion,
+                                 const std::string& title, const std::string& author, int year) {
+     Request request;
+     request.op = Op::Update;
+     request.id = id;
+     request.version = expectedVersion;
+     request.title = title;
+     request.author = author;
+     request.year = year;
+     return roundTrip(std::move(request)).status;
+ }
@@ -0,0 +1,269 @@
+/**
+ * @file BinaryProtocol.cpp
+ * @brief Implementation of the binary request protocol codec
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements the encode and decode functions declared in
+ * BinaryProtocol.hpp. Decoding is bounds-checked throughout, so a
+ * malformed frame is rejected instead of read past its end.
+ */
+
+ #include "BinaryProtocol.hpp"
+
+ namespace {
+
+ /**
+  * @brief Appends an unsigned integer in little-endian byte order
+  *
+  * @param out Buffer to append to
+  * @param value The value
+  */
+ template <typename Unsigned>
+ void put(std::string& out, Unsigned value) {
+     for (std::size_t i = 0; i < sizeof(Unsigned); ++i) {
+         out += static_cast<char>((value >> (8 * i)) & 0xFF);
+     }
+ }
+
+ /**
+  * @brief Appends a length-prefixed string
+  *
+  * @param out Buffer to append to
+  * @param text The string
+  */
+ void putString(std::string& out, const std::string& text) {
+     put(out, static_cast<std::uint32_t>(text.size()));
+     out += text;
+ }
+
+ /**
+  * @brief Reserves the length prefix of a frame
+  *
+  * @param out Buffer the frame is appended to
+  * @return Offset of the prefix, for finishFrame()
+  */
+ std::size_t beginFrame(std::string& out) {
+     std::size_t start = out.size();
+     put(out, std::uint32_t{0});
+     return start;
+ }
+
+ /**
+  * @brief Fills in the length prefix once the payload has been appended
+  *
+  * @param out Buffer the frame was appended to
+  * @param start Offset returned by beginFrame()
+  */
+ void finishFrame(std::string& out, std::size_t start) {
+     std::uint32_t size = static_cast<std::uint32_t>(out.size() - start - BinaryProtocol::kFrameHeaderSize);
+     for (std::size_t i = 0; i < 4; ++i) {
+         out[start + i] = static_cast<char>((size >> (8 * i)) & 0xFF);
+     }
+ }
+
+ /**
+  * @class Reader
+  * @brief Bounds-checked cursor over a payload
+  */
+ class Reader {
+ public:
+     explicit Reader(std::string_view data) : data(data) {}
+
+     template <typename Unsigned>
+     bool get(Unsigned& value) {
+         if (data.size() - position < sizeof(Unsigned)) {
+             return false;
+         }
+         value = 0;
+         for (std::size_t i = 0; i < sizeof(Unsigned); ++i) {
+             value |= static_cast<Unsigned>(static_cast<unsigned char>(data[position + i])) << (8 * i);
+         }
+         position += sizeof(Unsigned);
+         return true;
+     }
+
+     bool getInt(int& value) {
+         std::uint32_t raw;
+         if (!get(raw)) {
+             return false;
+         }
+         value = static_cast<int>(raw);
+         return true;
+     }
+
+     bool getString(std::string& text) {
+         std::uint32_t size;
+         if (!get(size) || data.size() - position < size) {
+             return false;
+         }
+         text.assign(data.substr(position, size));
+         position += size;
+         return true;
+     }
+
+     bool atEnd() const {
+         return position == data.size();
+     }
+
+ private:
+     std::string_view data;
+     std::size_t position = 0;
+ };
+
+ } // namespace
+
+ namespace BinaryProtocol {
+
+ /**
+  * @brief Implementation of the encodeRequest function
+  *
+  * @param request The request to encode
+  * @param out Buffer the frame is appended to
+  */
+ void encodeRequest(const Request& request, std::string& out) {
+     std::size_t start = beginFrame(out);
+     put(out, static_cast<std::uint8_t>(request.op));
+     put(out, request.tag);
+
+     switch (request.op) {
+         case Op::FindById:
+         case Op::Remove:
+         case Op::Borrow:
+         case Op::Return:
+             put(out, static_cast<std::uint32_t>(request.id));
+             break;
+         case Op::FindByTitle:
+         case Op::FindByAuthor:
+             putString(out, request.title);
+             break;
+         case Op::Add:
+             putString(out, request.title);
+             putString(out, request.author);
+             put(out, static_cast<std::uint32_t>(request.year));
+             break;
+         case Op::Update:
+             put(out, static_cast<std::uint32_t>(request.id));
+             put(out, request.version);
+             putString(out, request.title);
+             putString(out, request.author);
+             put(out, static_cast<std::uint32_t>(request.year));
+             break;
+     }
+     finishFrame(out, start);
+ }
+
+ /**
+  * @brief Implementation of the encodeResponse function
+  *
+  * @param tag Tag of the request being answered
+  * @param status Outcome of the request
+  * @param books Books to return (may be empty)
+  * @param out Buffer the frame is appended to
+  */
+ void encodeResponse(std::uint32_t tag, Status status, const std::vector<Book>& books, std::string& out) {
+     std::size_t start = beginFrame(out);
+     put(out, tag);
+     put(out, static_cast<std::uint8_t>(status));
+     put(out, static_cast<std::uint32_t>(books.size()));
+     for (const Book& book : books) {
+         put(out, static_cast<std::uint32_t>(book.getId()));
+         putString(out, book.getTitle());
+         putString(out, book.getAuthor());
+         put(out, static_cast<std::uint32_t>(book.getYear()));
+         put(out, static_cast<std::uint8_t>(book.isAvailable() ? 1 : 0));
+         put(out, book.getVersion());
+     }
+     finishFrame(out, start);
+ }
+
+ /**
+  * @brief Implementation of the completeFrame function
+  *
+  * @param data Buffered bytes
+  * @param payloadSize Receives the payload size once the header is available
+  * @return true if the whole frame is buffered
+  */
+ bool completeFrame(std::string_view data, std::uint32_t& payloadSize) {
+     Reader reader(data);
+     if (!reader.get(payloadSize)) {
+         return false;
+     }
+     return data.size() - kFrameHeaderSize >= payloadSize;
+ }
+
+ /**
+  * @brief Implementation of the decodeRequest function
+  *
+  * @param payload The payload (without the length prefix)
+  * @param request Receives the request
+  * @return false if the payload is malformed
+  */
+ bool decodeRequest(std::string_view payload, Request& request) {
+     Reader reader(payload);
+     std::uint8_t op;
+     if (!reader.get(op) || !reader.get(request.tag)) {
+         return false;
+     }
+     request.op = static_cast<Op>(op);
+
+     bool valid = false;
+     switch (request.op) {
+         case Op::FindById:
+         case Op::Remove:
+         case Op::Borrow:
+         case Op::Return:
+             valid = reader.getInt(request.id);
+             break;
+         case Op::FindByTitle:
+         case Op::FindByAuthor:
+             valid = reader.getString(request.title);
+             break;
+         case Op::Add:
+             valid = reader.getString(request.title) && reader.getString(request.author) &&
+                     reader.getInt(request.year);
+             break;
+         case Op::Update:
+             valid = reader.getInt(request.id) && reader.get(request.version) &&
+                     reader.getString(request.title) && reader.getString(request.author) &&
+                     reader.getInt(request.year);
+             break;
+     }
+     return valid && reader.atEnd();
+ }
+
+ /**
+  * @brief Implementation of the decodeResponse function
+  *
+  * @param payload The payload (without the length prefix)
+  * @param response Receives the response
+  * @return false if the payload is malformed
+  */
+ bool decodeResponse(std::string_view payload, Response& response) {
+     Reader reader(payload);
+     std::uint8_t status;
+     std::uint32_t count;
+     if (!reader.get(response.tag) || !reader.get(status) || !reader.get(count)) {
+         return false;
+     }
+     response.status = static_cast<Status>(status);
+
+     response.books.clear();
+     for (std::uint32_t i = 0; i < count; ++i) {
+         int id, year;
+         std::string title, author;
+         std::uint8_t available;
+         std::uint64_t version;
+         if (!reader.getInt(id) || !reader.getString(title) || !reader.getString(author) ||
+             !reader.getInt(year) || !reader.get(available) || !reader.get(version)) {
+             return false;
+         }
+         Book book(id, title, author, year);
+         book.setAvailable(available != 0);
+         book.setVersion(version);
+         response.books.push_back(std::move(book));
+     }
+     return reader.atEnd();
+ }
+
+ } // namespace BinaryProtocol
@@ -0,0 +1,195 @@
+/**
+ * @file BinaryServer.cpp
+ * @brief Implementation of the binary protocol server
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements the BinaryServer class declared in BinaryServer.hpp:
+ * the Unix domain socket setup, frame parsing and the mapping of requests
+ * onto Library operations.
+ */
+
+ #include "BinaryServer.hpp"
+ #include <cerrno>
+ #include <cstring>
+ #include <iostream>
+ #include <sys/socket.h>
+ #include <sys/stat.h>
+ #include <sys/un.h>
+ #include <unistd.h>
+
+ using BinaryProtocol::Op;
+ using BinaryProtocol::Request;
+ using BinaryProtocol::Status;
+
+ namespace {
+
+ /// @brief Requests of one connection that may await their response at once
+ constexpr std::size_t kMaxPipelined = 1024;
+
+ /**
+  * @brief Encodes a response frame
+  *
+  * @param tag Tag of the request being answered
+  * @param status Outcome of the request
+  * @param books Books to return
+  * @return The frame
+  */
+ std::string respond(std::uint32_t tag, Status status, const std::vector<Book>& books = {}) {
+     std::string bytes;
+     BinaryProtocol::encodeResponse(tag, status, books, bytes);
+     return bytes;
+ }
+
+ } // namespace
+
+ /**
+  * @brief Constructor implementation
+  *
+  * @param loop The loop that drives the server's sockets
+  * @param library The library to serve
+  */
+ BinaryServer::BinaryServer(EventLoop& loop, Library& library)
+     : StreamServer(loop, kMaxPipelined), library(library) {}
+
+ /**
+  * @brief Destructor implementation
+  */
+ BinaryServer::~BinaryServer() {
+     if (!socketPath.empty()) {
+         unlink(socketPath.c_str());
+     }
+ }
+
+ /**
+  * @brief Implementation of the listen method
+  *
+  * @param path File system path of the socket
+  * @return true if the socket is listening, false otherwise
+  */
+ bool BinaryServer::listen(const std::string& path) {
+     sockaddr_un address{};
+     if (path.size() >= sizeof(address.sun_path)) {
+         std::cerr << "Socket path too long: " << path << std::endl;
+         return false;
+     }
+     address.sun_family = AF_UNIX;
+     std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+     // Only replace what is certainly a socket from an earlier run
+     struct stat info;
+     if (lstat(path.c_str(), &info) == 0) {
+         if (!S_ISSOCK(info.st_mode)) {
+             std::cerr << "Refusing to replace non-socket file: " << path << std::endl;
+             return false;
+         }
+         unlink(path.c_str());
+     }
+
+     int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+     if (fd < 0) {
+         std::cerr << "Error creating socket: " << std::strerror(errno) << std::endl;
+         return false;
+     }
+     if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+         ::listen(fd, SOMAXCONN) < 0) {
+         std::cerr << "Error listening on " << path << ": " << std::strerror(errno) << std::endl;
+         close(fd);
+         return false;
+     }
+
+     socketPath = path;
+     return startListening(fd);
+ }
+
+ /**
+  * @brief Implementation of the parseOne method
+  *
+  * @param connection The connection whose input to parse
+  * @return true if a request was consumed, false if more input is needed
+  *         or the input was rejected
+  */
+ bool BinaryServer::parseOne(Connection& connection) {
+     std::string_view input = connection.input();
+
+     std::uint32_t payloadSize = 0;
+     if (!BinaryProtocol::completeFrame(input, payloadSize)) {
+         if (payloadSize > BinaryProtocol::kMaxPayloadSize) {
+             queueFinal(connection, respond(0, Status::BadRequest));
+         }
+         return false;
+     }
+
+     Request request;
+     if (!BinaryProtocol::decodeRequest(input.substr(BinaryProtocol::kFrameHeaderSize, payloadSize), request)) {
+         queueFinal(connection, respond(request.tag, Status::BadRequest));
+         return false;
+     }
+     connection.consume(BinaryProtocol::kFrameHeaderSize + payloadSize);
+
+     execute(request, reserveSlot(connection));
+     return true;
+ }
+
+ /**
+  * @brief Implementation of the execute method
+  *
+  * @param request The decoded request
+  * @param done Completes the request's response slot
+  */
+ void BinaryServer::execute(const Request& request, Completion done) {
+     std::uint32_t tag = request.tag;
+     Library& lib = library;
+
+     switch (request.op) {
+         case Op::FindById: {
+             std::vector<Book> books;
+             if (std::optional<Book> book = lib.findBookById(request.id)) {
+                 books.push_back(std::move(*book));
+             }
+             done(respond(tag, books.empty() ? Status::NotFound : Status::Ok, books), false);
+             return;
+         }
+
+         case Op::FindByTitle:
+             done(respond(tag, Status::Ok, lib.findBooksByTitle(request.title)), false);
+             return;
+
+         case Op::FindByAuthor:
+             done(respond(tag, Status::Ok, lib.findBooksByAuthor(request.title)), false);
+             return;
+
+         case Op::Add:
+             spawn(lib.addBookAsync(request.title, request.author, request.year), [tag, done](bool added) {
+                 done(respond(tag, added ? Status::Ok : Status::Failed), false);
+             });
+             return;
+
+         case Op::Remove:
+             spawn(lib.removeBookAsync(request.id), [tag, done](bool removed) {
+                 done(respond(tag, removed ? Status::Ok : Status::NotFound), false);
+             });
+             return;
+
+         case Op::Borrow:
+         case Op::Return: {
+             int id = request.id;
+             Task<bool> task = request.op == Op::Borrow ? lib.borrowBookAsync(id) : lib.returnBookAsync(id);
+             spawn(std::move(task), [&lib, tag, id, done](bool succeeded) {
+                 Status status = succeeded ? Status::Ok
+                               : lib.findBookById(id) ? Status::Conflict : Status::NotFound;
+                 done(respond(tag, status), false);
+             });
+             return;
+         }
+
+         case Op::Update:
+             spawn(lib.updateBookAsync(request.id, request.version, request.title, request.author, request.year),
+                   [tag, done](UpdateResult result) {
+                       Status status = result == UpdateResult::Updated ? Status::Ok
+                                     : result == UpdateResult::NotFound ? Status::NotFound : Status::Conflict;
+                       done(respond(tag, status), false);
+                   });
+             return;
+     }
+ }
@@ -0,0 +1,204 @@
+/**
+ * @file EventLoop.cpp
+ * @brief Implementation of the epoll-based event loop
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements the EventLoop class declared in EventLoop.hpp. An
+ * eventfd registered next to the client descriptors wakes epoll_wait when
+ * work is posted from another thread or the loop is asked to stop.
+ */
+
+ #include "EventLoop.hpp"
+ #include <cerrno>
+ #include <cstring>
+ #include <iostream>
+ #include <sys/epoll.h>
+ #include <sys/eventfd.h>
+ #include <unistd.h>
+
+ /**
+  * @brief Constructor implementation
+  */
+ EventLoop::EventLoop() {
+     epollFd = epoll_create1(EPOLL_CLOEXEC);
+     wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+     if (epollFd < 0 || wakeFd < 0) {
+         std::cerr << "Error creating event loop: " << std::strerror(errno) << std::endl;
+         return;
+     }
+
+     epoll_event event{};
+     event.events = EPOLLIN;
+     event.data.fd = wakeFd;
+     epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+ }
+
+ /**
+  * @brief Destructor implementation
+  */
+ EventLoop::~EventLoop() {
+     if (wakeFd >= 0) {
+         close(wakeFd);
+     }
+     if (epollFd >= 0) {
+         close(epollFd);
+     }
+ }
+
+ /**
+  * @brief Implementation of the valid method
+  * @return true if the epoll and wake-up descriptors are open
+  */
+ bool EventLoop::valid() const {
+     return epollFd >= 0 && wakeFd >= 0;
+ }
+
+ /**
+  * @brief Implementation of the add method
+  *
+  * @param fd Non-blocking descriptor
+  * @param events Epoll event mask to watch
+  * @param handler Called on the loop thread when the descriptor is ready
+  * @return true if the descriptor was registered
+  */
+ bool EventLoop::add(int fd, std::uint32_t events, Handler handler) {
+     epoll_event event{};
+     event.events = events;
+     event.data.fd = fd;
+     if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+         std::cerr << "Error watching descriptor " << fd << ": " << std::strerror(errno) << std::endl;
+         return false;
+     }
+     handlers[fd] = std::make_shared<Handler>(std::move(handler));
+     return true;
+ }
+
+ /**
+  * @brief Implementation of the modify method
+  *
+  * @param fd Registered descriptor
+  * @param events New epoll event mask
+  */
+ void EventLoop::modify(int fd, std::uint32_t events) {
+     epoll_event event{};
+     event.events = events;
+     event.data.fd = fd;
+     epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+ }
+
+ /**
+  * @brief Implementation of the remove method
+  * @param fd Registered descriptor
+  */
+ void EventLoop::remove(int fd) {
+     epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+     handlers.erase(fd);
+ }
+
+ /**
+  * @brief Implementation of the post method
+  * @param task The function to run
+  */
+ void EventLoop::post(std::function<void()> task) {
+     {
+         std::lock_guard<std::mutex> lock(postedMutex);
+         posted.push_back(std::move(task));
+     }
+     wake();
+ }
+
+ /**
+  * @brief Implementation of the wake method
+  *
+  * Only uses write(), so it is async-signal-safe.
+  */
+ void EventLoop::wake() {
+     std::uint64_t one = 1;
+     ssize_t written = write(wakeFd, &one, sizeof(one));
+     (void)written;  // EAGAIN means a wake-up is already pending
+ }
+
+ /**
+  * @brief Implementation of the runPosted method
+  *
+  * Takes the whole queue at once; tasks posted while it runs wait for the
+  * next iteration, so a task that re-posts itself cannot starve the loop.
+  */
+ void EventLoop::runPosted() {
+     std::vector<std::function<void()>> tasks;
+     {
+         std::lock_guard<std::mutex> lock(postedMutex);
+         tasks.swap(posted);
+     }
+     for (auto& task : tasks) {
+         task();
+     }
+ }
+
+ /**
+  * @brief Implementation of the runOnce method
+  *
+  * @param timeoutMs Maximum time to wait in milliseconds (-1 waits forever)
+  */
+ void EventLoop::runOnce(int timeoutMs) {
+     loopThread = std::this_thread::get_id();
+
+     epoll_event events[128];
+     int count = epoll_wait(epollFd, events, 128, timeoutMs);
+     if (count < 0 && errno != EINTR) {
+         std::cerr << "Error waiting for events: " << std::strerror(errno) << std::endl;
+     }
+
+     for (int i = 0; i < count; ++i) {
+         int fd = events[i].data.fd;
+         if (fd == wakeFd) {
+             std::uint64_t value;
+             ssize_t drained = read(wakeFd, &value, sizeof(value));
+             (void)drained;
+             continue;
+         }
+
+         // Keep the handler alive even if it removes its own descriptor
+         auto it = handlers.find(fd);
+         if (it != handlers.end()) {
+             std::shared_ptr<Handler> handler = it->second;
+             (*handler)(events[i].events);
+         }
+     }
+
+     runPosted();
+ }
+
+ /**
+  * @brief Implementation of the run method
+  */
+ void EventLoop::run() {
+     while (!stopRequested.load()) {
+         runOnce(-1);
+     }
+ }
+
+ /**
+  * @brief Implementation of the stop method
+  */
+ void EventLoop::stop() {
+     stopRequested = true;
+     wake();
+ }
+
+ /**
+  * @brief Implementation of the stopping method
+  * @return true once the loop has been asked to stop
+  */
+ bool EventLoop::stopping() const {
+     return stopRequested.load();
+ }
+
+ /**
+  * @brief Implementation of the inLoopThread method
+  * @return true on the loop thread
+  */
+ bool EventLoop::inLoopThread() const {
+     return loopThread.load() == std::this_thread::get_id();
+ }
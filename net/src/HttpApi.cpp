@@ -0,0 +1,370 @@
+/**
+ * @file HttpApi.cpp
+ * @brief Implementation of the JSON/HTTP interface to a Library
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements the routes declared in HttpApi.hpp: path matching,
+ * JSON (de)serialization with nlohmann/json and the mapping of Library
+ * results to HTTP status codes.
+ */
+
+ #include "HttpApi.hpp"
+ #include <charconv>
+ #include <cstdint>
+ #include <functional>
+ #include <limits>
+ #include <nlohmann/json.hpp>
+ #include <string>
+ #include <vector>
+
+ using json = nlohmann::json;
+
+ namespace {
+
+ /// @brief Books per page of GET /books when no limit is given
+ constexpr std::size_t kDefaultPageSize = 100;
+
+ /// @brief Largest limit GET /books accepts
+ constexpr std::size_t kMaxPageSize = 1000;
+
+ /**
+  * @brief Converts a book to its JSON representation
+  *
+  * @param book The book to convert
+  * @return JSON object
+  */
+ json toJson(const Book& book) {
+     return json{
+         {"id", book.getId()},
+         {"title", book.getTitle()},
+         {"author", book.getAuthor()},
+         {"year", book.getYear()},
+         {"available", book.isAvailable()},
+         {"version", book.getVersion()}
+     };
+ }
+
+ /**
+  * @brief Builds a response with a JSON body
+  *
+  * @param status HTTP status code
+  * @param body JSON body
+  * @return The response
+  */
+ HttpResponse jsonResponse(int status, const json& body) {
+     HttpResponse response;
+     response.status = status;
+     // Invalid UTF-8 in stored titles must not abort the response
+     response.body = body.dump(-1, ' ', false, json::error_handler_t::replace);
+     return response;
+ }
+
+ /**
+  * @brief Builds an error response
+  *
+  * @param status HTTP status code
+  * @param message Error description
+  * @return The response
+  */
+ HttpResponse errorResponse(int status, const std::string& message) {
+     return jsonResponse(status, json{{"error", message}});
+ }
+
+ /**
+  * @brief Splits a path into its non-empty segments
+  *
+  * @param path Request path, e.g. "/books/12/borrow"
+  * @return Segments, e.g. {"books", "12", "borrow"}
+  */
+ std::vector<std::string> splitPath(const std::string& path) {
+     std::vector<std::string> segments;
+     std::size_t start = 0;
+     while (start < path.size()) {
+         std::size_t end = path.find('/', start);
+         if (end == std::string::npos) {
+             end = path.size();
+         }
+         if (end > start) {
+             segments.push_back(path.substr(start, end - start));
+         }
+         start = end + 1;
+     }
+     return segments;
+ }
+
+ /**
+  * @brief Parses a path segment as a book ID
+  *
+  * @param text The segment
+  * @param id Receives the ID
+  * @return true if the whole segment is a number
+  */
+ bool parseId(const std::string& text, int& id) {
+     auto result = std::from_chars(text.data(), text.data() + text.size(), id);
+     return !text.empty() && result.ec == std::errc() && result.ptr == text.data() + text.size();
+ }
+
+ /**
+  * @brief Parses and validates the book fields of a request body
+  *
+  * @param body Request body
+  * @param fields Receives the parsed JSON object
+  * @param error Receives the reason if the body is invalid
+  * @return true if title, author and year are present with the right types
+  *         and the year fits in an int
+  */
+ bool parseBookFields(const std::string& body, json& fields, std::string& error) {
+     fields = json::parse(body, nullptr, false);
+     if (fields.is_discarded() || !fields.is_object()) {
+         error = "body must be a JSON object";
+         return false;
+     }
+     if (!fields.contains("title") || !fields["title"].is_string() ||
+         !fields.contains("author") || !fields["author"].is_string() ||
+         !fields.contains("year") || !fields["year"].is_number_integer()) {
+         error = "title and author (strings) and year (integer) are required";
+         return false;
+     }
+     // Books keep the year in an int; larger values must not be narrowed
+     const json& year = fields["year"];
+     bool inRange = year.is_number_unsigned()
+         ? year.get<std::uint64_t>() <= static_cast<std::uint64_t>(std::numeric_limits<int>::max())
+         : year.get<std::int64_t>() >= std::numeric_limits<int>::min() &&
+           year.get<std::int64_t>() <= std::numeric_limits<int>::max();
+     if (!inRange) {
+         error = "year is out of range";
+         return false;
+     }
+     return true;
+ }
+
+ /**
+  * @brief Parses the paging parameters of a listing
+  *
+  * @param request The request, with optional "after" and "limit" parameters
+  * @param afterId Receives the cursor (0 if absent)
+  * @param limit Receives the page size (kDefaultPageSize if absent)
+  * @param error Receives the reason if a parameter is invalid
+  * @return true if the parameters are valid
+  */
+ bool parsePaging(const HttpRequest& request, int& afterId, std::size_t& limit, std::string& error) {
+     std::string text;
+     afterId = 0;
+     if (request.queryParam("after", text) && (!parseId(text, afterId) || afterId < 0)) {
+         error = "after must be a book ID";
+         return false;
+     }
+     limit = kDefaultPageSize;
+     if (request.queryParam("limit", text)) {
+         auto result = std::from_chars(text.data(), text.data() + text.size(), limit);
+         if (text.empty() || result.ec != std::errc() || result.ptr != text.data() + text.size() ||
+             limit == 0 || limit > kMaxPageSize) {
+             error = "limit must be between 1 and " + std::to_string(kMaxPageSize);
+             return false;
+         }
+     }
+     return true;
+ }
+
+ /**
+  * @brief Answers a borrow or return once its outcome is known
+  *
+  * A failure is reported as 404 if the book does not exist and as 409 if
+  * it is in the wrong state.
+  *
+  * @param library The library the operation ran against
+  * @param id The book's ID
+  * @param succeeded Outcome of the operation
+  * @param borrowing true for borrow, false for return
+  * @param respond Receives the response
+  */
+ void respondToLoan(Library& library, int id, bool succeeded, bool borrowing,
+                    const HttpServer::Responder& respond) {
+     if (succeeded) {
+         respond(jsonResponse(200, json{{"id", id}, {borrowing ? "borrowed" : "returned", true}}));
+     } else if (!library.findBookById(id)) {
+         respond(errorResponse(404, "book not found"));
+     } else {
+         respond(errorResponse(409, borrowing ? "book is already borrowed" : "book is not borrowed"));
+     }
+ }
+
+ /**
+  * @brief Handles requests to the /books collection
+  *
+  * Listings are paged, filtered or not, so one request never serializes
+  * the whole catalog (or every match of a broad search) on the loop thread.
+  *
+  * @param library The library to operate on
+  * @param request The parsed request
+  * @param respond Receives the response
+  */
+ void handleCollection(Library& library, const HttpRequest& request, HttpServer::Responder respond) {
+     if (request.method == "GET") {
+         int afterId = 0;
+         std::size_t limit = 0;
+         std::string error;
+         if (!parsePaging(request, afterId, limit, error)) {
+             respond(errorResponse(400, error));
+             return;
+         }
+
+         // Same case-sensitive partial match as findBooksByTitle/findBooksByAuthor
+         std::string filter;
+         std::function<bool(const Book&)> matches;
+         if (request.queryParam("title", filter)) {
+             matches = [&filter](const Book& book) { return book.getTitle().find(filter) != std::string::npos; };
+         } else if (request.queryParam("author", filter)) {
+             matches = [&filter](const Book& book) { return book.getAuthor().find(filter) != std::string::npos; };
+         }
+         BookPage page = library.pageAfter(afterId, limit, matches);
+         json body = json::object();
+         if (page.hasMore) {
+             body["next"] = page.books.back().getId();
+         }
+
+         json list = json::array();
+         for (const Book& book : page.books) {
+             list.push_back(toJson(book));
+         }
+         body["books"] = std::move(list);
+         respond(jsonResponse(200, body));
+         return;
+     }
+
+     if (request.method == "POST") {
+         json fields;
+         std::string error;
+         if (!parseBookFields(request.body, fields, error)) {
+             respond(errorResponse(400, error));
+             return;
+         }
+         spawn(library.addBookAsync(fields["title"].get<std::string>(), fields["author"].get<std::string>(),
+                                    fields["year"].get<int>()),
+               [respond](bool added) {
+                   respond(added ? jsonResponse(201, json{{"added", true}})
+                                 : errorResponse(500, "book could not be added"));
+               });
+         return;
+     }
+
+     respond(errorResponse(405, "use GET or POST on /books"));
+ }
+
+ /**
+  * @brief Handles requests to a single book, /books/{id}[/action]
+  *
+  * @param library The library to operate on
+  * @param request The parsed request
+  * @param id The book's ID
+  * @param action "borrow", "return" or empty
+  * @param respond Receives the response
+  */
+ void handleBook(Library& library, const HttpRequest& request, int id, const std::string& action,
+                 HttpServer::Responder respond) {
+     if (action == "borrow" || action == "return") {
+         if (request.method != "POST") {
+             respond(errorResponse(405, "use POST to " + action + " a book"));
+             return;
+         }
+         bool borrowing = action == "borrow";
+         spawn(borrowing ? library.borrowBookAsync(id) : library.returnBookAsync(id),
+               [&library, id, borrowing, respond](bool succeeded) {
+                   respondToLoan(library, id, succeeded, borrowing, respond);
+               });
+         return;
+     }
+
+     if (!action.empty()) {
+         respond(errorResponse(404, "unknown route"));
+         return;
+     }
+
+     if (request.method == "GET") {
+         if (std::optional<Book> book = library.findBookById(id)) {
+             respond(jsonResponse(200, toJson(*book)));
+         } else {
+             respond(errorResponse(404, "book not found"));
+         }
+         return;
+     }
+
+     if (request.method == "PUT") {
+         json fields;
+         std::string error;
+         if (!parseBookFields(request.body, fields, error)) {
+             respond(errorResponse(400, error));
+             return;
+         }
+         if (!fields.contains("version") || !fields["version"].is_number_unsigned()) {
+             respond(errorResponse(400, "version (the version that was read) is required"));
+             return;
+         }
+         spawn(library.updateBookAsync(id, fields["version"].get<std::uint64_t>(),
+                                       fields["title"].get<std::string>(), fields["author"].get<std::string>(),
+                                       fields["year"].get<int>()),
+               [&library, id, respond](UpdateResult result) {
+                   switch (result) {
+                       case UpdateResult::Updated:
+                           // The book may already have been removed again
+                           if (std::optional<Book> book = library.findBookById(id)) {
+                               respond(jsonResponse(200, toJson(*book)));
+                           } else {
+                               respond(jsonResponse(200, json{{"updated", true}}));
+                           }
+                           break;
+                       case UpdateResult::NotFound:
+                           respond(errorResponse(404, "book not found"));
+                           break;
+                       case UpdateResult::Conflict:
+                           respond(errorResponse(409, "book was changed by someone else"));
+                           break;
+                   }
+               });
+         return;
+     }
+
+     if (request.method == "DELETE") {
+         spawn(library.removeBookAsync(id), [respond](bool removed) {
+             respond(removed ? jsonResponse(200, json{{"removed", true}})
+                             : errorResponse(404, "book not found"));
+         });
+         return;
+     }
+
+     respond(errorResponse(405, "use GET, PUT or DELETE on /books/{id}"));
+ }
+
+ } // namespace
+
+ namespace HttpApi {
+
+ /**
+  * @brief Implementation of the handle function
+  *
+  * @param library The library to operate on
+  * @param request The parsed request
+  * @param respond Receives the response, possibly later and on another thread
+  */
+ void handle(Library& library, const HttpRequest& request, HttpServer::Responder respond) {
+     std::vector<std::string> segments = splitPath(request.path);
+     if (segments.empty() || segments[0] != "books" || segments.size() > 3) {
+         respond(errorResponse(404, "unknown route"));
+         return;
+     }
+
+     if (segments.size() == 1) {
+         handleCollection(library, request, std::move(respond));
+         return;
+     }
+
+     int id;
+     if (!parseId(segments[1], id)) {
+         respond(errorResponse(400, "book ID must be a number"));
+         return;
+     }
+     handleBook(library, request, id, segments.size() == 3 ? segments[2] : "", std::move(respond));
+ }
+
+ } // namespace HttpApi
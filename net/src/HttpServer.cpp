@@ -0,0 +1,336 @@
+/**
+ * @file HttpServer.cpp
+ * @brief Implementation of the HTTP/1.1 server
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements the HttpServer class declared in HttpServer.hpp:
+ * incremental parsing of HTTP/1.x requests and serialization of responses.
+ * Connection handling lives in StreamServer.
+ */
+
+ #include "HttpServer.hpp"
+ #include <algorithm>
+ #include <cctype>
+ #include <cerrno>
+ #include <charconv>
+ #include <cstring>
+ #include <iostream>
+ #include <arpa/inet.h>
+ #include <netinet/in.h>
+ #include <netinet/tcp.h>
+ #include <sys/socket.h>
+ #include <unistd.h>
+
+ namespace {
+
+ /// @brief Largest accepted request head (request line and headers)
+ constexpr std::size_t kMaxHeaderBytes = 64 * 1024;
+
+ /// @brief Largest accepted request body
+ constexpr std::size_t kMaxBodyBytes = 1024 * 1024;
+
+ /// @brief Requests of one connection that may await their response at once
+ constexpr std::size_t kMaxPipelined = 64;
+
+ /**
+  * @brief Gets the reason phrase of a status code
+  *
+  * @param status HTTP status code
+  * @return The reason phrase
+  */
+ const char* reasonPhrase(int status) {
+     switch (status) {
+         case 200: return "OK";
+         case 201: return "Created";
+         case 204: return "No Content";
+         case 400: return "Bad Request";
+         case 404: return "Not Found";
+         case 405: return "Method Not Allowed";
+         case 409: return "Conflict";
+         case 413: return "Payload Too Large";
+         case 431: return "Request Header Fields Too Large";
+         case 500: return "Internal Server Error";
+         case 501: return "Not Implemented";
+         case 505: return "HTTP Version Not Supported";
+         default: return "Unknown";
+     }
+ }
+
+ /**
+  * @brief Serializes a response including its status line and headers
+  *
+  * @param response The response
+  * @param keepAlive Whether the connection stays open afterwards
+  * @return The bytes to send
+  */
+ std::string serialize(const HttpResponse& response, bool keepAlive) {
+     std::string bytes;
+     bytes.reserve(128 + response.body.size());
+     bytes += "HTTP/1.1 ";
+     bytes += std::to_string(response.status);
+     bytes += ' ';
+     bytes += reasonPhrase(response.status);
+     bytes += "\r\nContent-Type: ";
+     bytes += response.contentType;
+     bytes += "\r\nContent-Length: ";
+     bytes += std::to_string(response.body.size());
+     bytes += keepAlive ? "\r\nConnection: keep-alive\r\n\r\n" : "\r\nConnection: close\r\n\r\n";
+     bytes += response.body;
+     return bytes;
+ }
+
+ /**
+  * @brief Decodes %XX escapes and '+' in a query string component
+  *
+  * @param text Encoded text
+  * @return Decoded text
+  */
+ std::string urlDecode(const std::string& text) {
+     std::string decoded;
+     decoded.reserve(text.size());
+     for (std::size_t i = 0; i < text.size(); ++i) {
+         if (text[i] == '+') {
+             decoded += ' ';
+         } else if (text[i] == '%' && i + 2 < text.size() &&
+                    std::isxdigit(static_cast<unsigned char>(text[i + 1])) &&
+                    std::isxdigit(static_cast<unsigned char>(text[i + 2]))) {
+             decoded += static_cast<char>(std::stoi(text.substr(i + 1, 2), nullptr, 16));
+             i += 2;
+         } else {
+             decoded += text[i];
+         }
+     }
+     return decoded;
+ }
+
+ /**
+  * @brief Removes leading and trailing spaces and tabs
+  *
+  * @param text Text to trim
+  * @return Trimmed text
+  */
+ std::string trim(const std::string& text) {
+     std::size_t first = text.find_first_not_of(" \t");
+     if (first == std::string::npos) {
+         return "";
+     }
+     std::size_t last = text.find_last_not_of(" \t");
+     return text.substr(first, last - first + 1);
+ }
+
+ } // namespace
+
+ /**
+  * @brief Implementation of the HttpRequest::queryParam method
+  *
+  * @param name Parameter name
+  * @param value Receives the decoded value
+  * @return true if the parameter is present
+  */
+ bool HttpRequest::queryParam(const std::string& name, std::string& value) const {
+     std::size_t start = 0;
+     while (start <= query.size()) {
+         std::size_t end = query.find('&', start);
+         if (end == std::string::npos) {
+             end = query.size();
+         }
+
+         std::string pair = query.substr(start, end - start);
+         std::size_t equals = pair.find('=');
+         if (urlDecode(pair.substr(0, equals)) == name) {
+             value = equals == std::string::npos ? "" : urlDecode(pair.substr(equals + 1));
+             return true;
+         }
+         start = end + 1;
+     }
+     return false;
+ }
+
+ /**
+  * @brief Constructor implementation
+  *
+  * @param loop The loop that drives the server's sockets
+  * @param handler Called for every request
+  */
+ HttpServer::HttpServer(EventLoop& loop, Handler handler)
+     : StreamServer(loop, kMaxPipelined), handler(std::move(handler)) {}
+
+ /**
+  * @brief Implementation of the listen method
+  *
+  * @param port TCP port; 0 picks a free port
+  * @return true if the socket is listening, false otherwise
+  */
+ bool HttpServer::listen(std::uint16_t port) {
+     int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+     if (fd < 0) {
+         std::cerr << "Error creating socket: " << std::strerror(errno) << std::endl;
+         return false;
+     }
+
+     int reuse = 1;
+     setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+     // Loopback only: the server has no authentication
+     sockaddr_in address{};
+     address.sin_family = AF_INET;
+     address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+     address.sin_port = htons(port);
+     if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+         ::listen(fd, SOMAXCONN) < 0) {
+         std::cerr << "Error listening on port " << port << ": " << std::strerror(errno) << std::endl;
+         close(fd);
+         return false;
+     }
+
+     socklen_t length = sizeof(address);
+     getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length);
+     boundPort = ntohs(address.sin_port);
+
+     return startListening(fd);
+ }
+
+ /**
+  * @brief Implementation of the port method
+  * @return The bound port, or 0 if not listening
+  */
+ std::uint16_t HttpServer::port() const {
+     return boundPort;
+ }
+
+ /**
+  * @brief Implementation of the configureClient method
+  *
+  * Responses are written in one piece, so Nagle's algorithm would only
+  * delay them.
+  *
+  * @param fd The client socket
+  */
+ void HttpServer::configureClient(int fd) {
+     int noDelay = 1;
+     setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+ }
+
+ /**
+  * @brief Implementation of the parseOne method
+  *
+  * Parses the request at the head of the unparsed input and dispatches it.
+  *
+  * @param connection The connection whose input to parse
+  * @return true if a request was consumed, false if more input is needed
+  *         or the input was rejected
+  */
+ bool HttpServer::parseOne(Connection& connection) {
+     std::string_view input = connection.input();
+
+     std::size_t headEnd = input.find("\r\n\r\n");
+     if (headEnd == std::string_view::npos) {
+         if (input.size() > kMaxHeaderBytes) {
+             respondError(connection, 431, "request head too large");
+         }
+         return false;
+     }
+
+     // Request line: METHOD SP target SP version
+     HttpRequest request;
+     std::size_t lineEnd = input.find("\r\n");
+     std::string_view line = input.substr(0, lineEnd);
+     std::size_t firstSpace = line.find(' ');
+     std::size_t lastSpace = line.rfind(' ');
+     if (firstSpace == std::string_view::npos || firstSpace == lastSpace) {
+         respondError(connection, 400, "malformed request line");
+         return false;
+     }
+     request.method = line.substr(0, firstSpace);
+     std::string_view target = line.substr(firstSpace + 1, lastSpace - firstSpace - 1);
+     std::string_view version = line.substr(lastSpace + 1);
+     if (version != "HTTP/1.1" && version != "HTTP/1.0") {
+         respondError(connection, 505, "only HTTP/1.0 and HTTP/1.1 are supported");
+         return false;
+     }
+
+     std::size_t question = target.find('?');
+     request.path = target.substr(0, question);
+     if (question != std::string_view::npos) {
+         request.query = target.substr(question + 1);
+     }
+
+     // Header fields, one per line
+     std::size_t position = lineEnd + 2;
+     while (position < headEnd) {
+         std::size_t end = input.find("\r\n", position);
+         std::string field(input.substr(position, end - position));
+         position = end + 2;
+
+         std::size_t colon = field.find(':');
+         if (colon == std::string::npos) {
+             respondError(connection, 400, "malformed header field");
+             return false;
+         }
+         std::string name = field.substr(0, colon);
+         std::transform(name.begin(), name.end(), name.begin(),
+             [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+         request.headers[name] = trim(field.substr(colon + 1));
+     }
+
+     if (request.headers.count("transfer-encoding")) {
+         respondError(connection, 501, "chunked request bodies are not supported");
+         return false;
+     }
+
+     std::size_t bodyLength = 0;
+     auto length = request.headers.find("content-length");
+     if (length != request.headers.end()) {
+         const std::string& value = length->second;
+         auto result = std::from_chars(value.data(), value.data() + value.size(), bodyLength);
+         if (result.ec != std::errc() || result.ptr != value.data() + value.size()) {
+             respondError(connection, 400, "invalid Content-Length");
+             return false;
+         }
+         if (bodyLength > kMaxBodyBytes) {
+             respondError(connection, 413, "request body too large");
+             return false;
+         }
+     }
+
+     std::size_t total = headEnd + 4 + bodyLength;
+     if (input.size() < total) {
+         return false;
+     }
+     request.body = input.substr(headEnd + 4, bodyLength);
+     connection.consume(total);
+
+     // HTTP/1.1 keeps the connection open unless asked not to; 1.0 the reverse
+     std::string connectionHeader;
+     auto header = request.headers.find("connection");
+     if (header != request.headers.end()) {
+         connectionHeader = header->second;
+         std::transform(connectionHeader.begin(), connectionHeader.end(), connectionHeader.begin(),
+             [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+     }
+     bool keepAlive = version == "HTTP/1.1" ? connectionHeader != "close" : connectionHeader == "keep-alive";
+     if (!keepAlive) {
+         connection.closing = true;
+     }
+
+     Completion done = reserveSlot(connection);
+     handler(request, [done = std::move(done), keepAlive](HttpResponse response) {
+         done(serialize(response, keepAlive), !keepAlive);
+     });
+     return true;
+ }
+
+ /**
+  * @brief Implementation of the respondError method
+  *
+  * @param connection The connection to answer
+  * @param status HTTP status code
+  * @param message Error description
+  */
+ void HttpServer::respondError(Connection& connection, int status, const std::string& message) {
+     HttpResponse response;
+     response.status = status;
+     response.body = "{\"error\":\"" + message + "\"}";
+     queueFinal(connection, serialize(response, false));
+ }
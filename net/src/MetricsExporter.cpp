@@ -0,0 +1,138 @@
+/**
+ * @file MetricsExporter.cpp
+ * @brief Implementation of the metrics exporter
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements the MetricsExporter class declared in
+ * MetricsExporter.hpp: the /metrics route and the periodic file dump.
+ */
+
+ #include "MetricsExporter.hpp"
+ #include "Metrics.hpp"
+ #include <cstdio>
+ #include <fstream>
+ #include <iostream>
+ #include <sstream>
+
+ /**
+  * @brief Destructor implementation
+  *
+  * The server thread shuts its connections down itself once its loop
+  * returns; the dump thread writes the final state before exiting.
+  */
+ MetricsExporter::~MetricsExporter() {
+     if (serverThread.joinable()) {
+         loop->stop();
+         serverThread.join();
+     }
+     if (dumpThread.joinable()) {
+         {
+             std::lock_guard<std::mutex> lock(dumpMutex);
+             stopping = true;
+         }
+         dumpWake.notify_one();
+         dumpThread.join();
+     }
+ }
+
+ /**
+  * @brief Implementation of the serve method
+  *
+  * @param port TCP port
+  * @return false if the server could not start
+  */
+ bool MetricsExporter::serve(std::uint16_t port) {
+     if (serverThread.joinable()) {
+         return true;
+     }
+     loop = std::make_unique<EventLoop>();
+     if (!loop->valid()) {
+         return false;
+     }
+     http = std::make_unique<HttpServer>(*loop, [](const HttpRequest& request, HttpServer::Responder respond) {
+         HttpResponse response;
+         if (request.path != "/metrics") {
+             response.status = 404;
+             response.contentType = "text/plain";
+             response.body = "Not found\n";
+         } else if (request.method != "GET") {
+             response.status = 405;
+             response.contentType = "text/plain";
+             response.body = "Method not allowed\n";
+         } else {
+             std::ostringstream text;
+             Metrics::registry().writeText(text);
+             response.contentType = "text/plain; version=0.0.4";
+             response.body = text.str();
+         }
+         respond(std::move(response));
+     });
+     if (!http->listen(port)) {
+         return false;
+     }
+
+     serverThread = std::thread([this] {
+         loop->run();
+         http->shutdown();
+     });
+     return true;
+ }
+
+ /**
+  * @brief Implementation of the port method
+  * @return The bound port, or 0
+  */
+ std::uint16_t MetricsExporter::port() const {
+     return http ? http->port() : 0;
+ }
+
+ /**
+  * @brief Implementation of the dumpEvery method
+  *
+  * @param path File to write
+  * @param interval Time between dumps
+  * @return false if the first dump failed
+  */
+ bool MetricsExporter::dumpEvery(const std::string& path, std::chrono::seconds interval) {
+     if (dumpThread.joinable()) {
+         return true;
+     }
+     dumpPath = path;
+     if (!dump()) {
+         return false;
+     }
+
+     dumpThread = std::thread([this, interval] {
+         std::unique_lock<std::mutex> lock(dumpMutex);
+         while (!dumpWake.wait_for(lock, interval, [this] { return stopping; })) {
+             lock.unlock();
+             dump();
+             lock.lock();
+         }
+         lock.unlock();
+         dump();
+     });
+     return true;
+ }
+
+ /**
+  * @brief Writes the exposition to the dump file atomically
+  * @return false if the file could not be written (reported to stderr)
+  */
+ bool MetricsExporter::dump() const {
+     std::string temporary = dumpPath + ".tmp";
+     {
+         std::ofstream out(temporary, std::ios::trunc);
+         Metrics::registry().writeText(out);
+         if (!out.flush()) {
+             std::cerr << "Error writing metrics file " << temporary << std::endl;
+             return false;
+         }
+     }
+     if (std::rename(temporary.c_str(), dumpPath.c_str()) != 0) {
+         std::cerr << "Error renaming " << temporary << " to " << dumpPath << std::endl;
+         return false;
+     }
+     return true;
+ }
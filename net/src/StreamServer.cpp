@@ -0,0 +1,326 @@
+/**
+ * @file StreamServer.cpp
+ * @brief Implementation of the base class of the stream socket servers
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements the StreamServer class declared in StreamServer.hpp:
+ * accepting clients, reading, in-order delivery of pipelined responses and
+ * back-pressure when a client sends faster than its responses can be
+ * produced or sent.
+ */
+
+ #include "StreamServer.hpp"
+ #include <cerrno>
+ #include <cstring>
+ #include <iostream>
+ #include <sys/epoll.h>
+ #include <sys/socket.h>
+ #include <unistd.h>
+
+ namespace {
+
+ /// @brief Unsent response bytes above which a connection stops being read
+ constexpr std::size_t kMaxPendingOutput = 4 * 1024 * 1024;
+
+ /// @brief Parsed input bytes above which the input buffer is compacted
+ constexpr std::size_t kCompactThreshold = 64 * 1024;
+
+ } // namespace
+
+ /**
+  * @brief Constructor implementation
+  *
+  * @param loop The loop that drives the server's sockets
+  * @param maxPipelined Requests per connection that may await their response at once
+  */
+ StreamServer::StreamServer(EventLoop& loop, std::size_t maxPipelined)
+     : loop(loop), maxPipelined(maxPipelined) {}
+
+ /**
+  * @brief Destructor implementation
+  */
+ StreamServer::~StreamServer() {
+     while (!connections.empty()) {
+         closeConnection(*connections.begin()->second);
+     }
+     if (listenFd >= 0) {
+         loop.remove(listenFd);
+         close(listenFd);
+     }
+ }
+
+ /**
+  * @brief Implementation of the startListening method
+  *
+  * @param fd Non-blocking listening socket; the server takes ownership
+  * @return true if the socket was registered with the loop
+  */
+ bool StreamServer::startListening(int fd) {
+     listenFd = fd;
+     return loop.add(listenFd, EPOLLIN, [this](std::uint32_t) { acceptClients(); });
+ }
+
+ /**
+  * @brief Implementation of the configureClient method (no options by default)
+  * @param fd The client socket
+  */
+ void StreamServer::configureClient(int /*fd*/) {}
+
+ /**
+  * @brief Implementation of the acceptClients method
+  *
+  * Accepts every pending connection and registers it with the loop.
+  */
+ void StreamServer::acceptClients() {
+     for (;;) {
+         int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+         if (fd < 0) {
+             if (errno == EINTR) {
+                 continue;
+             }
+             if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                 std::cerr << "Error accepting connection: " << std::strerror(errno) << std::endl;
+             }
+             return;
+         }
+         configureClient(fd);
+
+         auto connection = std::make_unique<Connection>();
+         connection->fd = fd;
+         connection->id = nextConnectionId++;
+         connection->interest = EPOLLIN;
+
+         std::uint64_t id = connection->id;
+         if (!loop.add(fd, EPOLLIN, [this, id](std::uint32_t events) { onEvent(id, events); })) {
+             close(fd);
+             continue;
+         }
+         connections.emplace(id, std::move(connection));
+     }
+ }
+
+ /**
+  * @brief Implementation of the onEvent method
+  *
+  * @param id Connection the event belongs to
+  * @param events Ready event mask
+  */
+ void StreamServer::onEvent(std::uint64_t id, std::uint32_t events) {
+     auto it = connections.find(id);
+     if (it == connections.end()) {
+         return;
+     }
+     Connection& connection = *it->second;
+
+     // A hang-up means both directions are gone, so nothing can be answered
+     if ((events & (EPOLLHUP | EPOLLERR)) || ((events & EPOLLIN) && !readAvailable(connection))) {
+         closeConnection(connection);
+         return;
+     }
+     process(connection);
+ }
+
+ /**
+  * @brief Implementation of the readAvailable method
+  *
+  * @param connection The connection to read from
+  * @return false if the connection failed and must be closed
+  */
+ bool StreamServer::readAvailable(Connection& connection) {
+     char buffer[16384];
+     for (;;) {
+         ssize_t received = recv(connection.fd, buffer, sizeof(buffer), 0);
+         if (received > 0) {
+             connection.in.append(buffer, static_cast<std::size_t>(received));
+             continue;
+         }
+         if (received == 0) {
+             connection.peerClosed = true;
+             return true;
+         }
+         if (errno == EINTR) {
+             continue;
+         }
+         return errno == EAGAIN || errno == EWOULDBLOCK;
+     }
+ }
+
+ /**
+  * @brief Implementation of the reserveSlot method
+  *
+  * The returned callback posts the completion back to the loop when it is
+  * called from another thread.
+  *
+  * @param connection The connection the request arrived on
+  * @return Callback that completes the slot
+  */
+ StreamServer::Completion StreamServer::reserveSlot(Connection& connection) {
+     std::uint64_t sequence = connection.firstSlot + connection.slots.size();
+     connection.slots.emplace_back();
+     ++inFlight;
+
+     std::uint64_t id = connection.id;
+     return [this, id, sequence](std::string bytes, bool closeAfter) {
+         if (loop.inLoopThread()) {
+             complete(id, sequence, std::move(bytes), closeAfter);
+         } else {
+             loop.post([this, id, sequence, closeAfter, bytes = std::move(bytes)]() mutable {
+                 complete(id, sequence, std::move(bytes), closeAfter);
+             });
+         }
+     };
+ }
+
+ /**
+  * @brief Implementation of the complete method
+  *
+  * @param id Connection the request arrived on
+  * @param sequence Position of the request on that connection
+  * @param bytes Serialized response
+  * @param closeAfter Whether to close the connection after this response
+  */
+ void StreamServer::complete(std::uint64_t id, std::uint64_t sequence, std::string bytes, bool closeAfter) {
+     --inFlight;
+
+     // The client may have gone away while the request was being handled
+     auto it = connections.find(id);
+     if (it == connections.end()) {
+         return;
+     }
+     Connection& connection = *it->second;
+
+     Slot& slot = connection.slots[sequence - connection.firstSlot];
+     slot.ready = true;
+     slot.bytes = std::move(bytes);
+     slot.close = closeAfter;
+     process(connection);
+ }
+
+ /**
+  * @brief Implementation of the queueFinal method
+  *
+  * @param connection The connection to answer
+  * @param bytes Serialized response
+  */
+ void StreamServer::queueFinal(Connection& connection, std::string bytes) {
+     Slot slot;
+     slot.ready = true;
+     slot.bytes = std::move(bytes);
+     slot.close = true;
+     connection.slots.push_back(std::move(slot));
+     connection.closing = true;
+ }
+
+ /**
+  * @brief Implementation of the process method
+  *
+  * Moves finished responses to the output buffer in request order, parses
+  * further requests while the pipeline has room, sends what the socket
+  * accepts and updates the watched events. Handlers that respond inline
+  * re-enter through complete(); the guard turns that into a no-op and the
+  * outer call picks the response up.
+  *
+  * @param connection The connection to make progress on
+  */
+ void StreamServer::process(Connection& connection) {
+     if (connection.processing) {
+         return;
+     }
+     connection.processing = true;
+     for (;;) {
+         while (!connection.slots.empty() && connection.slots.front().ready) {
+             Slot& slot = connection.slots.front();
+             connection.out += slot.bytes;
+             if (slot.close) {
+                 connection.closing = true;
+             }
+             connection.slots.pop_front();
+             ++connection.firstSlot;
+         }
+
+         // A rejected request leaves a ready slot behind; go round once more for it
+         if ((connection.closing || connection.slots.size() >= maxPipelined || !parseOne(connection)) &&
+             (connection.slots.empty() || !connection.slots.front().ready)) {
+             break;
+         }
+     }
+     connection.processing = false;
+
+     // Drop parsed input once it is worth the copy
+     if (connection.inOffset == connection.in.size()) {
+         connection.in.clear();
+         connection.inOffset = 0;
+     } else if (connection.inOffset > kCompactThreshold) {
+         connection.in.erase(0, connection.inOffset);
+         connection.inOffset = 0;
+     }
+
+     while (connection.outOffset < connection.out.size()) {
+         ssize_t sent = send(connection.fd, connection.out.data() + connection.outOffset,
+                             connection.out.size() - connection.outOffset, MSG_NOSIGNAL);
+         if (sent > 0) {
+             connection.outOffset += static_cast<std::size_t>(sent);
+         } else if (sent < 0 && errno == EINTR) {
+             continue;
+         } else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+             break;
+         } else {
+             closeConnection(connection);
+             return;
+         }
+     }
+     if (connection.outOffset == connection.out.size()) {
+         connection.out.clear();
+         connection.outOffset = 0;
+     }
+     std::size_t pendingOutput = connection.out.size() - connection.outOffset;
+
+     if ((connection.closing || connection.peerClosed) && connection.slots.empty() && pendingOutput == 0) {
+         closeConnection(connection);
+         return;
+     }
+
+     std::uint32_t interest = 0;
+     if (!connection.closing && !connection.peerClosed &&
+         connection.slots.size() < maxPipelined && pendingOutput < kMaxPendingOutput) {
+         interest |= EPOLLIN;
+     }
+     if (pendingOutput > 0) {
+         interest |= EPOLLOUT;
+     }
+     if (interest != connection.interest) {
+         loop.modify(connection.fd, interest);
+         connection.interest = interest;
+     }
+ }
+
+ /**
+  * @brief Implementation of the closeConnection method
+  * @param connection The connection to close (destroyed by this call)
+  */
+ void StreamServer::closeConnection(Connection& connection) {
+     loop.remove(connection.fd);
+     close(connection.fd);
+     connections.erase(connection.id);
+ }
+
+ /**
+  * @brief Implementation of the shutdown method
+  */
+ void StreamServer::shutdown() {
+     if (listenFd >= 0) {
+         loop.remove(listenFd);
+         close(listenFd);
+         listenFd = -1;
+     }
+
+     // Completions may still be running on other threads; let them post back
+     while (inFlight > 0) {
+         loop.runOnce(10);
+     }
+
+     while (!connections.empty()) {
+         closeConnection(*connections.begin()->second);
+     }
+ }
@@ -0,0 +1,405 @@
+/**
+ * @file bench_compare.cpp
+ * @brief Compares two benchmark result files for significant changes
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains a command line tool that reads two JSON files written
+ * by `library_bench --json` (a baseline and a current run) and decides for
+ * every benchmark present in both whether it got faster, slower or only
+ * moved within the noise.
+ *
+ * The samples are the mean latencies of the timed repetitions
+ * (rep_mean_ns). A two-sided Mann-Whitney U test, which assumes nothing
+ * about their distribution, gives the p-value. The change is the
+ * Hodges-Lehmann estimate of the ratio current / baseline (the median of
+ * all pairwise ratios), and its confidence interval comes from the order
+ * statistics of those ratios at the U test's critical value. For small
+ * runs without ties the exact distribution of U is used, otherwise the
+ * normal approximation with tie correction.
+ */
+
+ #include <algorithm>
+ #include <cmath>
+ #include <cstdlib>
+ #include <fstream>
+ #include <iomanip>
+ #include <iostream>
+ #include <map>
+ #include <sstream>
+ #include <string>
+ #include <utility>
+ #include <vector>
+ #include <nlohmann/json.hpp>
+
+ using json = nlohmann::json;
+
+ namespace {
+
+ /// @brief Largest total number of samples for which U's exact distribution is computed
+ constexpr std::size_t kExactLimit = 60;
+
+ /**
+  * @struct Options
+  * @brief Command line settings
+  */
+ struct Options {
+     std::string baselinePath;
+     std::string currentPath;
+     double thresholdPercent = 5.0;  /// @brief Slowdowns past this (and significant) fail the run
+     double alpha = 0.05;            /// @brief Significance level; the intervals have confidence 1 - alpha
+     std::string filter;             /// @brief Only benchmarks whose name contains this
+ };
+
+ /// @brief Benchmark key: operation name (with thread and shard counts) and catalog size
+ using Key = std::pair<std::string, std::size_t>;
+
+ /**
+  * @struct Comparison
+  * @brief Outcome of comparing one benchmark
+  */
+ struct Comparison {
+     double baselineNs = 0;  /// @brief Median of the baseline repetitions
+     double currentNs = 0;   /// @brief Median of the current repetitions
+     double ratio = 1;       /// @brief Estimated current / baseline
+     double lower = 1;       /// @brief Lower confidence bound of the ratio
+     double upper = 1;       /// @brief Upper confidence bound of the ratio
+     double p = 1;           /// @brief Two-sided p-value
+ };
+
+ /**
+  * @brief Prints the command line usage to standard error
+  * @param program Name the program was started as
+  */
+ void printUsage(const char* program) {
+     std::cerr << "Usage: " << program << " <baseline.json> <current.json> [options]\n"
+               << "  --threshold <pct>   fail on significant slowdowns beyond pct percent (default 5)\n"
+               << "  --alpha <p>         significance level, intervals are (1-p) confidence (default 0.05)\n"
+               << "  --filter <text>     only benchmarks whose name contains <text>\n"
+               << "Exit status: 0 if nothing regressed, 1 on a regression, 2 on invalid input.\n";
+ }
+
+ /**
+  * @brief Parses the command line
+  *
+  * @param argc Number of arguments
+  * @param argv Arguments
+  * @param options Receives the settings
+  * @return false if the arguments are invalid
+  */
+ bool parseOptions(int argc, char* argv[], Options& options) {
+     if (argc < 3) {
+         return false;
+     }
+     options.baselinePath = argv[1];
+     options.currentPath = argv[2];
+     for (int i = 3; i < argc; ++i) {
+         std::string arg = argv[i];
+         if (i + 1 >= argc) {
+             return false;
+         }
+         std::string value = argv[++i];
+         if (arg == "--threshold") {
+             options.thresholdPercent = std::atof(value.c_str());
+         } else if (arg == "--alpha") {
+             options.alpha = std::atof(value.c_str());
+         } else if (arg == "--filter") {
+             options.filter = value;
+         } else {
+             return false;
+         }
+     }
+     return options.thresholdPercent >= 0 && options.alpha > 0 && options.alpha < 1;
+ }
+
+ /**
+  * @brief Reads the repetition means of every benchmark in a result file
+  *
+  * @param path Result file written by library_bench --json
+  * @param samples Receives the repetition means per benchmark
+  * @return false if the file cannot be read or is not a result file (reported to stderr)
+  */
+ bool readResults(const std::string& path, std::map<Key, std::vector<double>>& samples) {
+     std::ifstream file(path);
+     if (!file) {
+         std::cerr << "Cannot open " << path << std::endl;
+         return false;
+     }
+     try {
+         json document = json::parse(file);
+         for (const json& result : document.at("results")) {
+             // Concurrent runs are told apart by their thread and shard counts
+             std::string name = result.at("name").get<std::string>();
+             if (result.contains("threads")) {
+                 name += " x" + std::to_string(result["threads"].get<std::size_t>());
+             }
+             if (result.contains("shards")) {
+                 name += " " + std::to_string(result["shards"].get<std::size_t>()) + "sh";
+             }
+             Key key(name, result.at("size").get<std::size_t>());
+             samples[key] = result.at("rep_mean_ns").get<std::vector<double>>();
+         }
+     } catch (const json::exception& e) {
+         std::cerr << path << " is not a benchmark result file: " << e.what() << std::endl;
+         return false;
+     }
+     return true;
+ }
+
+ /**
+  * @brief Gets the median of samples
+  * @param values Samples (not empty)
+  * @return The median
+  */
+ double median(std::vector<double> values) {
+     std::sort(values.begin(), values.end());
+     std::size_t middle = values.size() / 2;
+     return values.size() % 2 == 1 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+ }
+
+ /**
+  * @brief Computes the exact null distribution of U
+  *
+  * The number of orderings of n and m samples with U = u is the
+  * coefficient of q^u in the Gaussian binomial [n+m choose n], built here
+  * as the product of (1 - q^(m+i)) / (1 - q^i) for i = 1..n.
+  *
+  * @param n Size of the first sample
+  * @param m Size of the second sample
+  * @return P(U <= u) for u = 0..n*m
+  */
+ std::vector<double> exactCdf(std::size_t n, std::size_t m) {
+     std::vector<double> counts(n * m + 1, 0.0);
+     counts[0] = 1;
+     for (std::size_t i = 1; i <= n; ++i) {
+         for (std::size_t u = counts.size() - 1; u >= m + i; --u) {
+             counts[u] -= counts[u - m - i];
+         }
+         for (std::size_t u = i; u < counts.size(); ++u) {
+             counts[u] += counts[u - i];
+         }
+     }
+     double total = 0;
+     for (double& count : counts) {
+         total += count;
+         count = total;
+     }
+     for (double& count : counts) {
+         count /= total;
+     }
+     return counts;
+ }
+
+ /**
+  * @brief Gets the standard normal upper tail probability
+  * @param z The value
+  * @return P(Z > z)
+  */
+ double normalTail(double z) {
+     return 0.5 * std::erfc(z / std::sqrt(2.0));
+ }
+
+ /**
+  * @brief Gets the standard normal quantile of an upper tail probability
+  * @param tail P(Z > z), in (0, 0.5]
+  * @return z
+  */
+ double normalQuantile(double tail) {
+     double low = 0;
+     double high = 40;
+     for (int i = 0; i < 100; ++i) {
+         double middle = (low + high) / 2;
+         (normalTail(middle) > tail ? low : high) = middle;
+     }
+     return (low + high) / 2;
+ }
+
+ /**
+  * @brief Compares the repetition means of one benchmark
+  *
+  * @param baseline Baseline samples (at least two)
+  * @param current Current samples (at least two)
+  * @param alpha Significance level
+  * @return The comparison
+  */
+ Comparison compare(const std::vector<double>& baseline, const std::vector<double>& current, double alpha) {
+     std::size_t n = baseline.size();
+     std::size_t m = current.size();
+
+     // Ranks of the pooled samples, ties sharing their mean rank
+     std::vector<std::pair<double, bool>> pooled;
+     for (double value : baseline) {
+         pooled.emplace_back(value, false);
+     }
+     for (double value : current) {
+         pooled.emplace_back(value, true);
+     }
+     std::sort(pooled.begin(), pooled.end());
+     double currentRanks = 0;
+     double tieTerm = 0;
+     for (std::size_t i = 0; i < pooled.size();) {
+         std::size_t j = i;
+         while (j < pooled.size() && pooled[j].first == pooled[i].first) {
+             ++j;
+         }
+         double rank = static_cast<double>(i + j + 1) / 2;
+         for (std::size_t k = i; k < j; ++k) {
+             if (pooled[k].second) {
+                 currentRanks += rank;
+             }
+         }
+         double tied = static_cast<double>(j - i);
+         tieTerm += tied * tied * tied - tied;
+         i = j;
+     }
+
+     double nm = static_cast<double>(n * m);
+     double u = currentRanks - static_cast<double>(m * (m + 1)) / 2;
+     double smallerU = std::min(u, nm - u);
+
+     Comparison result;
+     // Number of pairwise ratios cut off each end of the confidence interval
+     std::size_t cut = 0;
+     if (tieTerm == 0 && n + m <= kExactLimit) {
+         std::vector<double> cdf = exactCdf(n, m);
+         result.p = std::min(1.0, 2 * cdf[static_cast<std::size_t>(smallerU)]);
+         while (cut < cdf.size() && cdf[cut] <= alpha / 2) {
+             ++cut;
+         }
+     } else {
+         double total = static_cast<double>(n + m);
+         double sigma = std::sqrt(nm / 12 * ((total + 1) - tieTerm / (total * (total - 1))));
+         double z = sigma > 0 ? std::max(0.0, std::fabs(u - nm / 2) - 0.5) / sigma : 0;
+         result.p = std::min(1.0, 2 * normalTail(z));
+         double critical = std::floor(nm / 2 - normalQuantile(alpha / 2) * sigma);
+         cut = critical > 0 ? static_cast<std::size_t>(critical) : 0;
+     }
+
+     // Hodges-Lehmann estimate on the log scale, so the change is a ratio
+     std::vector<double> logRatios;
+     logRatios.reserve(n * m);
+     for (double b : baseline) {
+         for (double c : current) {
+             logRatios.push_back(std::log(c) - std::log(b));
+         }
+     }
+     std::sort(logRatios.begin(), logRatios.end());
+     cut = std::min(cut, (logRatios.size() - 1) / 2);
+     result.ratio = std::exp(median(logRatios));
+     result.lower = std::exp(logRatios[cut]);
+     result.upper = std::exp(logRatios[logRatios.size() - 1 - cut]);
+     result.baselineNs = median(baseline);
+     result.currentNs = median(current);
+     return result;
+ }
+
+ /**
+  * @brief Formats a duration with a fitting unit
+  * @param ns Nanoseconds
+  * @return e.g. "1.70 ms"
+  */
+ std::string formatDuration(double ns) {
+     std::ostringstream out;
+     out << std::fixed << std::setprecision(2);
+     if (ns >= 1e9) {
+         out << ns / 1e9 << " s";
+     } else if (ns >= 1e6) {
+         out << ns / 1e6 << " ms";
+     } else if (ns >= 1e3) {
+         out << ns / 1e3 << " us";
+     } else {
+         out << ns << " ns";
+     }
+     return out.str();
+ }
+
+ /**
+  * @brief Formats a ratio as a signed percentage change
+  * @param ratio current / baseline
+  * @return e.g. "+2.9%"
+  */
+ std::string formatChange(double ratio) {
+     std::ostringstream out;
+     out << std::showpos << std::fixed << std::setprecision(1) << (ratio - 1) * 100 << "%";
+     return out.str();
+ }
+
+ } // namespace
+
+ /**
+  * @brief Entry point of the benchmark comparator
+  *
+  * @param argc Number of command line arguments
+  * @param argv Command line arguments
+  * @return 0 if no benchmark regressed, 1 if one regressed significantly
+  *         beyond the threshold, 2 on invalid arguments or unreadable files
+  */
+ int main(int argc, char* argv[]) {
+     Options options;
+     if (!parseOptions(argc, argv, options)) {
+         printUsage(argv[0]);
+         return 2;
+     }
+
+     std::map<Key, std::vector<double>> baseline;
+     std::map<Key, std::vector<double>> current;
+     if (!readResults(options.baselinePath, baseline) || !readResults(options.currentPath, current)) {
+         return 2;
+     }
+
+     std::ostringstream confidence;
+     confidence << (1 - options.alpha) * 100 << "% CI";
+     std::cout << std::left << std::setw(32) << "benchmark" << std::right << std::setw(10) << "size"
+               << std::setw(12) << "baseline" << std::setw(12) << "current" << std::setw(10) << "change"
+               << std::setw(20) << confidence.str() << std::setw(9) << "p" << "  verdict\n";
+
+     std::size_t regressions = 0;
+     for (const auto& [key, currentSamples] : current) {
+         const auto& [name, size] = key;
+         if (name.find(options.filter) == std::string::npos) {
+             continue;
+         }
+         auto found = baseline.find(key);
+         if (found == baseline.end()) {
+             std::cout << std::left << std::setw(32) << name << std::right << std::setw(10) << size
+                       << "  not in the baseline\n";
+             continue;
+         }
+         if (found->second.size() < 2 || currentSamples.size() < 2) {
+             std::cout << std::left << std::setw(32) << name << std::right << std::setw(10) << size
+                       << "  too few repetitions to compare (run with --reps 5 or more)\n";
+             continue;
+         }
+
+         Comparison result = compare(found->second, currentSamples, options.alpha);
+         bool significant = result.p < options.alpha;
+         const char* verdict = "noise";
+         if (significant && (result.ratio - 1) * 100 > options.thresholdPercent) {
+             verdict = "REGRESSION";
+             ++regressions;
+         } else if (significant) {
+             verdict = result.ratio > 1 ? "slower" : "faster";
+         }
+
+         std::cout << std::left << std::setw(32) << name << std::right << std::setw(10) << size
+                   << std::setw(12) << formatDuration(result.baselineNs)
+                   << std::setw(12) << formatDuration(result.currentNs)
+                   << std::setw(10) << formatChange(result.ratio)
+                   << std::setw(20) << ("[" + formatChange(result.lower) + ", " + formatChange(result.upper) + "]")
+                   << std::setw(9) << std::fixed << std::setprecision(3) << result.p << std::defaultfloat
+                   << "  " << verdict << "\n";
+     }
+     for (const auto& [key, samples] : baseline) {
+         if (key.first.find(options.filter) != std::string::npos && current.find(key) == current.end()) {
+             std::cout << std::left << std::setw(32) << key.first << std::right << std::setw(10) << key.second
+                       << "  not in the current run\n";
+         }
+     }
+
+     if (regressions > 0) {
+         std::cerr << regressions << " benchmark(s) slower by more than " << options.thresholdPercent
+                   << "% (p < " << options.alpha << ")" << std::endl;
+         return 1;
+     }
+     return 0;
+ }
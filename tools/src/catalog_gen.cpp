@@ -0,0 +1,333 @@
+/**
+ * @file catalog_gen.cpp
+ * @brief Generator of large synthetic catalogs
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains a command line tool that writes a catalog of any
+ * size in one of the export formats, including the books.json layout the
+ * program loads. The books are meant to look like a real collection to
+ * the code under test rather than to a reader:
+ *
+ * - authors are drawn from a Zipf distribution, so a few write many
+ *   books and most write one or two;
+ * - titles have one to a dozen words, mostly two to five, with the
+ *   occasional article or subtitle, and some words and names are not
+ *   ASCII;
+ * - publication years lean towards the present;
+ * - a configurable fraction of the books is borrowed.
+ *
+ * The output depends only on the options, so a seed reproduces a file
+ * exactly. Books are streamed through Export::Writer one at a time, so
+ * memory use depends on the number of authors, not on the number of books.
+ */
+
+ #include <algorithm>
+ #include <array>
+ #include <chrono>
+ #include <cmath>
+ #include <cstdint>
+ #include <cstdlib>
+ #include <fstream>
+ #include <iostream>
+ #include <memory>
+ #include <string>
+ #include <vector>
+ #include "Export.hpp"
+
+ using Clock = std::chrono::steady_clock;
+
+ namespace {
+
+ /// @brief Words titles are made of; a few of them are not ASCII
+ const std::array<const char*, 96> kWords = {
+     "Silent", "River", "Empire", "Shadow", "Garden", "Winter", "Glass", "Stone",
+     "Night", "House", "Secret", "Song", "Iron", "Crown", "Mirror", "Harbor",
+     "Light", "Storm", "Forest", "Ashes", "Memory", "Salt", "Bridge", "Island",
+     "Fire", "Daughter", "Kingdom", "Letters", "Summer", "Road", "Wind", "Blood",
+     "Dreams", "Orchard", "Lantern", "Tide", "Mountain", "Hunger", "Clockwork", "Sparrow",
+     "Silver", "Last", "First", "Lost", "Broken", "Hidden", "Northern", "Golden",
+     "Quiet", "Burning", "Endless", "Forgotten", "Little", "Great", "Dark", "Wild",
+     "Time", "War", "Peace", "Love", "Death", "Life", "Sea", "Sky",
+     "City", "Machine", "Journey", "History", "Theory", "Atlas", "Guide", "Chronicle",
+     "Café", "Mañana", "Über", "Straße", "Kyōto", "Noël", "Søren", "Ångström",
+     "Москва", "Зима", "Ελλάδα", "Θάλασσα", "東京", "夜", "서울", "Señora",
+     "Déjà", "Vu", "Naïve", "Façade", "Jalapeño", "Fjörd", "Zürich", "Crème"
+ };
+
+ /// @brief Joining words placed between title words
+ const std::array<const char*, 8> kJoiners = {"of", "and", "in", "the", "under", "for", "at", "without"};
+
+ /// @brief Given names of authors
+ const std::array<const char*, 48> kFirstNames = {
+     "James", "Mary", "John", "Patricia", "Robert", "Jennifer", "Michael", "Linda",
+     "William", "Elizabeth", "David", "Barbara", "Richard", "Susan", "Joseph", "Jessica",
+     "Thomas", "Sarah", "Charles", "Karen", "Daniel", "Nancy", "Matthew", "Lisa",
+     "Anthony", "Margaret", "Mark", "Sandra", "Paul", "Ashley", "Steven", "Emily",
+     "José", "Zoë", "Björn", "Chloé", "Jürgen", "Renée", "Søren", "Łukasz",
+     "Анна", "Иван", "Γιώργος", "Ελένη", "健", "美咲", "민준", "Siobhán"
+ };
+
+ /// @brief Family names of authors
+ const std::array<const char*, 48> kLastNames = {
+     "Smith", "Johnson", "Williams", "Brown", "Jones", "Garcia", "Miller", "Davis",
+     "Rodriguez", "Martinez", "Hernandez", "Lopez", "Wilson", "Anderson", "Thomas", "Taylor",
+     "Moore", "Jackson", "Martin", "Lee", "Thompson", "White", "Harris", "Clark",
+     "Lewis", "Robinson", "Walker", "Young", "Allen", "King", "Wright", "Scott",
+     "Müller", "Núñez", "Øvergaard", "Dvořák", "Šimić", "Gonçalves", "Sørensen", "Kowalczyk",
+     "Иванов", "Петрова", "Παπαδόπουλος", "Νικολάου", "山田", "佐藤", "김", "Ó Briain"
+ };
+
+ /**
+  * @struct Options
+  * @brief Command line settings
+  */
+ struct Options {
+     long long books = 0;            /// @brief Books to write
+     std::uint64_t seed = 1;         /// @brief Seed of the random generator
+     double borrowed = 0.1;          /// @brief Fraction of books that are borrowed
+     long long authors = 0;          /// @brief Distinct authors (default books / 8)
+     double zipf = 1.07;             /// @brief Exponent of the author popularity
+     std::string format = "json";    /// @brief json, jsonl or csv
+     std::string out = "-";          /// @brief Output file, "-" for standard output
+ };
+
+ /**
+  * @class Random
+  * @brief Small deterministic generator (SplitMix64)
+  *
+  * The standard distributions are not required to give the same values
+  * on every standard library, so the few that are needed live here.
+  */
+ class Random {
+ public:
+     explicit Random(std::uint64_t seed) : state(seed) {}
+
+     /// @brief Next 64 random bits
+     std::uint64_t next() {
+         std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+         z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+         z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+         return z ^ (z >> 31);
+     }
+
+     /// @brief Uniform number in [0, 1)
+     double unit() {
+         return static_cast<double>(next() >> 11) * 0x1.0p-53;
+     }
+
+     /// @brief Uniform index in [0, n)
+     std::size_t below(std::size_t n) {
+         return static_cast<std::size_t>(next() % n);
+     }
+
+ private:
+     std::uint64_t state;
+ };
+
+ /**
+  * @brief Prints the command line usage to standard error
+  * @param program Name the program was started as
+  */
+ void printUsage(const char* program) {
+     std::cerr << "Usage: " << program << " --books <n> [options]\n"
+               << "  --seed <n>        random seed (default 1)\n"
+               << "  --borrowed <r>    fraction of borrowed books, 0..1 (default 0.1)\n"
+               << "  --authors <n>     distinct authors (default books / 8)\n"
+               << "  --zipf <s>        author popularity exponent (default 1.07)\n"
+               << "  --format <kind>   json | jsonl | csv (default json, the data file layout)\n"
+               << "  --out <file>      output file, - for standard output (default -)\n";
+ }
+
+ /**
+  * @brief Parses the command line
+  *
+  * @param argc Number of arguments
+  * @param argv Arguments
+  * @param options Receives the settings
+  * @return false if the arguments are invalid
+  */
+ bool parseOptions(int argc, char* argv[], Options& options) {
+     for (int i = 1; i < argc; ++i) {
+         std::string arg = argv[i];
+         if (i + 1 >= argc) {
+             return false;
+         }
+         std::string value = argv[++i];
+         if (arg == "--books") {
+             options.books = std::atoll(value.c_str());
+         } else if (arg == "--seed") {
+             options.seed = std::strtoull(value.c_str(), nullptr, 10);
+         } else if (arg == "--borrowed") {
+             options.borrowed = std::atof(value.c_str());
+         } else if (arg == "--authors") {
+             options.authors = std::atoll(value.c_str());
+         } else if (arg == "--zipf") {
+             options.zipf = std::atof(value.c_str());
+         } else if (arg == "--format") {
+             options.format = value;
+         } else if (arg == "--out") {
+             options.out = value;
+         } else {
+             return false;
+         }
+     }
+     if (options.authors == 0) {
+         options.authors = std::max(1LL, options.books / 8);
+     }
+     // IDs are ints in the data file
+     return options.books > 0 && options.books <= 2000000000LL && options.authors > 0 &&
+            options.borrowed >= 0 && options.borrowed <= 1 && options.zipf > 0;
+ }
+
+ /**
+  * @brief Builds the cumulative Zipf distribution over author ranks
+  *
+  * @param authors Number of authors
+  * @param exponent Zipf exponent
+  * @return Cumulative probability of ranks 1..authors, ending at 1
+  */
+ std::vector<double> zipfTable(long long authors, double exponent) {
+     std::vector<double> cumulative(static_cast<std::size_t>(authors));
+     double sum = 0;
+     for (std::size_t rank = 0; rank < cumulative.size(); ++rank) {
+         sum += 1.0 / std::pow(static_cast<double>(rank + 1), exponent);
+         cumulative[rank] = sum;
+     }
+     for (double& value : cumulative) {
+         value /= sum;
+     }
+     return cumulative;
+ }
+
+ /**
+  * @brief Builds the name of an author
+  *
+  * The name depends only on the rank and the seed, so every book of an
+  * author carries the same name.
+  *
+  * @param rank Author rank
+  * @param seed Seed of the run
+  * @return Name such as "Mary K. Sørensen"
+  */
+ std::string authorName(std::size_t rank, std::uint64_t seed) {
+     Random random(seed ^ (0xA5A5A5A5ull + rank * 0x100000001B3ull));
+     std::string name = kFirstNames[random.below(kFirstNames.size())];
+     name += ' ';
+     name += static_cast<char>('A' + random.below(26));
+     name += ". ";
+     name += kLastNames[random.below(kLastNames.size())];
+     return name;
+ }
+
+ /**
+  * @brief Builds a random title
+  *
+  * Word counts follow a geometric distribution (mostly two to five
+  * words, up to twelve); some titles start with "The" and about one in
+  * eight has a subtitle.
+  *
+  * @param random Generator
+  * @param title Receives the title
+  */
+ void makeTitle(Random& random, std::string& title) {
+     title.clear();
+     if (random.unit() < 0.25) {
+         title = "The ";
+     }
+     std::size_t words = 1;
+     while (words < 12 && random.unit() < 0.65) {
+         ++words;
+     }
+     for (std::size_t i = 0; i < words; ++i) {
+         if (i > 0) {
+             title += ' ';
+             if (random.unit() < 0.2) {
+                 title += kJoiners[random.below(kJoiners.size())];
+                 title += ' ';
+             }
+         }
+         title += kWords[random.below(kWords.size())];
+     }
+     if (random.unit() < 0.125) {
+         title += ": A ";
+         title += kWords[random.below(kWords.size())];
+         title += ' ';
+         title += kWords[random.below(kWords.size())];
+     }
+ }
+
+ /**
+  * @brief Picks a publication year, mostly recent
+  * @param random Generator
+  * @return Year between 1450 and 2025
+  */
+ int makeYear(Random& random) {
+     // Exponential age with a mean of 30 years
+     double age = -30.0 * std::log(1.0 - random.unit());
+     return std::max(1450, 2025 - static_cast<int>(age));
+ }
+
+ } // namespace
+
+ /**
+  * @brief Entry point of the catalog generator
+  *
+  * @param argc Number of command line arguments
+  * @param argv Command line arguments
+  * @return 0 on success, 1 on invalid arguments or if the output could not be written
+  */
+ int main(int argc, char* argv[]) {
+     Options options;
+     Export::Format format;
+     if (!parseOptions(argc, argv, options) || !Export::parseFormat(options.format, format)) {
+         printUsage(argv[0]);
+         return 1;
+     }
+
+     std::unique_ptr<std::ofstream> file;
+     if (options.out != "-") {
+         file = std::make_unique<std::ofstream>(options.out, std::ios::binary | std::ios::trunc);
+         if (!*file) {
+             std::cerr << "Error opening " << options.out << " for writing" << std::endl;
+             return 1;
+         }
+     } else {
+         std::ios::sync_with_stdio(false);
+     }
+     std::ostream& out = file ? static_cast<std::ostream&>(*file) : std::cout;
+
+     Clock::time_point start = Clock::now();
+     std::vector<double> popularity = zipfTable(options.authors, options.zipf);
+     std::vector<std::string> names(popularity.size());
+     Random random(options.seed);
+     std::string title;
+
+     {
+         Export::Writer writer(out, format);
+         for (long long id = 1; id <= options.books; ++id) {
+             std::size_t rank = static_cast<std::size_t>(
+                 std::upper_bound(popularity.begin(), popularity.end(), random.unit()) - popularity.begin());
+             rank = std::min(rank, popularity.size() - 1);
+             // Names are built on first use; most authors of a small catalog never appear
+             if (names[rank].empty()) {
+                 names[rank] = authorName(rank, options.seed);
+             }
+
+             makeTitle(random, title);
+             Book book(static_cast<int>(id), title, names[rank], makeYear(random));
+             book.setAvailable(random.unit() >= options.borrowed);
+             writer.write(book);
+         }
+         writer.finish();
+     }
+
+     if (!out) {
+         std::cerr << "Error writing " << (file ? options.out : std::string("standard output")) << std::endl;
+         return 1;
+     }
+     double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+     std::cerr << "Wrote " << options.books << " books by " << options.authors << " authors in "
+               << seconds << " s" << std::endl;
+     return 0;
+ }
@@ -0,0 +1,292 @@
+/**
+ * @file loadgen.cpp
+ * @brief Load generator for the binary protocol server
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains a command line tool that drives a running
+ * `library_management_system --socket <path>` with pipelined requests from
+ * several connections and reports throughput and latency percentiles.
+ *
+ * Each connection repeatedly sends a window of --depth requests in one
+ * write and then waits for all their responses; the latency of a request
+ * is measured from the send of its window to the arrival of its response.
+ */
+
+ #include <algorithm>
+ #include <chrono>
+ #include <cstdint>
+ #include <cstdlib>
+ #include <iomanip>
+ #include <iostream>
+ #include <random>
+ #include <string>
+ #include <thread>
+ #include <vector>
+ #include "BinaryClient.hpp"
+
+ using BinaryProtocol::Op;
+ using BinaryProtocol::Request;
+ using BinaryProtocol::Response;
+ using BinaryProtocol::Status;
+ using Clock = std::chrono::steady_clock;
+
+ namespace {
+
+ /**
+  * @struct Options
+  * @brief Command line settings
+  */
+ struct Options {
+     std::string socketPath;
+     int threads = 4;           /// @brief Connections, one thread each
+     int depth = 16;            /// @brief Requests in flight per connection
+     double duration = 5.0;     /// @brief Seconds to run
+     std::string mix = "find";  /// @brief find, borrow or mixed
+     int ids = 1000;            /// @brief Requests target IDs 1..ids
+     int preload = 0;           /// @brief Books to add before the run
+ };
+
+ /**
+  * @struct Results
+  * @brief What one connection observed
+  */
+ struct Results {
+     std::vector<std::uint64_t> latencies;  /// @brief Nanoseconds per request
+     std::uint64_t statuses[5] = {};        /// @brief Responses per Status value
+     bool failed = false;                   /// @brief The connection broke
+ };
+
+ /**
+  * @brief Prints the command line usage to standard error
+  * @param program Name the program was started as
+  */
+ void printUsage(const char* program) {
+     std::cerr << "Usage: " << program << " --socket <path> [options]\n"
+               << "  --threads <n>     connections, one thread each (default 4)\n"
+               << "  --depth <n>       pipelined requests per connection (default 16)\n"
+               << "  --duration <s>    seconds to run (default 5)\n"
+               << "  --mix <kind>      find | borrow | mixed (default find)\n"
+               << "  --ids <n>         target book IDs 1..n (default 1000)\n"
+               << "  --preload <n>     add n books before the run (default 0)\n";
+ }
+
+ /**
+  * @brief Parses the command line
+  *
+  * @param argc Number of arguments
+  * @param argv Arguments
+  * @param options Receives the settings
+  * @return false if the arguments are invalid
+  */
+ bool parseOptions(int argc, char* argv[], Options& options) {
+     for (int i = 1; i < argc; ++i) {
+         std::string arg = argv[i];
+         if (i + 1 >= argc) {
+             return false;
+         }
+         std::string value = argv[++i];
+         if (arg == "--socket") {
+             options.socketPath = value;
+         } else if (arg == "--threads") {
+             options.threads = std::atoi(value.c_str());
+         } else if (arg == "--depth") {
+             options.depth = std::atoi(value.c_str());
+         } else if (arg == "--duration") {
+             options.duration = std::atof(value.c_str());
+         } else if (arg == "--mix") {
+             options.mix = value;
+         } else if (arg == "--ids") {
+             options.ids = std::atoi(value.c_str());
+         } else if (arg == "--preload") {
+             options.preload = std::atoi(value.c_str());
+         } else {
+             return false;
+         }
+     }
+     return !options.socketPath.empty() && options.threads > 0 && options.depth > 0 &&
+            options.depth <= 512 && options.duration > 0 && options.ids > 0 &&
+            (options.mix == "find" || options.mix == "borrow" || options.mix == "mixed");
+ }
+
+ /**
+  * @brief Adds books through the server in pipelined batches
+  *
+  * @param options Command line settings
+  * @return false if the connection failed
+  */
+ bool preload(const Options& options) {
+     BinaryClient client;
+     if (!client.connect(options.socketPath)) {
+         return false;
+     }
+
+     for (int done = 0; done < options.preload;) {
+         int batch = std::min(256, options.preload - done);
+         for (int i = 0; i < batch; ++i) {
+             Request request;
+             request.op = Op::Add;
+             request.tag = static_cast<std::uint32_t>(done + i);
+             request.title = "Load test book " + std::to_string(done + i);
+             request.author = "Author " + std::to_string((done + i) % 100);
+             request.year = 1900 + (done + i) % 125;
+             client.queue(request);
+         }
+         if (!client.flush()) {
+             return false;
+         }
+         Response response;
+         for (int i = 0; i < batch; ++i) {
+             if (!client.receive(response)) {
+                 return false;
+             }
+         }
+         done += batch;
+     }
+     return true;
+ }
+
+ /**
+  * @brief Runs one connection until the deadline
+  *
+  * @param options Command line settings
+  * @param seed Seed of this connection's random generator
+  * @param deadline When to stop sending
+  * @param results Receives the observations
+  */
+ void runConnection(const Options& options, unsigned seed, Clock::time_point deadline, Results& results) {
+     BinaryClient client;
+     if (!client.connect(options.socketPath)) {
+         results.failed = true;
+         return;
+     }
+
+     std::mt19937 random(seed);
+     std::uniform_int_distribution<int> pickId(1, options.ids);
+     std::uniform_int_distribution<int> pickPercent(0, 99);
+     std::uint32_t tag = 0;
+     bool borrowNext = true;
+
+     while (Clock::now() < deadline) {
+         for (int i = 0; i < options.depth; ++i) {
+             Request request;
+             request.tag = tag++;
+             request.id = pickId(random);
+
+             if (options.mix == "find") {
+                 request.op = Op::FindById;
+             } else if (options.mix == "borrow") {
+                 request.op = borrowNext ? Op::Borrow : Op::Return;
+                 borrowNext = !borrowNext;
+             } else {
+                 int percent = pickPercent(random);
+                 request.op = percent < 90 ? Op::FindById : percent < 95 ? Op::Borrow : Op::Return;
+             }
+             client.queue(request);
+         }
+
+         Clock::time_point sent = Clock::now();
+         if (!client.flush()) {
+             results.failed = true;
+             return;
+         }
+
+         Response response;
+         for (int i = 0; i < options.depth; ++i) {
+             if (!client.receive(response)) {
+                 results.failed = true;
+                 return;
+             }
+             auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - sent);
+             results.latencies.push_back(static_cast<std::uint64_t>(elapsed.count()));
+             std::size_t status = static_cast<std::size_t>(response.status);
+             if (status < 5) {
+                 ++results.statuses[status];
+             }
+         }
+     }
+ }
+
+ /**
+  * @brief Gets a percentile of sorted samples
+  *
+  * @param sorted Samples in ascending order (not empty)
+  * @param fraction Percentile as a fraction, e.g. 0.99
+  * @return The sample at that rank, in microseconds
+  */
+ double percentileMicros(const std::vector<std::uint64_t>& sorted, double fraction) {
+     std::size_t rank = static_cast<std::size_t>(fraction * static_cast<double>(sorted.size() - 1));
+     return static_cast<double>(sorted[rank]) / 1000.0;
+ }
+
+ } // namespace
+
+ /**
+  * @brief Entry point of the load generator
+  *
+  * @param argc Number of command line arguments
+  * @param argv Command line arguments
+  * @return 0 on success, 1 on invalid arguments or connection failures
+  */
+ int main(int argc, char* argv[]) {
+     Options options;
+     if (!parseOptions(argc, argv, options)) {
+         printUsage(argv[0]);
+         return 1;
+     }
+
+     if (options.preload > 0 && !preload(options)) {
+         std::cerr << "Preloading failed" << std::endl;
+         return 1;
+     }
+
+     std::vector<Results> results(static_cast<std::size_t>(options.threads));
+     std::vector<std::thread> threads;
+     Clock::time_point start = Clock::now();
+     Clock::time_point deadline = start + std::chrono::duration_cast<Clock::duration>(
+         std::chrono::duration<double>(options.duration));
+     for (int i = 0; i < options.threads; ++i) {
+         threads.emplace_back(runConnection, std::cref(options), 12345u + static_cast<unsigned>(i), deadline,
+                              std::ref(results[static_cast<std::size_t>(i)]));
+     }
+     for (auto& thread : threads) {
+         thread.join();
+     }
+     double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+     // Merge the per-connection observations
+     std::vector<std::uint64_t> latencies;
+     std::uint64_t statuses[5] = {};
+     bool failed = false;
+     for (const Results& result : results) {
+         latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+         for (std::size_t i = 0; i < 5; ++i) {
+             statuses[i] += result.statuses[i];
+         }
+         failed = failed || result.failed;
+     }
+     if (latencies.empty()) {
+         std::cerr << "No requests completed" << std::endl;
+         return 1;
+     }
+     std::sort(latencies.begin(), latencies.end());
+
+     std::cout << std::fixed << std::setprecision(1)
+               << "requests:   " << latencies.size() << " in " << seconds << " s ("
+               << options.threads << " connections, depth " << options.depth << ", mix " << options.mix << ")\n"
+               << "throughput: " << static_cast<double>(latencies.size()) / seconds << " ops/s\n"
+               << "latency us: p50 " << percentileMicros(latencies, 0.50)
+               << "  p90 " << percentileMicros(latencies, 0.90)
+               << "  p99 " << percentileMicros(latencies, 0.99)
+               << "  p99.9 " << percentileMicros(latencies, 0.999)
+               << "  max " << static_cast<double>(latencies.back()) / 1000.0 << "\n"
+               << "statuses:   ok " << statuses[0] << "  not-found " << statuses[1]
+               << "  conflict " << statuses[2] << "  bad-request " << statuses[3]
+               << "  failed " << statuses[4] << "\n";
+
+     if (failed) {
+         std::cerr << "Some connections failed" << std::endl;
+         return 1;
+     }
+     return 0;
+ }
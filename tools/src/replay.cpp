@@ -0,0 +1,332 @@
+/**
+ * @file replay.cpp
+ * @brief Replays a recorded workload trace against a fresh Library
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains a command line tool that reads a trace written with
+ * `library_management_system --record <trace>` (see Trace.hpp), drives a
+ * new Library with the same calls from several threads and reports the
+ * latency distribution of every operation.
+ *
+ * In open-loop mode every call is issued at its recorded time (divided by
+ * --speed), whether or not earlier calls have finished; its latency is
+ * measured from that scheduled time, so queueing behind slow calls counts
+ * the way it would for a real client. In closed-loop mode the threads
+ * issue the calls back to back as fast as the library answers, which
+ * measures capacity rather than response under the recorded load.
+ */
+
+ #include <algorithm>
+ #include <atomic>
+ #include <chrono>
+ #include <cstdint>
+ #include <cstdlib>
+ #include <filesystem>
+ #include <iomanip>
+ #include <iostream>
+ #include <memory>
+ #include <string>
+ #include <thread>
+ #include <unistd.h>
+ #include <vector>
+ #include "Library.hpp"
+ #include "Trace.hpp"
+
+ using Clock = std::chrono::steady_clock;
+ using Trace::Call;
+ using Trace::Op;
+
+ namespace {
+
+ /**
+  * @struct Options
+  * @brief Command line settings
+  */
+ struct Options {
+     std::string tracePath;
+     std::string dataFile;          /// @brief Catalog to start from (empty library if none)
+     std::string mode = "open";     /// @brief open or closed
+     double speed = 1.0;            /// @brief Open loop: recorded time is divided by this
+     int threads = 4;               /// @brief Threads issuing calls
+     std::size_t shards = 1;        /// @brief Shards of the replayed library
+     bool autoSave = true;          /// @brief Write the data file after every change
+ };
+
+ /**
+  * @struct Results
+  * @brief What one thread observed
+  */
+ struct Results {
+     std::vector<std::uint64_t> latencies[Trace::kOpCount + 1];  /// @brief Nanoseconds, indexed by Op
+     std::uint64_t misses[Trace::kOpCount + 1] = {};            /// @brief Calls that returned false or nothing
+     std::uint64_t maxLateNs = 0;                               /// @brief Open loop: worst start delay
+ };
+
+ /**
+  * @brief Prints the command line usage to standard error
+  * @param program Name the program was started as
+  */
+ void printUsage(const char* program) {
+     std::cerr << "Usage: " << program << " <trace> [options]\n"
+               << "  --data <file>     catalog to start from, as when recording began (copied first;\n"
+               << "                    default: an empty library)\n"
+               << "  --mode <mode>     open | closed (default open)\n"
+               << "  --speed <x>       open loop: replay x times faster than recorded (default 1)\n"
+               << "  --threads <n>     threads issuing calls (default 4)\n"
+               << "  --shards <n>      library shards (default 1)\n"
+               << "  --autosave <on|off> write the data file after every change (default on)\n";
+ }
+
+ /**
+  * @brief Parses the command line
+  *
+  * @param argc Number of arguments
+  * @param argv Arguments
+  * @param options Receives the settings
+  * @return false if the arguments are invalid
+  */
+ bool parseOptions(int argc, char* argv[], Options& options) {
+     if (argc < 2) {
+         return false;
+     }
+     options.tracePath = argv[1];
+     for (int i = 2; i < argc; ++i) {
+         std::string arg = argv[i];
+         if (i + 1 >= argc) {
+             return false;
+         }
+         std::string value = argv[++i];
+         if (arg == "--data") {
+             options.dataFile = value;
+         } else if (arg == "--mode") {
+             options.mode = value;
+         } else if (arg == "--speed") {
+             options.speed = std::atof(value.c_str());
+         } else if (arg == "--threads") {
+             options.threads = std::atoi(value.c_str());
+         } else if (arg == "--shards") {
+             options.shards = static_cast<std::size_t>(std::atol(value.c_str()));
+         } else if (arg == "--autosave") {
+             if (value != "on" && value != "off") {
+                 return false;
+             }
+             options.autoSave = value == "on";
+         } else {
+             return false;
+         }
+     }
+     return (options.mode == "open" || options.mode == "closed") && options.speed > 0 &&
+            options.threads > 0 && options.shards > 0;
+ }
+
+ /**
+  * @brief Issues one recorded call
+  *
+  * @param library The library under test
+  * @param call The call
+  * @return true if the call succeeded or found something
+  */
+ bool execute(Library& library, const Call& call) {
+     switch (call.op) {
+         case Op::Add:
+             return library.addBook(call.title, call.author, call.year) > 0;
+         case Op::Remove:
+             return library.removeBook(call.id);
+         case Op::FindById:
+             return library.findBookById(call.id).has_value();
+         case Op::FindByTitle:
+             return !library.findBooksByTitle(call.title).empty();
+         case Op::FindByAuthor:
+             return !library.findBooksByAuthor(call.author).empty();
+         case Op::Borrow:
+             return library.borrowBook(call.id);
+         case Op::Return:
+             return library.returnBook(call.id);
+         case Op::Update:
+             return library.updateBook(call.id, call.version, call.title, call.author, call.year) ==
+                    UpdateResult::Updated;
+         case Op::BorrowMany:
+             return library.borrowBooks(call.ids);
+         case Op::ReturnMany:
+             return library.returnBooks(call.ids);
+     }
+     return false;
+ }
+
+ /**
+  * @brief Runs one replay thread until the trace is exhausted
+  *
+  * Threads take the calls in recorded order from a shared counter.
+  *
+  * @param library The library under test
+  * @param calls The trace
+  * @param options Command line settings
+  * @param start Time the replay started
+  * @param next Index of the next call to issue
+  * @param results Receives the observations
+  */
+ void runThread(Library& library, const std::vector<Call>& calls, const Options& options,
+                Clock::time_point start, std::atomic<std::size_t>& next, Results& results) {
+     bool openLoop = options.mode == "open";
+     for (std::size_t i = next.fetch_add(1); i < calls.size(); i = next.fetch_add(1)) {
+         const Call& call = calls[i];
+         Clock::time_point begin = Clock::now();
+         if (openLoop) {
+             Clock::time_point scheduled = start + std::chrono::nanoseconds(
+                 static_cast<std::int64_t>(static_cast<double>(call.timeNs) / options.speed));
+             if (scheduled > begin) {
+                 std::this_thread::sleep_until(scheduled);
+             } else {
+                 auto late = std::chrono::duration_cast<std::chrono::nanoseconds>(begin - scheduled);
+                 results.maxLateNs = std::max(results.maxLateNs, static_cast<std::uint64_t>(late.count()));
+             }
+             begin = scheduled;
+         }
+
+         bool succeeded = execute(library, call);
+         auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin);
+
+         std::size_t op = static_cast<std::size_t>(call.op);
+         results.latencies[op].push_back(static_cast<std::uint64_t>(std::max<std::int64_t>(elapsed.count(), 0)));
+         if (!succeeded) {
+             ++results.misses[op];
+         }
+     }
+ }
+
+ /**
+  * @brief Gets a percentile of sorted samples
+  *
+  * @param sorted Samples in ascending order (not empty)
+  * @param fraction Percentile as a fraction, e.g. 0.99
+  * @return The sample at that rank, in microseconds
+  */
+ double percentileMicros(const std::vector<std::uint64_t>& sorted, double fraction) {
+     std::size_t rank = static_cast<std::size_t>(fraction * static_cast<double>(sorted.size() - 1));
+     return static_cast<double>(sorted[rank]) / 1000.0;
+ }
+
+ /**
+  * @brief Prints one row of the latency table
+  *
+  * @param name Operation name
+  * @param sorted Latencies in ascending order (not empty)
+  * @param misses Calls that returned false or nothing
+  */
+ void printRow(const std::string& name, const std::vector<std::uint64_t>& sorted, std::uint64_t misses) {
+     std::cout << std::left << std::setw(20) << name << std::right
+               << std::setw(10) << sorted.size() << std::setw(9) << misses
+               << std::setw(11) << percentileMicros(sorted, 0.50)
+               << std::setw(11) << percentileMicros(sorted, 0.90)
+               << std::setw(11) << percentileMicros(sorted, 0.99)
+               << std::setw(11) << percentileMicros(sorted, 0.999)
+               << std::setw(12) << static_cast<double>(sorted.back()) / 1000.0 << "\n";
+ }
+
+ } // namespace
+
+ /**
+  * @brief Entry point of the replay tool
+  *
+  * @param argc Number of command line arguments
+  * @param argv Command line arguments
+  * @return 0 on success, 1 on invalid arguments or an unreadable trace or catalog
+  */
+ int main(int argc, char* argv[]) {
+     Options options;
+     if (!parseOptions(argc, argv, options)) {
+         printUsage(argv[0]);
+         return 1;
+     }
+
+     std::vector<Call> calls;
+     if (!Trace::readFile(options.tracePath, calls)) {
+         return 1;
+     }
+     if (calls.empty()) {
+         std::cerr << "The trace holds no calls" << std::endl;
+         return 1;
+     }
+
+     // The replayed library writes to a scratch copy, never to the original catalog
+     std::filesystem::path directory =
+         std::filesystem::temp_directory_path() / ("library_replay_" + std::to_string(getpid()));
+     std::filesystem::create_directories(directory);
+     std::filesystem::path dataFile = directory / "books.json";
+     if (!options.dataFile.empty()) {
+         std::error_code error;
+         std::filesystem::copy_file(options.dataFile, dataFile, error);
+         if (error) {
+             std::cerr << "Cannot copy " << options.dataFile << ": " << error.message() << std::endl;
+             std::filesystem::remove_all(directory);
+             return 1;
+         }
+     }
+
+     std::vector<Results> results(static_cast<std::size_t>(options.threads));
+     double seconds = 0;
+     {
+         auto library = std::make_unique<Library>(dataFile.string(), options.shards);
+         library->setAutoSave(options.autoSave);
+
+         std::atomic<std::size_t> next{0};
+         std::vector<std::thread> threads;
+         Clock::time_point start = Clock::now();
+         for (int i = 0; i < options.threads; ++i) {
+             threads.emplace_back(runThread, std::ref(*library), std::cref(calls), std::cref(options), start,
+                                  std::ref(next), std::ref(results[static_cast<std::size_t>(i)]));
+         }
+         for (auto& thread : threads) {
+             thread.join();
+         }
+         seconds = std::chrono::duration<double>(Clock::now() - start).count();
+     }
+     std::filesystem::remove_all(directory);
+
+     // Merge the per-thread observations
+     std::vector<std::uint64_t> all;
+     std::uint64_t allMisses = 0;
+     std::uint64_t maxLateNs = 0;
+     std::vector<std::uint64_t> perOp[Trace::kOpCount + 1];
+     std::uint64_t misses[Trace::kOpCount + 1] = {};
+     for (const Results& result : results) {
+         for (std::size_t op = 1; op <= Trace::kOpCount; ++op) {
+             perOp[op].insert(perOp[op].end(), result.latencies[op].begin(), result.latencies[op].end());
+             misses[op] += result.misses[op];
+         }
+         maxLateNs = std::max(maxLateNs, result.maxLateNs);
+     }
+
+     double recorded = static_cast<double>(calls.back().timeNs) / 1e9;
+     std::cout << std::fixed << std::setprecision(1)
+               << "calls:      " << calls.size() << " in " << seconds << " s (" << options.mode << " loop, "
+               << options.threads << " threads";
+     if (options.mode == "open") {
+         std::cout << ", speed " << options.speed << "x";
+     }
+     std::cout << ")\n"
+               << "recorded:   " << recorded << " s, " << static_cast<double>(calls.size()) / std::max(recorded, 1e-9)
+               << " calls/s\n"
+               << "replayed:   " << static_cast<double>(calls.size()) / seconds << " calls/s\n";
+     if (options.mode == "open") {
+         std::cout << "max delay:  " << static_cast<double>(maxLateNs) / 1000.0
+                   << " us behind schedule\n";
+     }
+     std::cout << "\n" << std::left << std::setw(20) << "operation" << std::right
+               << std::setw(10) << "calls" << std::setw(9) << "misses"
+               << std::setw(11) << "p50 us" << std::setw(11) << "p90 us" << std::setw(11) << "p99 us"
+               << std::setw(11) << "p99.9 us" << std::setw(12) << "max us" << "\n";
+     for (std::size_t op = 1; op <= Trace::kOpCount; ++op) {
+         if (perOp[op].empty()) {
+             continue;
+         }
+         std::sort(perOp[op].begin(), perOp[op].end());
+         printRow(Trace::opName(static_cast<Op>(op)), perOp[op], misses[op]);
+         all.insert(all.end(), perOp[op].begin(), perOp[op].end());
+         allMisses += misses[op];
+     }
+     std::sort(all.begin(), all.end());
+     printRow("all", all, allMisses);
+     return 0;
+ }
@@ -0,0 +1,122 @@
+/**
+ * @file tablebench.cpp
+ * @brief Throughput benchmark of the book table renderer
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains a command line tool that renders a synthetic catalog
+ * with BookTable and, for comparison, with the per-row std::endl loop that
+ * displayAllBooks used before, and reports rows per second for each.
+ * Output goes to /dev/null unless another file is given.
+ */
+
+ #include <chrono>
+ #include <cstdlib>
+ #include <fstream>
+ #include <iomanip>
+ #include <iostream>
+ #include <string>
+ #include <vector>
+ #include "BookTable.hpp"
+
+ using Clock = std::chrono::steady_clock;
+
+ namespace {
+
+ /**
+  * @brief Builds a catalog of varied but deterministic books
+  * @param rows Number of books
+  * @return The books
+  */
+ std::vector<Book> makeBooks(std::size_t rows) {
+     std::vector<Book> books;
+     books.reserve(rows);
+     for (std::size_t i = 0; i < rows; ++i) {
+         Book book(static_cast<int>(i + 1),
+                   "Benchmark title " + std::to_string(i) + std::string(i % 23, 'x'),
+                   "Author " + std::to_string(i % 997),
+                   1900 + static_cast<int>(i % 125));
+         book.setAvailable(i % 3 != 0);
+         books.push_back(std::move(book));
+     }
+     return books;
+ }
+
+ /**
+  * @brief Renders the books with BookTable
+  *
+  * @param books The books
+  * @param out Destination stream
+  */
+ void renderTable(const std::vector<Book>& books, std::ostream& out) {
+     BookTable table(out);
+     for (const Book& book : books) {
+         table.measure(book);
+     }
+     table.writeHeader();
+     for (const Book& book : books) {
+         table.writeRow(book);
+     }
+     table.writeRule();
+ }
+
+ /**
+  * @brief Renders the books one flushed stream insertion chain per row
+  *
+  * @param books The books
+  * @param out Destination stream
+  */
+ void renderPerRow(const std::vector<Book>& books, std::ostream& out) {
+     for (const Book& book : books) {
+         out << book.getId() << " | "
+             << book.getTitle() << " | "
+             << book.getAuthor() << " | "
+             << book.getYear() << " | "
+             << (book.isAvailable() ? "Yes" : "No") << std::endl;
+     }
+ }
+
+ /**
+  * @brief Times one renderer and prints its throughput
+  *
+  * @param name Label of the renderer
+  * @param render The renderer
+  * @param books The books
+  * @param path File to write to
+  */
+ template <typename Render>
+ void measure(const char* name, Render render, const std::vector<Book>& books, const std::string& path) {
+     std::ofstream out(path, std::ios::binary);
+     Clock::time_point start = Clock::now();
+     render(books, out);
+     out.flush();
+     double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+     std::cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(0)
+               << std::setw(12) << static_cast<double>(books.size()) / seconds << " rows/s  ("
+               << std::setprecision(3) << seconds << " s)\n";
+ }
+
+ } // namespace
+
+ /**
+  * @brief Entry point of the table benchmark
+  *
+  * @param argc Number of command line arguments
+  * @param argv Command line arguments: [rows] [output file]
+  * @return 0 on success, 1 on invalid arguments
+  */
+ int main(int argc, char* argv[]) {
+     long rows = argc > 1 ? std::atol(argv[1]) : 1000000;
+     std::string path = argc > 2 ? argv[2] : "/dev/null";
+     if (rows <= 0 || argc > 3) {
+         std::cerr << "Usage: " << argv[0] << " [rows (default 1000000)] [output file (default /dev/null)]\n";
+         return 1;
+     }
+
+     std::vector<Book> books = makeBooks(static_cast<std::size_t>(rows));
+     std::cout << "rendering " << rows << " rows to " << path << "\n";
+     measure("table", renderTable, books, path);
+     measure("per-row", renderPerRow, books, path);
+     return 0;
+ }
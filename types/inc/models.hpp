@@ -24,6 +24,8 @@
  */
 
 #include <string>
+#include <atomic>
+#include <cstdint>
 
 class Book {
 private:
@@ -31,7 +33,8 @@ private:
     std::string title;      /// @brief Title of the book
     std::string author;     /// @brief Author of the book
     int year;               /// @brief Publication year of the book
-    bool available;          /// @brief Flag indicating whether the book is currently available for borrowing
+    std::atomic<bool> available; /// @brief Flag indicating whether the book is currently available for borrowing
+    std::uint64_t version;  /// @brief Edit counter, incremented on every change to title, author or year
 
 public:
     /**
@@ -56,6 +59,38 @@ public:
         const std::string& author, 
         int year);
     
+    /**
+     * @brief Copy constructor
+     * 
+     * Copies all properties; the availability flag is read atomically.
+     * 
+     * @param other The book to copy
+     */
+    Book(const Book& other);
+    
+    /**
+     * @brief Move constructor
+     * 
+     * @param other The book to move from
+     */
+    Book(Book&& other) noexcept;
+    
+    /**
+     * @brief Copy assignment operator
+     * 
+     * @param other The book to copy
+     * @return Reference to this book
+     */
+    Book& operator=(const Book& other);
+    
+    /**
+     * @brief Move assignment operator
+     * 
+     * @param other The book to move from
+     * @return Reference to this book
+     */
+    Book& operator=(Book&& other) noexcept;
+    
     // Getters
     /**
      * @brief Get the book's unique identifier
@@ -65,15 +100,15 @@ public:
  
     /**
      * @brief Get the book's title
-     * @return The title of the book
+     * @return The title of the book, valid as long as the book is unchanged
      */
-    std::string getTitle() const;
+    const std::string& getTitle() const;
      
     /**
      * @brief Get the book's author
-     * @return The author of the book
+     * @return The author of the book, valid as long as the book is unchanged
      */
-    std::string getAuthor() const;
+    const std::string& getAuthor() const;
 
     /**
      * @brief Get the book's publication year
@@ -86,6 +121,12 @@ public:
      * @return The year the book was published
      */
     bool isAvailable() const;
+
+    /**
+     * @brief Get the book's edit version
+     * @return The version, starting at 1 for a new book
+     */
+    std::uint64_t getVersion() const;
     
     // Setters
 
@@ -118,6 +159,12 @@ public:
      * @param available The new availability status (true for available, false for unavailable)
      */
     void setAvailable(bool available);
+
+    /**
+     * @brief Set the book's edit version
+     * @param version The version to assign (used when loading from storage)
+     */
+    void setVersion(std::uint64_t version);
     
     // Other methods
 
@@ -136,6 +183,26 @@ public:
      * @throws std::runtime_error if the book is already available
      */
     void returnBook();
+    
+    /**
+     * @brief Atomically borrow the book if it is available
+     * 
+     * Checks availability and marks the book as borrowed in a single
+     * compare-and-swap, so two threads can never borrow the same copy.
+     * 
+     * @return true if this call borrowed the book, false if it was already borrowed
+     */
+    bool tryBorrow();
+    
+    /**
+     * @brief Atomically return the book if it is borrowed
+     * 
+     * Checks availability and marks the book as available in a single
+     * compare-and-swap, so a copy can only be returned once.
+     * 
+     * @return true if this call returned the book, false if it was already available
+     */
+    bool tryReturn();
 };
 
 #endif // BOOK_HPP
\ No newline at end of file
@@ -21,8 +21,9 @@
   * - author: empty string
   * - year: 0
   * - available: true (book is available by default)
+  * - version: 1
   */
- Book::Book() : id(0), title(""), author(""), year(0), available(true) {}
+ Book::Book() : id(0), title(""), author(""), year(0), available(true), version(1) {}
  
  /**
   * @brief Parameterized constructor implementation
@@ -35,7 +36,65 @@
   * @param year Publication year of the book
   */
  Book::Book(int id, const std::string& title, const std::string& author, int year)
-     : id(id), title(title), author(author), year(year), available(true) {}
+     : id(id), title(title), author(author), year(year), available(true), version(1) {}
+ 
+ /**
+  * @brief Copy constructor implementation
+  * 
+  * std::atomic is not copyable, so the flag is loaded from the source
+  * book and stored into the new one.
+  * 
+  * @param other The book to copy
+  */
+ Book::Book(const Book& other)
+     : id(other.id), title(other.title), author(other.author), year(other.year),
+       available(other.available.load(std::memory_order_acquire)), version(other.version) {}
+ 
+ /**
+  * @brief Move constructor implementation
+  * 
+  * @param other The book to move from
+  */
+ Book::Book(Book&& other) noexcept
+     : id(other.id), title(std::move(other.title)), author(std::move(other.author)),
+       year(other.year), available(other.available.load(std::memory_order_acquire)),
+       version(other.version) {}
+ 
+ /**
+  * @brief Copy assignment operator implementation
+  * 
+  * @param other The book to copy
+  * @return Reference to this book
+  */
+ Book& Book::operator=(const Book& other) {
+     if (this != &other) {
+         id = other.id;
+         title = other.title;
+         author = other.author;
+         year = other.year;
+         available.store(other.available.load(std::memory_order_acquire), std::memory_order_release);
+         version = other.version;
+     }
+     return *this;
+ }
+ 
+ /**
+  * @brief Move assignment operator implementation
+  * 
+  * @param other The book to move from
+  * @return Reference to this book
+  */
+ Book& Book::operator=(Book&& other) noexcept {
+     if (this != &other) {
+         id = other.id;
+         title = std::move(other.title);
+         author = std::move(other.author);
+         year = other.year;
+         available.store(other.available.load(std::memory_order_acquire), std::memory_order_release);
+         version = other.version;
+     }
+     return *this;
+ }
  
  /**
   * @brief Implementation of getId() method
@@ -51,7 +110,7 @@
   * 
   * @return The title of the book
   */
- std::string Book::getTitle() const {
+ const std::string& Book::getTitle() const {
      return title;
  }
  
@@ -60,7 +119,7 @@
   * 
   * @return The author of the book
   */
- std::string Book::getAuthor() const {
+ const std::string& Book::getAuthor() const {
      return author;
  }
  
@@ -79,7 +138,16 @@
   * @return true if the book is available for borrowing, false otherwise
   */
  bool Book::isAvailable() const {
-     return available;
+     return available.load(std::memory_order_acquire);
+ }
+ 
+ /**
+  * @brief Implementation of getVersion() method
+  * 
+  * @return The edit version of the book
+  */
+ std::uint64_t Book::getVersion() const {
+     return version;
  }
  
  /**
@@ -134,7 +202,18 @@
   * @param available The new availability status (true for available, false for unavailable)
   */
  void Book::setAvailable(bool available) {
-     this->available = available;  // 'this' pointer used to disambiguate parameter and member variable
+     this->available.store(available, std::memory_order_release);  // 'this' pointer used to disambiguate parameter and member variable
+ }
+ 
+ /**
+  * @brief Implementation of setVersion() method
+  * 
+  * Updates the book's edit version to the specified value.
+  * 
+  * @param version The version to assign
+  */
+ void Book::setVersion(std::uint64_t version) {
+     this->version = version;  // 'this' pointer used to disambiguate parameter and member variable
  }
  
  /**
@@ -147,7 +226,7 @@
   * sets the status to false regardless of the current status.
   */
  void Book::borrow() {
-     available = false;
+     available.store(false, std::memory_order_release);
  }
  
  /**
@@ -160,5 +239,31 @@
   * sets the status to true regardless of the current status.
   */
  void Book::returnBook() {
-     available = true;
+     available.store(true, std::memory_order_release);
+ }
+ 
+ /**
+  * @brief Implementation of tryBorrow() method
+  * 
+  * Flips the availability flag from true to false with a single
+  * compare-and-swap. Only one of several racing callers can succeed.
+  * 
+  * @return true if this call borrowed the book, false if it was already borrowed
+  */
+ bool Book::tryBorrow() {
+     bool expected = true;
+     return available.compare_exchange_strong(expected, false, std::memory_order_acq_rel);
+ }
+ 
+ /**
+  * @brief Implementation of tryReturn() method
+  * 
+  * Flips the availability flag from false to true with a single
+  * compare-and-swap. Only one of several racing callers can succeed.
+  * 
+  * @return true if this call returned the book, false if it was already available
+  */
+ bool Book::tryReturn() {
+     bool expected = false;
+     return available.compare_exchange_strong(expected, true, std::memory_order_acq_rel);
  }
\ No newline at end of file
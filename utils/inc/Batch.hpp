@@ -0,0 +1,84 @@
+/**
+ * @file Batch.hpp
+ * @brief Header file declaring the non-interactive batch command mode
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the declaration of the Batch namespace, which executes
+ * a script of library commands without any prompts and reports the outcome
+ * of each command in a machine-readable form. It is used for load testing
+ * and data migration, where millions of commands are piped through the
+ * program.
+ */
+
+ #ifndef BATCH_HPP
+ #define BATCH_HPP
+
+ #include <istream>
+ #include <ostream>
+ #include "Library.hpp"
+
+ /**
+  * @namespace Batch
+  * @brief Namespace containing the line-oriented batch command interpreter
+  *
+  * Every input line holds one command; blank lines and lines starting with
+  * '#' are ignored. Arguments are separated by whitespace, and arguments
+  * containing spaces are written in double quotes (\" and \\ escape a quote
+  * and a backslash inside them):
+  *
+  *     add "<title>" "<author>" <year>
+  *     borrow <id> [<id> ...]     (several IDs: all or nothing)
+  *     return <id> [<id> ...]     (several IDs: all or nothing)
+  *     remove <id>
+  *     update <id> <version> "<title>" "<author>" <year>
+  *     find id <id>
+  *     find title "<text>"
+  *     find author "<text>"
+  *     list
+  *     export csv|jsonl|json <file> [title|author "<text>"]
+  *     stats
+  *     memory
+  *
+  * Output is tab-separated, one record per line. Queries first print one
+  * line per book:
+  *
+  *     book <id> <title> <author> <year> <available 1|0> <version>
+  *
+  * and every command then ends with exactly one status line, either
+  * "ok <command>" (add appends the ID of the new book, queries the
+  * number of books) or
+  * "error <command> <reason>". Tabs, newlines and backslashes inside
+  * titles and authors are written as \t, \n and \\. export writes its
+  * rows to <file> instead (see Export.hpp) and reports their number in its
+  * status line. stats prints one line per operation timed so far (see
+  * Latency.hpp), with latencies in nanoseconds:
+  *
+  *     stat <operation> <count> <p50> <p90> <p99> <p99.9> <max>
+  *
+  * followed by the load of the shared thread pool (see ThreadPool.hpp):
+  *
+  *     pool <workers> <busy> <queued> <submitted> <executed> <steals>
+  *
+  * memory prints one line per subsystem of the memory accounting (see
+  * Memory.hpp), with sizes in bytes:
+  *
+  *     mem <subsystem> <live bytes> <peak bytes> <live blocks> <allocations>
+  */
+ namespace Batch {
+     /**
+      * @brief Executes every command of a script against a library
+      *
+      * Auto-save is turned off for the duration of the run, so the data file
+      * is written exactly once, after the last command, and only if some
+      * command changed the catalog.
+      *
+      * @param library The library to operate on
+      * @param in Stream the commands are read from
+      * @param out Stream the results are written to
+      * @return true if nothing changed or the final write of the data file succeeded
+      */
+     bool run(Library& library, std::istream& in, std::ostream& out);
+ }
+
+ #endif // BATCH_HPP
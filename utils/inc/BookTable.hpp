@@ -0,0 +1,95 @@
+/**
+ * @file BookTable.hpp
+ * @brief Header file declaring the buffered table renderer for books
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the declaration of the BookTable class, which formats
+ * books as an aligned text table. Rows are built in one reusable buffer and
+ * handed to the output stream in large chunks, so printing a large catalog
+ * costs a handful of system calls instead of one flush per book.
+ */
+
+ #ifndef BOOK_TABLE_HPP
+ #define BOOK_TABLE_HPP
+
+ #include <cstddef>
+ #include <ostream>
+ #include <string>
+ #include <string_view>
+ #include "models.hpp"
+
+ /**
+  * @class BookTable
+  * @brief Aligned "ID | Title | Author | Year | Available" table writer
+  *
+  * Column widths are taken from the data: call measure() for every book
+  * that will be printed, then writeHeader(), writeRow() for each book and
+  * writeRule() to close the table. Title and author columns stop growing at
+  * kMaxTextWidth characters; longer values are printed in full and simply
+  * push the rest of their row to the right.
+  *
+  * Output is buffered until flush() (or destruction), which writes the
+  * remaining bytes and flushes the stream once.
+  */
+ class BookTable {
+ public:
+     /// @brief Widest title or author column, in characters
+     static constexpr std::size_t kMaxTextWidth = 40;
+
+     /**
+      * @brief Constructor
+      * @param out Stream the table is written to
+      */
+     explicit BookTable(std::ostream& out);
+
+     /**
+      * @brief Writes any buffered output
+      */
+     ~BookTable();
+
+     BookTable(const BookTable&) = delete;
+     BookTable& operator=(const BookTable&) = delete;
+
+     /**
+      * @brief Widens the columns to fit a book
+      * @param book A book that will be printed
+      */
+     void measure(const Book& book);
+
+     /**
+      * @brief Writes the column titles framed by rules
+      */
+     void writeHeader();
+
+     /**
+      * @brief Writes a horizontal rule as wide as the table
+      */
+     void writeRule();
+
+     /**
+      * @brief Writes one book as a table row
+      * @param book The book to write
+      */
+     void writeRow(const Book& book);
+
+     /**
+      * @brief Writes the buffered output and flushes the stream
+      */
+     void flush();
+
+ private:
+     std::ostream& out;
+     std::string buffer;
+     std::size_t idWidth;
+     std::size_t titleWidth;
+     std::size_t authorWidth;
+     std::size_t yearWidth;
+
+     void append(std::string_view text);
+     void appendPadded(std::string_view text, std::size_t width);
+     void appendNumber(long long value, std::size_t width);
+     void endLine();
+ };
+
+ #endif // BOOK_TABLE_HPP
@@ -14,6 +14,7 @@
  #ifndef DISPLAY_HPP
  #define DISPLAY_HPP
  
+ #include <functional>
  #include "Library.hpp"
  
  /**
@@ -60,6 +61,51 @@
       */
      void searchBookMenu(Library& library);
      
+     /**
+      * @brief Lets the user page through books
+      * 
+      * Shows one page of books as a table and reads navigation commands:
+      * n (next page), p (previous page), j <page> (jump to a page),
+      * s <size> (change the page size and restart) and q (quit). Each page
+      * is fetched from the library on demand with a cursor, so browsing
+      * a huge result costs no more than browsing a short one.
+      * 
+      * @param library Reference to the Library object to browse
+      * @param matches Optional predicate selecting the books to show (all if empty)
+      * @return false if no book matched, true otherwise
+      */
+     bool browseBooks(const Library& library, const std::function<bool(const Book&)>& matches = {});
+     
+     /**
+      * @brief Searches titles and authors while the user types
+      * 
+      * Switches the terminal to raw mode and refreshes the matches after
+      * every keystroke. Searches run in the background: a newer keystroke
+      * cancels the search still running, and a query that extends an
+      * earlier one only re-checks that query's matches (see
+      * IncrementalSearch). Enter or Esc returns to the menu.
+      * 
+      * @param library Reference to the Library object to search in
+      */
+     void liveSearchMenu(const Library& library);
+     
+     /**
+      * @brief Prints latency percentiles of every operation run so far
+      * 
+      * Shows the count, p50, p90, p99, p99.9 and maximum of each Library
+      * operation and data file access (see Latency.hpp).
+      */
+     void showStatistics();
+     
+     /**
+      * @brief Prints the memory held by each subsystem
+      * 
+      * Shows live and peak bytes, live blocks and allocation counts of the
+      * book storage, string payloads, JSON documents, indexes and caches
+      * (see Memory.hpp).
+      */
+     void showMemoryUsage();
+     
      /**
       * @brief Displays the borrow book interface and processes user input
       * 
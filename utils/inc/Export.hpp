@@ -0,0 +1,127 @@
+/**
+ * @file Export.hpp
+ * @brief Header file declaring the machine-readable export formats
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the declaration of the Export namespace, which writes
+ * books as CSV, JSON Lines or a JSON array for downstream tools. Rows are
+ * written while a pinned snapshot is walked, so an export of any size runs
+ * in constant memory and its first rows arrive before the last ones are read.
+ */
+
+ #ifndef EXPORT_HPP
+ #define EXPORT_HPP
+
+ #include <cstddef>
+ #include <functional>
+ #include <ostream>
+ #include <string>
+ #include <string_view>
+ #include "Snapshot.hpp"
+
+ /**
+  * @namespace Export
+  * @brief Namespace containing the CSV and JSON writers
+  *
+  * CSV follows RFC 4180: a header line "id,title,author,year,available,version",
+  * then one line per book; fields containing a comma, a quote or a line
+  * break are quoted and their quotes doubled. JSON Lines holds one object
+  * per line with the same keys as the data file:
+  *
+  *     {"id":1,"title":"Dune","author":"Frank Herbert","year":1965,"available":true,"version":1}
+  *
+  * The JSON format wraps the same objects in an array, which is exactly
+  * the layout of the data file.
+  */
+ namespace Export {
+     /**
+      * @enum Format
+      * @brief Supported output formats
+      */
+     enum class Format {
+         Csv,    ///< Comma-separated values with a header line
+         Jsonl,  ///< One JSON object per line
+         Json    ///< A JSON array of objects, as in the data file
+     };
+
+     /**
+      * @brief Looks up a format by its name ("csv", "jsonl" or "json")
+      *
+      * @param name The name
+      * @param format Receives the format
+      * @return false if the name is unknown
+      */
+     bool parseFormat(std::string_view name, Format& format);
+
+     /**
+      * @class Writer
+      * @brief Buffered row writer for one format
+      *
+      * Rows are collected in a reusable buffer that goes to the stream in
+      * large chunks; finish() (or destruction) writes the rest.
+      */
+     class Writer {
+     public:
+         /**
+          * @brief Constructor; writes the CSV header line or opens the JSON array
+          *
+          * @param out Stream the rows are written to
+          * @param format Output format
+          */
+         Writer(std::ostream& out, Format format);
+
+         /**
+          * @brief Writes any buffered output
+          */
+         ~Writer();
+
+         Writer(const Writer&) = delete;
+         Writer& operator=(const Writer&) = delete;
+
+         /**
+          * @brief Writes one book
+          * @param book The book to write
+          */
+         void write(const Book& book);
+
+         /**
+          * @brief Ends the output and flushes the stream
+          *
+          * Closes the JSON array and writes the buffered output; later
+          * calls do nothing and no rows may be written afterwards.
+          */
+         void finish();
+
+         /**
+          * @brief Gets the number of books written so far
+          * @return Row count, not counting a CSV header
+          */
+         std::size_t rows() const;
+
+     private:
+         std::ostream& out;
+         Format format;
+         std::string buffer;
+         std::size_t written;
+         bool finished;
+
+         void appendCsvField(std::string_view text);
+         void appendJsonString(std::string_view text);
+         void appendNumber(long long value);
+     };
+
+     /**
+      * @brief Writes the books of a snapshot in ID order
+      *
+      * @param snapshot The pinned books
+      * @param out Stream the rows are written to
+      * @param format Output format
+      * @param matches Optional predicate selecting the books to write (all if empty)
+      * @return Number of books written
+      */
+     std::size_t write(const Snapshot& snapshot, std::ostream& out, Format format,
+                       const std::function<bool(const Book&)>& matches = {});
+ }
+
+ #endif // EXPORT_HPP
@@ -13,6 +13,7 @@
  #define FILE_HPP
  
  #include <string>
+ #include <string_view>
  
  /**
   * @namespace FileUtils
@@ -75,7 +76,7 @@
       * @return true if the write operation was successful,
       *         false if the file couldn't be opened or written to
       */
-     bool writeFile(const std::string& filename, const std::string& content);
+     bool writeFile(const std::string& filename, std::string_view content);
      
      /**
       * @brief Deletes a file from the file system
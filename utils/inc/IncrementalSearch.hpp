@@ -0,0 +1,136 @@
+/**
+ * @file IncrementalSearch.hpp
+ * @brief Header file declaring the search-as-you-type engine
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the declaration of the IncrementalSearch class, which
+ * answers a query that changes with every keystroke. Searches run on the
+ * thread pool, a newer query cancels the one still running, and a query
+ * that extends an earlier one only re-checks that query's matches.
+ */
+
+ #ifndef INCREMENTAL_SEARCH_HPP
+ #define INCREMENTAL_SEARCH_HPP
+
+ #include <atomic>
+ #include <cstddef>
+ #include <cstdint>
+ #include <deque>
+ #include <memory>
+ #include <mutex>
+ #include <string>
+ #include <vector>
+ #include "Memory.hpp"
+ #include "Snapshot.hpp"
+ #include "ThreadPool.hpp"
+
+ /**
+  * @class IncrementalSearch
+  * @brief Background title/author search over a pinned snapshot
+  *
+  * Matching is a case-insensitive (ASCII) substring test against the title
+  * and the author of every book. The snapshot is pinned for the lifetime of
+  * the object, so results refer to books by their position in it.
+  *
+  * Each update() bumps a generation counter; a running search compares its
+  * own generation with the counter every few thousand books and gives up
+  * once it is stale. A search publishes a first, partial result as soon as
+  * it has found previewSize matches (enough to fill the screen) and the
+  * complete result when it finishes. The last few completed results are
+  * remembered: a query seen before (as after a backspace) is answered from
+  * them at once, and a query containing a remembered one only scans that
+  * query's matches.
+  */
+ class IncrementalSearch {
+ public:
+     /// @brief Positions of matching books; remembered results are charged to Memory::Subsystem::Caches
+     using Matches = std::vector<std::uint32_t, Memory::Allocator<std::uint32_t, Memory::Subsystem::Caches>>;
+
+     /**
+      * @struct Result
+      * @brief Matches published by one search
+      */
+     struct Result {
+         std::uint64_t generation = 0;                            ///< update() call that produced it
+         std::string query;                                       ///< The query as given to update()
+         std::shared_ptr<const Matches> matches;                  ///< Positions of the matching books, in ID order
+         bool complete = false;                                   ///< false for the early partial result
+     };
+
+     /**
+      * @brief Pins a snapshot and indexes its titles and authors
+      *
+      * @param snapshot The books to search
+      * @param previewSize Matches after which a partial result is published
+      * @param pool Pool the searches run on
+      */
+     IncrementalSearch(Snapshot snapshot, std::size_t previewSize, ThreadPool& pool = ThreadPool::shared());
+
+     /**
+      * @brief Cancels the running search and waits for it
+      */
+     ~IncrementalSearch();
+
+     IncrementalSearch(const IncrementalSearch&) = delete;
+     IncrementalSearch& operator=(const IncrementalSearch&) = delete;
+
+     /**
+      * @brief Starts searching for a new query, cancelling older searches
+      *
+      * @param query The text to search for (an empty query matches every book)
+      * @return Generation of the new search
+      */
+     std::uint64_t update(std::string query);
+
+     /**
+      * @brief Takes the newest result published since the last call
+      *
+      * Results of cancelled searches are never returned once a newer
+      * search has published.
+      *
+      * @param result Receives the result
+      * @return false if nothing new was published
+      */
+     bool takeResult(Result& result);
+
+     /**
+      * @brief Gets a book by its position in the snapshot
+      * @param position Position taken from Result::matches
+      * @return The book
+      */
+     const Book& book(std::uint32_t position) const;
+
+     /**
+      * @brief Gets the number of books being searched
+      * @return Book count
+      */
+     std::size_t size() const;
+
+ private:
+     /// @brief Search key of one book, charged to Memory::Subsystem::Indexes
+     using Key = std::basic_string<char, std::char_traits<char>, Memory::Allocator<char, Memory::Subsystem::Indexes>>;
+
+     /// @brief Pinned books and their lowercase "title\nauthor" keys
+     Snapshot snapshot;
+     std::vector<const Book*, Memory::Allocator<const Book*, Memory::Subsystem::Indexes>> books;
+     std::vector<Key, Memory::Allocator<Key, Memory::Subsystem::Indexes>> keys;
+
+     std::size_t previewSize;
+     std::atomic<std::uint64_t> generation{0};
+
+     /// @brief Guards the fields below
+     std::mutex mutex;
+     Result published;
+     std::uint64_t publications = 0;
+     std::uint64_t taken = 0;
+     std::deque<Result> history;  ///< Completed results, newest first
+
+     /// @brief Searches still running (declared last: joined first)
+     TaskGroup running;
+
+     void run(std::uint64_t mine, std::string query);
+     void publish(Result result);
+ };
+
+ #endif // INCREMENTAL_SEARCH_HPP
@@ -0,0 +1,205 @@
+/**
+ * @file Latency.hpp
+ * @brief Header file declaring the built-in latency histograms
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the declaration of the Latency namespace, which keeps
+ * a latency histogram for every Library operation and for the JsonUtils
+ * and FileUtils I/O calls underneath them. Recording is cheap enough to
+ * stay on in production; the `stats` command prints the percentiles.
+ */
+
+ #ifndef LATENCY_HPP
+ #define LATENCY_HPP
+
+ #include <array>
+ #include <chrono>
+ #include <cstddef>
+ #include <cstdint>
+ #include <ostream>
+
+ /**
+  * @namespace Latency
+  * @brief Namespace containing the per-operation latency histograms
+  *
+  * Histograms use HDR-style buckets: values below 64 ns get a bucket each,
+  * and every further power of two is split into 32 buckets, so any value
+  * is placed within 1/32 (about 3%) of its true size. Values above about
+  * 68 s land in the last bucket; the exact maximum is kept separately.
+  *
+  * Each thread records into its own block of counters with plain relaxed
+  * stores, so recording never locks and never contends. Readers add up
+  * the blocks of all threads. Blocks of threads that have exited are
+  * handed to new threads, which keep adding to them.
+  */
+ namespace Latency {
+     /**
+      * @enum Op
+      * @brief Timed operations
+      */
+     enum class Op {
+         AddBook,
+         RemoveBook,
+         FindBookById,
+         FindBooksByTitle,
+         FindBooksByAuthor,
+         BorrowBook,
+         ReturnBook,
+         UpdateBook,
+         BorrowBooks,
+         ReturnBooks,
+         GetAllBooks,
+         PageAfter,
+         AddBookAsync,
+         RemoveBookAsync,
+         BorrowBookAsync,
+         ReturnBookAsync,
+         UpdateBookAsync,
+         Flush,
+         LoadBooks,
+         SaveBooks,
+         JsonReadBooks,
+         JsonWriteBooks,
+         FileRead,
+         FileWrite,
+         Count    ///< Number of operations, not an operation
+     };
+
+     /// @brief Number of timed operations
+     constexpr std::size_t kOpCount = static_cast<std::size_t>(Op::Count);
+
+     /// @brief Buckets per histogram: 64 exact ones, then 32 per power of two up to 2^36 ns
+     constexpr std::size_t kBuckets = 64 + 30 * 32;
+
+     /**
+      * @brief Gets the name of an operation
+      * @param op The operation
+      * @return Name such as "borrowBook" or "FileUtils::writeFile"
+      */
+     const char* opName(Op op);
+
+     /**
+      * @brief Records one latency for the calling thread
+      *
+      * @param op The operation
+      * @param ns Latency in nanoseconds
+      */
+     void record(Op op, std::uint64_t ns);
+
+     /**
+      * @class Timer
+      * @brief Records the lifetime of a scope as one latency
+      */
+     class Timer {
+     public:
+         /**
+          * @brief Constructor; starts timing
+          * @param op The operation being timed
+          */
+         explicit Timer(Op op) : op(op), start(std::chrono::steady_clock::now()) {}
+
+         /**
+          * @brief Destructor; records the elapsed time
+          */
+         ~Timer() {
+             record(op, elapsedNs());
+         }
+
+         Timer(const Timer&) = delete;
+         Timer& operator=(const Timer&) = delete;
+
+         /**
+          * @brief Reads the time elapsed so far
+          * @return Nanoseconds since construction
+          */
+         std::uint64_t elapsedNs() const {
+             auto elapsed = std::chrono::steady_clock::now() - start;
+             return static_cast<std::uint64_t>(
+                 std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+         }
+
+     private:
+         Op op;
+         std::chrono::steady_clock::time_point start;
+     };
+
+     /**
+      * @class Histogram
+      * @brief Merged counts of one operation, as read by reporters
+      */
+     class Histogram {
+     public:
+         /**
+          * @brief Gets the number of recorded latencies
+          * @return Count
+          */
+         std::uint64_t count() const { return total; }
+
+         /**
+          * @brief Gets the sum of the recorded latencies
+          * @return Nanoseconds
+          */
+         std::uint64_t sum() const { return sumNs; }
+
+         /**
+          * @brief Gets the largest recorded latency
+          * @return Nanoseconds, exact
+          */
+         std::uint64_t max() const { return maxNs; }
+
+         /**
+          * @brief Gets a percentile
+          *
+          * @param fraction Percentile as a fraction, e.g. 0.999
+          * @return Upper bound of the bucket holding that rank, never above
+          *         max(); 0 if nothing was recorded
+          */
+         std::uint64_t percentile(double fraction) const;
+
+         /**
+          * @brief Gets the number of latencies in one bucket
+          * @param bucket Bucket index, below kBuckets
+          * @return Count
+          */
+         std::uint64_t bucketCount(std::size_t bucket) const { return counts[bucket]; }
+
+         /**
+          * @brief Gets the largest value that falls into a bucket
+          * @param bucket Bucket index, below kBuckets
+          * @return Nanoseconds
+          */
+         static std::uint64_t bucketUpperBound(std::size_t bucket);
+
+         /**
+          * @brief Gets the bucket a value falls into
+          * @param ns Nanoseconds
+          * @return Bucket index, below kBuckets
+          */
+         static std::size_t bucketOf(std::uint64_t ns);
+
+     private:
+         friend Histogram histogram(Op op);
+
+         std::array<std::uint64_t, kBuckets> counts{};
+         std::uint64_t total = 0;
+         std::uint64_t sumNs = 0;
+         std::uint64_t maxNs = 0;
+     };
+
+     /**
+      * @brief Merges the latencies of one operation over all threads
+      * @param op The operation
+      * @return The histogram since the program started
+      */
+     Histogram histogram(Op op);
+
+     /**
+      * @brief Prints count, p50, p90, p99, p99.9 and max of every operation
+      *        that has been recorded, as an aligned table in microseconds
+      * @param out Destination stream
+      */
+     void printTable(std::ostream& out);
+ }
+
+ #endif // LATENCY_HPP
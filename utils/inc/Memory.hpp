@@ -0,0 +1,153 @@
+/**
+ * @file Memory.hpp
+ * @brief Header file declaring the memory accounting
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the declaration of the Memory namespace, which
+ * attributes live heap bytes and allocation counts to the subsystems of
+ * the program, so the memory of a process can be broken down without a
+ * heap profiler.
+ */
+
+ #ifndef MEMORY_HPP
+ #define MEMORY_HPP
+
+ #include <cstddef>
+ #include <cstdint>
+ #include <memory>
+ #include <ostream>
+
+ /**
+  * @namespace Memory
+  * @brief Namespace containing the per-subsystem memory counters
+  *
+  * Containers owned by a subsystem use Allocator, which reports every
+  * allocation and deallocation; the text of the books is reported by the
+  * catalog chunks holding them. Counters are relaxed atomics, so
+  * accounting never locks.
+  * Only the heap blocks themselves are counted, not the allocator's own
+  * bookkeeping around them.
+  */
+ namespace Memory {
+     /**
+      * @enum Subsystem
+      * @brief Owners that memory is attributed to
+      */
+     enum class Subsystem {
+         Storage,   ///< Catalog chunks holding the books, and their lists
+         Strings,   ///< Title and author text in catalog chunks, one block per chunk
+         JsonLoad,  ///< JSON document parsed while loading the data file
+         JsonSave,  ///< JSON document built while saving the data file
+         Indexes,   ///< Search keys of the live search
+         Caches,    ///< Result history of the live search
+         Count
+     };
+
+     /// @brief Number of subsystems
+     constexpr std::size_t kSubsystemCount = static_cast<std::size_t>(Subsystem::Count);
+
+     /**
+      * @struct Usage
+      * @brief Counters of one subsystem
+      */
+     struct Usage {
+         std::int64_t liveBytes = 0;        ///< Bytes currently allocated
+         std::int64_t peakBytes = 0;        ///< Highest liveBytes since start or resetPeaks()
+         std::int64_t liveBlocks = 0;       ///< Allocations not yet released
+         std::uint64_t allocations = 0;     ///< Allocations made since start
+     };
+
+     /**
+      * @brief Gets the display name of a subsystem
+      * @param subsystem The subsystem
+      * @return Name, e.g. "storage"
+      */
+     const char* subsystemName(Subsystem subsystem);
+
+     /**
+      * @brief Reports allocated blocks
+      *
+      * @param subsystem The owner
+      * @param bytes Total size of the blocks
+      * @param blocks Number of blocks
+      */
+     void allocated(Subsystem subsystem, std::size_t bytes, std::size_t blocks = 1);
+
+     /**
+      * @brief Reports released blocks
+      *
+      * @param subsystem The owner
+      * @param bytes Total size of the blocks
+      * @param blocks Number of blocks
+      */
+     void released(Subsystem subsystem, std::size_t bytes, std::size_t blocks = 1);
+
+     /**
+      * @brief Reads the counters of a subsystem
+      * @param subsystem The subsystem
+      * @return Its counters
+      */
+     Usage usage(Subsystem subsystem);
+
+     /**
+      * @brief Starts a new peak measurement: every peak becomes the live value
+      */
+     void resetPeaks();
+
+     /**
+      * @brief Prints live bytes, peaks and allocation counts per subsystem
+      * @param out Destination stream
+      */
+     void printReport(std::ostream& out);
+
+     /**
+      * @class Allocator
+      * @brief Standard allocator that attributes its memory to a subsystem
+      *
+      * @tparam T Element type
+      * @tparam S Subsystem charged for the memory
+      */
+     template <typename T, Subsystem S>
+     class Allocator {
+     public:
+         using value_type = T;
+
+         template <typename U>
+         struct rebind {
+             using other = Allocator<U, S>;
+         };
+
+         Allocator() noexcept = default;
+
+         template <typename U>
+         Allocator(const Allocator<U, S>&) noexcept {}
+
+         /**
+          * @brief Allocates storage for n elements
+          * @param n Element count
+          * @return The storage
+          */
+         T* allocate(std::size_t n) {
+             T* pointer = std::allocator<T>().allocate(n);
+             allocated(S, n * sizeof(T));
+             return pointer;
+         }
+
+         /**
+          * @brief Releases storage obtained from allocate()
+          *
+          * @param pointer The storage
+          * @param n Element count passed to allocate()
+          */
+         void deallocate(T* pointer, std::size_t n) noexcept {
+             released(S, n * sizeof(T));
+             std::allocator<T>().deallocate(pointer, n);
+         }
+
+         template <typename U>
+         bool operator==(const Allocator<U, S>&) const noexcept { return true; }
+     };
+ }
+
+ #endif // MEMORY_HPP
@@ -0,0 +1,201 @@
+/**
+ * @file Metrics.hpp
+ * @brief Header file declaring the metrics registry
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the declaration of the Metrics namespace: counters,
+ * gauges and histograms that the program updates as it runs, and their
+ * Prometheus text exposition, which MetricsExporter serves over HTTP or
+ * writes to a file.
+ */
+
+ #ifndef METRICS_HPP
+ #define METRICS_HPP
+
+ #include <atomic>
+ #include <cstdint>
+ #include <functional>
+ #include <memory>
+ #include <mutex>
+ #include <ostream>
+ #include <string>
+ #include <vector>
+
+ /**
+  * @namespace Metrics
+  * @brief Namespace containing the metrics registry
+  *
+  * Metrics are registered once by name (registering a name again returns
+  * the existing metric) and then updated with relaxed atomic operations,
+  * so hot paths never lock. The exposition follows the Prometheus text
+  * format 0.0.4 and also includes the per-operation latency histograms of
+  * Latency.hpp as library_operations_total and
+  * library_operation_duration_seconds, labelled by operation, and the
+  * memory accounting of Memory.hpp as library_memory_bytes and
+  * library_memory_allocations_total, labelled by subsystem.
+  */
+ namespace Metrics {
+     /**
+      * @class Counter
+      * @brief Monotonically increasing count
+      */
+     class Counter {
+     public:
+         /**
+          * @brief Adds to the counter
+          * @param amount Amount to add
+          */
+         void inc(std::uint64_t amount = 1) { count.fetch_add(amount, std::memory_order_relaxed); }
+
+         /**
+          * @brief Gets the current count
+          * @return Count
+          */
+         std::uint64_t value() const { return count.load(std::memory_order_relaxed); }
+
+     private:
+         std::atomic<std::uint64_t> count{0};
+     };
+
+     /**
+      * @class Gauge
+      * @brief Value that can go up and down
+      */
+     class Gauge {
+     public:
+         /**
+          * @brief Sets the value
+          * @param value The value
+          */
+         void set(double value) { current.store(value, std::memory_order_relaxed); }
+
+         /**
+          * @brief Adds to the value (negative amounts subtract)
+          * @param amount Amount to add
+          */
+         void add(double amount) { current.fetch_add(amount, std::memory_order_relaxed); }
+
+         /**
+          * @brief Gets the value
+          * @return The value
+          */
+         double value() const { return current.load(std::memory_order_relaxed); }
+
+     private:
+         std::atomic<double> current{0.0};
+     };
+
+     /**
+      * @class Histogram
+      * @brief Distribution of observed values over fixed buckets
+      */
+     class Histogram {
+     public:
+         /**
+          * @brief Constructor
+          * @param bounds Upper bounds of the buckets, ascending; +Inf is implied
+          */
+         explicit Histogram(std::vector<double> bounds);
+
+         /**
+          * @brief Records one value
+          * @param value The value
+          */
+         void observe(double value);
+
+         /**
+          * @brief Writes the buckets, sum and count in exposition format
+          *
+          * @param out Destination stream
+          * @param name Metric name
+          */
+         void write(std::ostream& out, const std::string& name) const;
+
+     private:
+         std::vector<double> bounds;
+         std::unique_ptr<std::atomic<std::uint64_t>[]> counts;  ///< One per bound, plus +Inf
+         std::atomic<double> sum{0.0};
+     };
+
+     /**
+      * @class Registry
+      * @brief Owns the metrics and renders their exposition
+      */
+     class Registry {
+     public:
+         /**
+          * @brief Gets or creates a counter
+          *
+          * @param name Metric name, e.g. "library_written_bytes_total"
+          * @param help Description shown by the exposition
+          * @return The counter, valid for the life of the program
+          */
+         Counter& counter(const std::string& name, const std::string& help);
+
+         /**
+          * @brief Gets or creates a gauge
+          *
+          * @param name Metric name
+          * @param help Description shown by the exposition
+          * @return The gauge, valid for the life of the program
+          */
+         Gauge& gauge(const std::string& name, const std::string& help);
+
+         /**
+          * @brief Gets or creates a histogram
+          *
+          * @param name Metric name
+          * @param help Description shown by the exposition
+          * @param bounds Upper bounds of the buckets (ignored if it exists)
+          * @return The histogram, valid for the life of the program
+          */
+         Histogram& histogram(const std::string& name, const std::string& help, std::vector<double> bounds);
+
+         /**
+          * @brief Registers a gauge whose value is computed when it is read
+          *
+          * Replaces an earlier function of the same name. Useful for values
+          * that are cheap to compute but costly to keep up to date, such as
+          * the size of a snapshot.
+          *
+          * @param name Metric name
+          * @param help Description shown by the exposition
+          * @param read Computes the value; called from the exporting thread
+          */
+         void gaugeFunction(const std::string& name, const std::string& help, std::function<double()> read);
+
+         /**
+          * @brief Writes every metric in Prometheus text format
+          * @param out Destination stream
+          */
+         void writeText(std::ostream& out);
+
+     private:
+         /**
+          * @struct Entry
+          * @brief One registered metric
+          */
+         struct Entry {
+             std::string name;
+             std::string help;
+             std::unique_ptr<Counter> counter;
+             std::unique_ptr<Gauge> gauge;
+             std::unique_ptr<Histogram> histogram;
+             std::function<double()> read;
+         };
+
+         std::mutex mutex;
+         std::vector<Entry> entries;
+
+         Entry* find(const std::string& name);
+     };
+
+     /**
+      * @brief Gets the program's registry
+      * @return The registry
+      */
+     Registry& registry();
+ }
+
+ #endif // METRICS_HPP
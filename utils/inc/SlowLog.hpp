@@ -0,0 +1,305 @@
+/**
+ * @file SlowLog.hpp
+ * @brief Header file declaring the slow-operation log
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the declaration of the SlowLog namespace, which
+ * writes one line for every Library operation that takes longer than a
+ * threshold: its arguments, where its time went (lock waits, lookup,
+ * mutation, serialization, file write), the catalog size and the bytes it
+ * wrote. The latency histograms tell that some borrowBook calls take
+ * seconds; this log tells which ones and why.
+ */
+
+ #ifndef SLOW_LOG_HPP
+ #define SLOW_LOG_HPP
+
+ #include <atomic>
+ #include <chrono>
+ #include <cstddef>
+ #include <cstdint>
+ #include <string>
+ #include <string_view>
+ #include "Latency.hpp"
+
+ /**
+  * @namespace SlowLog
+  * @brief Namespace containing the slow-operation log
+  *
+  * The log is off unless start() is called, which the program does for
+  * --slow-log <file>. While it is off an Operation costs one relaxed
+  * atomic load and phase marks one thread-local load. While it is on, an
+  * operation reads the clock at its start, at each phase mark and at its
+  * end; its arguments are only formatted, and the log only written, when
+  * it turns out to be slow.
+  *
+  * Only the outermost operation of a thread is timed. A borrowBook that
+  * auto-saves logs one line, charging the time it waited for the shared
+  * write to Phase::Write; the write itself is logged as a saveBooks.
+  *
+  * Coroutine operations such as borrowBookAsync suspend while the catalog
+  * is saved and resume on another thread. Before suspending they detach()
+  * their timing from the thread, and on resuming they resume() it on the
+  * new one, charging the time spent queued for the save as waiting and
+  * adding the phases of the save, which may be shared with other callers.
+  */
+ namespace SlowLog {
+     /**
+      * @enum Phase
+      * @brief Parts of an operation its time is broken down into
+      */
+     enum class Phase {
+         Wait,       ///< Waiting for a shard lock or the save lock
+         Lookup,     ///< Finding books
+         Mutate,     ///< Changing books and publishing the new catalog version
+         Serialize,  ///< Copying the catalog and turning it into JSON
+         Write,      ///< Writing the data file
+         Count       ///< Number of phases, not a phase
+     };
+
+     /// @brief Number of phases
+     constexpr std::size_t kPhaseCount = static_cast<std::size_t>(Phase::Count);
+
+     /**
+      * @brief Gets the name of a phase
+      * @param phase The phase
+      * @return Name such as "serialize"
+      */
+     const char* phaseName(Phase phase);
+
+     /**
+      * @struct State
+      * @brief Timing of the operation running on a thread
+      *
+      * Left uninitialized until begin(), so idle operations cost nothing.
+      */
+     struct State {
+         Latency::Op op;
+         std::uint64_t startNs;
+         std::uint64_t lastNs;                 ///< Time of the last phase mark
+         std::uint64_t totalNs;                ///< Set when the operation ends
+         std::uint64_t phaseNs[kPhaseCount];
+         std::uint64_t bytesWritten;
+     };
+
+     /**
+      * @class Entry
+      * @brief Context of a slow operation, filled in only once it is known to be slow
+      */
+     class Entry {
+     public:
+         /**
+          * @brief Adds a numeric argument
+          *
+          * @param key Argument name
+          * @param value Argument value
+          */
+         void arg(const char* key, long long value);
+
+         /**
+          * @brief Adds a text argument, quoted and escaped
+          *
+          * @param key Argument name
+          * @param value Argument value
+          */
+         void arg(const char* key, std::string_view value);
+
+         /**
+          * @brief Sets the number of books in the catalog
+          * @param count Books
+          */
+         void books(std::size_t count) { bookCount = count; }
+
+     private:
+         friend void write(const State& state, const Entry& entry);
+
+         std::string args;
+         std::size_t bookCount = 0;
+     };
+
+     /// @brief Operations at least this long are logged; read through enabled()
+     extern std::atomic<std::uint64_t> thresholdNs;
+
+     /// @brief Operation running on this thread, or null
+     extern thread_local State* current;
+
+     /**
+      * @brief Checks whether operations are being timed
+      * @return true between start() and stop()
+      */
+     inline bool enabled() {
+         return thresholdNs.load(std::memory_order_relaxed) != 0;
+     }
+
+     /**
+      * @brief Reads the clock used for all timings
+      * @return Steady-clock nanoseconds
+      */
+     inline std::uint64_t now() {
+         return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch()).count());
+     }
+
+     /**
+      * @brief Starts logging slow operations to a file
+      *
+      * When the file grows past maxBytes it is renamed to <path>.1 (older
+      * files move up to <path>.<keep>, the oldest is dropped) and a new
+      * file is started.
+      *
+      * @param path Log file, appended to
+      * @param thresholdMs Operations taking at least this long are logged (above 0)
+      * @param maxBytes Size at which the file is rotated
+      * @param keep Rotated files kept
+      * @return false if the file cannot be opened (reported to stderr)
+      */
+     bool start(const std::string& path, double thresholdMs,
+                std::uint64_t maxBytes = 16 * 1024 * 1024, int keep = 3);
+
+     /**
+      * @brief Stops logging and closes the file (also run at exit)
+      */
+     void stop();
+
+     /**
+      * @brief Attributes the time since the last mark to a phase
+      * @param phase Phase that just ended
+      */
+     inline void mark(Phase phase) {
+         if (State* state = current) {
+             std::uint64_t t = now();
+             state->phaseNs[static_cast<std::size_t>(phase)] += t - state->lastNs;
+             state->lastNs = t;
+         }
+     }
+
+     /**
+      * @brief Adds to the bytes written by the running operation
+      * @param bytes Bytes written
+      */
+     inline void addBytesWritten(std::size_t bytes) {
+         if (State* state = current) {
+             state->bytesWritten += bytes;
+         }
+     }
+
+     /**
+      * @brief Starts timing an operation on this thread
+      *
+      * @param op The operation
+      * @param state Receives the timing
+      * @return false if logging is off or an outer operation is being timed
+      */
+     inline bool begin(Latency::Op op, State& state) {
+         if (!enabled() || current) {
+             return false;
+         }
+         state = State{};
+         state.op = op;
+         state.startNs = now();
+         state.lastNs = state.startNs;
+         current = &state;
+         return true;
+     }
+
+     /**
+      * @brief Stops timing the operation of this thread
+      * @param state The timing passed to begin()
+      * @return true if the operation was slow and must be written
+      */
+     inline bool end(State& state) {
+         current = nullptr;
+         state.totalNs = now() - state.startNs;
+         return state.totalNs >= thresholdNs.load(std::memory_order_relaxed);
+     }
+
+     /**
+      * @brief Detaches the operation of this thread before its coroutine suspends
+      *
+      * The thread is free to time other operations afterwards.
+      *
+      * @return The operation, or null if none is being timed
+      */
+     inline State* detach() {
+         State* state = current;
+         current = nullptr;
+         return state;
+     }
+
+     /**
+      * @brief Continues timing a detached operation on the thread resuming it
+      *
+      * The time from detaching until the shared work started is charged
+      * to Phase::Wait, and the phases and bytes of the shared work are
+      * added to the operation's own.
+      *
+      * @param state The operation returned by detach(), or null
+      * @param shared Timing of the work done for it while it was suspended,
+      *               or null if that was not timed
+      */
+     inline void resume(State* state, const State* shared) {
+         if (!state) {
+             return;
+         }
+         if (shared) {
+             if (shared->startNs > state->lastNs) {
+                 state->phaseNs[static_cast<std::size_t>(Phase::Wait)] += shared->startNs - state->lastNs;
+             }
+             for (std::size_t i = 0; i < kPhaseCount; ++i) {
+                 state->phaseNs[i] += shared->phaseNs[i];
+             }
+             state->bytesWritten += shared->bytesWritten;
+         }
+         state->lastNs = now();
+         current = state;
+     }
+
+     /**
+      * @brief Writes one slow operation to the log
+      *
+      * @param state Its timing
+      * @param entry Its context
+      */
+     void write(const State& state, const Entry& entry);
+
+     /**
+      * @class Operation
+      * @brief Times a scope as one operation and logs it if it was slow
+      *
+      * @tparam Describe Callable taking an Entry&, run only for slow
+      *                  operations, that adds the arguments and catalog size
+      */
+     template <typename Describe>
+     class Operation {
+     public:
+         /**
+          * @brief Constructor; starts timing if logging is on
+          *
+          * @param op The operation
+          * @param describe Fills in the context of a slow call
+          */
+         Operation(Latency::Op op, Describe describe) : describe(std::move(describe)), active(begin(op, state)) {}
+
+         /**
+          * @brief Destructor; logs the operation if it was slow
+          */
+         ~Operation() {
+             if (active && end(state)) {
+                 Entry entry;
+                 describe(entry);
+                 write(state, entry);
+             }
+         }
+
+         Operation(const Operation&) = delete;
+         Operation& operator=(const Operation&) = delete;
+
+     private:
+         Describe describe;
+         State state;
+         bool active;
+     };
+ }
+
+ #endif // SLOW_LOG_HPP
@@ -0,0 +1,297 @@
+/**
+ * @file Task.hpp
+ * @brief Header file defining the coroutine task type and its helpers
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the Task<T> coroutine return type used by the async
+ * Library API, an awaitable that moves a coroutine onto a ThreadPool, and
+ * syncWait(), which drives a task to completion from ordinary code.
+ */
+
+ #ifndef TASK_HPP
+ #define TASK_HPP
+
+ #include <condition_variable>
+ #include <coroutine>
+ #include <exception>
+ #include <mutex>
+ #include <optional>
+ #include <utility>
+ #include "ThreadPool.hpp"
+
+ template <typename T>
+ class Task;
+
+ namespace detail {
+
+ /**
+  * @struct TaskPromiseBase
+  * @brief Promise state shared by every Task<T>
+  *
+  * Tasks start suspended and, when they finish, transfer control straight
+  * to whoever awaited them (symmetric transfer), so long await chains do
+  * not grow the stack.
+  */
+ struct TaskPromiseBase {
+     std::coroutine_handle<> continuation = std::noop_coroutine();
+     std::exception_ptr error;
+
+     struct FinalAwaiter {
+         bool await_ready() const noexcept { return false; }
+
+         template <typename Promise>
+         std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept {
+             return handle.promise().continuation;
+         }
+
+         void await_resume() const noexcept {}
+     };
+
+     std::suspend_always initial_suspend() const noexcept { return {}; }
+     FinalAwaiter final_suspend() const noexcept { return {}; }
+     void unhandled_exception() { error = std::current_exception(); }
+ };
+
+ /**
+  * @struct DetachedTask
+  * @brief Fire-and-forget coroutine used to bridge into blocking code
+  */
+ struct DetachedTask {
+     struct promise_type {
+         DetachedTask get_return_object() const noexcept { return {}; }
+         std::suspend_never initial_suspend() const noexcept { return {}; }
+         std::suspend_never final_suspend() const noexcept { return {}; }
+         void return_void() const noexcept {}
+         void unhandled_exception() const noexcept { std::terminate(); }
+     };
+ };
+
+ } // namespace detail
+
+ /**
+  * @class Task
+  * @brief Lazily started coroutine producing a value of type T
+  *
+  * A Task does nothing until it is co_awaited (or passed to syncWait). It
+  * owns its coroutine frame and destroys it when the Task goes away.
+  */
+ template <typename T>
+ class Task {
+ public:
+     struct promise_type : detail::TaskPromiseBase {
+         std::optional<T> value;
+
+         Task get_return_object() noexcept {
+             return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+         }
+
+         template <typename U>
+         void return_value(U&& result) {
+             value.emplace(std::forward<U>(result));
+         }
+     };
+
+     Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+
+     Task& operator=(Task&& other) noexcept {
+         if (this != &other) {
+             if (handle) {
+                 handle.destroy();
+             }
+             handle = std::exchange(other.handle, nullptr);
+         }
+         return *this;
+     }
+
+     Task(const Task&) = delete;
+     Task& operator=(const Task&) = delete;
+
+     ~Task() {
+         if (handle) {
+             handle.destroy();
+         }
+     }
+
+     bool await_ready() const noexcept { return !handle || handle.done(); }
+
+     std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+         handle.promise().continuation = awaiting;
+         return handle;
+     }
+
+     T await_resume() {
+         if (handle.promise().error) {
+             std::rethrow_exception(handle.promise().error);
+         }
+         return std::move(*handle.promise().value);
+     }
+
+ private:
+     explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+     std::coroutine_handle<promise_type> handle;
+ };
+
+ /**
+  * @class Task<void>
+  * @brief Lazily started coroutine producing no value
+  */
+ template <>
+ class Task<void> {
+ public:
+     struct promise_type : detail::TaskPromiseBase {
+         Task get_return_object() noexcept {
+             return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+         }
+
+         void return_void() const noexcept {}
+     };
+
+     Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+
+     Task& operator=(Task&& other) noexcept {
+         if (this != &other) {
+             if (handle) {
+                 handle.destroy();
+             }
+             handle = std::exchange(other.handle, nullptr);
+         }
+         return *this;
+     }
+
+     Task(const Task&) = delete;
+     Task& operator=(const Task&) = delete;
+
+     ~Task() {
+         if (handle) {
+             handle.destroy();
+         }
+     }
+
+     bool await_ready() const noexcept { return !handle || handle.done(); }
+
+     std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+         handle.promise().continuation = awaiting;
+         return handle;
+     }
+
+     void await_resume() {
+         if (handle.promise().error) {
+             std::rethrow_exception(handle.promise().error);
+         }
+     }
+
+ private:
+     explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+     std::coroutine_handle<promise_type> handle;
+ };
+
+ /**
+  * @struct ScheduleAwaiter
+  * @brief Awaitable that resumes the awaiting coroutine on a ThreadPool
+  */
+ struct ScheduleAwaiter {
+     ThreadPool& pool;
+
+     bool await_ready() const noexcept { return false; }
+     void await_suspend(std::coroutine_handle<> handle) const { pool.submit([handle] { handle.resume(); }); }
+     void await_resume() const noexcept {}
+ };
+
+ /**
+  * @brief Moves the awaiting coroutine onto a pool
+  *
+  * @param pool Pool whose worker should continue the coroutine
+  * @return Awaitable to co_await
+  */
+ inline ScheduleAwaiter resumeOn(ThreadPool& pool) {
+     return ScheduleAwaiter{pool};
+ }
+
+ /**
+  * @brief Starts a task without waiting for it and hands its result to a callback
+  *
+  * The task runs inline until its first suspension; the callback is invoked
+  * on whichever thread finishes the task. Used by event loops that must not
+  * block. The task must not throw (an escaping exception terminates).
+  *
+  * @param task The task to start
+  * @param done Callable taking the task's result
+  */
+ template <typename T, typename Callback>
+ void spawn(Task<T> task, Callback done) {
+     [](Task<T> task, Callback done) -> detail::DetachedTask {
+         done(co_await std::move(task));
+     }(std::move(task), std::move(done));
+ }
+
+ /**
+  * @brief Runs a task to completion and blocks until it has finished
+  *
+  * For use at the edges of the program (main, tools); never call it from
+  * a coroutine running on the thread it would block.
+  *
+  * @param task The task to run
+  * @return The task's result (exceptions are rethrown)
+  */
+ template <typename T>
+ T syncWait(Task<T> task) {
+     std::mutex mutex;
+     std::condition_variable finished;
+     bool done = false;
+     std::optional<T> result;
+     std::exception_ptr error;
+
+     auto runner = [&]() -> detail::DetachedTask {
+         try {
+             result.emplace(co_await std::move(task));
+         } catch (...) {
+             error = std::current_exception();
+         }
+         std::lock_guard<std::mutex> lock(mutex);
+         done = true;
+         finished.notify_one();
+     };
+     runner();
+
+     std::unique_lock<std::mutex> lock(mutex);
+     finished.wait(lock, [&done] { return done; });
+     if (error) {
+         std::rethrow_exception(error);
+     }
+     return std::move(*result);
+ }
+
+ /**
+  * @brief Runs a void task to completion and blocks until it has finished
+  *
+  * @param task The task to run
+  */
+ inline void syncWait(Task<void> task) {
+     std::mutex mutex;
+     std::condition_variable finished;
+     bool done = false;
+     std::exception_ptr error;
+
+     auto runner = [&]() -> detail::DetachedTask {
+         try {
+             co_await std::move(task);
+         } catch (...) {
+             error = std::current_exception();
+         }
+         std::lock_guard<std::mutex> lock(mutex);
+         done = true;
+         finished.notify_one();
+     };
+     runner();
+
+     std::unique_lock<std::mutex> lock(mutex);
+     finished.wait(lock, [&done] { return done; });
+     if (error) {
+         std::rethrow_exception(error);
+     }
+ }
+
+ #endif // TASK_HPP
@@ -0,0 +1,257 @@
+/**
+ * @file ThreadPool.hpp
+ * @brief Header file declaring the work-stealing thread pool
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the declarations of the ThreadPool and TaskGroup classes,
+ * the shared threading infrastructure of the library management system. Any
+ * background or parallel work (loading, searching, index builds) is scheduled
+ * on a pool instead of spawning ad-hoc std::threads.
+ */
+
+ #ifndef THREAD_POOL_HPP
+ #define THREAD_POOL_HPP
+
+ #include <algorithm>
+ #include <atomic>
+ #include <condition_variable>
+ #include <cstddef>
+ #include <cstdint>
+ #include <deque>
+ #include <exception>
+ #include <functional>
+ #include <memory>
+ #include <mutex>
+ #include <thread>
+ #include <vector>
+
+ /**
+  * @class ThreadPool
+  * @brief Fixed-size pool of worker threads with per-worker task deques
+  *
+  * Every worker owns a deque. Tasks submitted from a worker go to the back of
+  * its own deque and are popped from the back (LIFO, cache friendly); tasks
+  * submitted from outside the pool are spread round-robin. A worker whose
+  * deque is empty steals from the front of another worker's deque before it
+  * goes to sleep.
+  */
+ class ThreadPool {
+ public:
+     /// @brief A unit of work
+     using Task = std::function<void()>;
+
+     /**
+      * @struct Stats
+      * @brief Point-in-time counters describing pool load
+      */
+     struct Stats {
+         std::size_t workers;      /// @brief Number of worker threads
+         std::size_t busyWorkers;  /// @brief Threads currently running a task
+         std::size_t queuedTasks;  /// @brief Tasks waiting in any deque
+         std::uint64_t submitted;  /// @brief Tasks submitted since start
+         std::uint64_t executed;   /// @brief Tasks finished since start
+         std::uint64_t steals;     /// @brief Tasks taken from another worker's deque
+
+         /**
+          * @brief Fraction of threads that are busy
+          * @return Value in [0, 1]
+          */
+         double saturation() const {
+             return workers == 0 ? 0.0 : static_cast<double>(busyWorkers) / static_cast<double>(workers);
+         }
+     };
+
+     /**
+      * @brief Starts the worker threads
+      *
+      * @param threads Number of workers; 0 selects std::thread::hardware_concurrency()
+      * @param pinThreads If true, worker i is pinned to CPU i (Linux only)
+      */
+     explicit ThreadPool(std::size_t threads = 0, bool pinThreads = false);
+
+     /**
+      * @brief Drains all queued tasks and joins the workers
+      */
+     ~ThreadPool();
+
+     ThreadPool(const ThreadPool&) = delete;
+     ThreadPool& operator=(const ThreadPool&) = delete;
+
+     /**
+      * @brief Gets the process-wide pool shared by all Library subsystems
+      *
+      * Created on first use with the settings given to configureShared().
+      *
+      * @return Reference to the shared pool
+      */
+     static ThreadPool& shared();
+
+     /**
+      * @brief Gets the process-wide single-threaded pool reserved for blocking I/O
+      *
+      * Disk writes run here so they never occupy the
+      * CPU workers of shared() or the caller's event loop.
+      *
+      * @return Reference to the I/O pool
+      */
+     static ThreadPool& io();
+
+     /**
+      * @brief Sets the size and pinning of the shared pool
+      *
+      * Has no effect once shared() has been called.
+      *
+      * @param threads Number of workers; 0 selects the hardware concurrency
+      * @param pinThreads Whether to pin workers to CPUs
+      */
+     static void configureShared(std::size_t threads, bool pinThreads);
+
+     /**
+      * @brief Queues a task for execution
+      *
+      * Exceptions escaping the task are reported to stderr and dropped;
+      * use a TaskGroup to propagate them.
+      *
+      * @param task The work to run
+      */
+     void submit(Task task);
+
+     /**
+      * @brief Runs one queued task on the calling thread, if any
+      *
+      * Lets threads that wait for results help instead of blocking, which
+      * also keeps nested fork/join from deadlocking.
+      *
+      * @return true if a task was run, false if every deque was empty
+      */
+     bool runPendingTask();
+
+     /**
+      * @brief Tells whether the calling thread is one of this pool's workers
+      * @return true on a worker of this pool
+      */
+     bool isWorker() const;
+
+     /**
+      * @brief Gets the number of worker threads
+      * @return Worker count
+      */
+     std::size_t size() const;
+
+     /**
+      * @brief Gets the current load counters
+      * @return Snapshot of the pool statistics
+      */
+     Stats stats() const;
+
+     /**
+      * @brief Runs fn over [begin, end) split into ranges of at most grain items
+      *
+      * Blocks until every range has been processed; the calling thread helps.
+      * Exceptions thrown by fn are rethrown here.
+      *
+      * @param begin First index
+      * @param end One past the last index
+      * @param grain Maximum number of indices per task (at least 1)
+      * @param fn Callable taking (std::size_t first, std::size_t last)
+      */
+     template <typename Fn>
+     void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Fn&& fn);
+
+ private:
+     /**
+      * @struct Worker
+      * @brief A worker thread and the deque it owns
+      */
+     struct Worker {
+         std::mutex mutex;
+         std::deque<Task> tasks;
+         std::thread thread;
+     };
+
+     std::vector<std::unique_ptr<Worker>> workers;
+
+     std::mutex sleepMutex;
+     std::condition_variable wake;
+     std::atomic<bool> stopping{false};
+
+     std::atomic<std::size_t> nextQueue{0};
+     std::atomic<std::size_t> queued{0};
+     std::atomic<std::size_t> busy{0};
+     std::atomic<std::uint64_t> submitted{0};
+     std::atomic<std::uint64_t> executed{0};
+     std::atomic<std::uint64_t> steals{0};
+
+     void workerLoop(std::size_t index, bool pin);
+     bool popLocal(std::size_t index, Task& task);
+     bool steal(std::size_t thief, Task& task);
+     void execute(Task& task);
+ };
+
+ /**
+  * @class TaskGroup
+  * @brief Fork/join helper: run tasks on a pool, then wait for all of them
+  *
+  * The destructor waits as well, so a group never outlives its tasks. The
+  * first exception thrown by any task is rethrown from wait().
+  */
+ class TaskGroup {
+ public:
+     /**
+      * @brief Creates an empty group bound to a pool
+      * @param pool The pool that runs the tasks
+      */
+     explicit TaskGroup(ThreadPool& pool);
+
+     /**
+      * @brief Waits for outstanding tasks (exceptions are swallowed)
+      */
+     ~TaskGroup();
+
+     TaskGroup(const TaskGroup&) = delete;
+     TaskGroup& operator=(const TaskGroup&) = delete;
+
+     /**
+      * @brief Forks a task
+      * @param task The work to run
+      */
+     void run(ThreadPool::Task task);
+
+     /**
+      * @brief Joins: blocks until every forked task has finished
+      *
+      * The calling thread runs queued tasks while it waits.
+      */
+     void wait();
+
+ private:
+     ThreadPool& pool;
+     std::size_t pending = 0;
+     std::exception_ptr error;
+     std::mutex mutex;
+     std::condition_variable done;
+ };
+
+ template <typename Fn>
+ void ThreadPool::parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Fn&& fn) {
+     grain = std::max<std::size_t>(grain, 1);
+     if (end <= begin) {
+         return;
+     }
+
+     // A single range is not worth a round trip through the pool
+     if (end - begin <= grain) {
+         fn(begin, end);
+         return;
+     }
+
+     TaskGroup group(*this);
+     for (std::size_t first = begin; first < end; first += grain) {
+         std::size_t last = std::min(first + grain, end);
+         group.run([&fn, first, last] { fn(first, last); });
+     }
+     group.wait();
+ }
+
+ #endif // THREAD_POOL_HPP
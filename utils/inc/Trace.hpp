@@ -0,0 +1,204 @@
+/**
+ * @file Trace.hpp
+ * @brief Header file declaring the workload trace format
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the declaration of the Trace namespace: a compact
+ * binary record of Library calls (operation, arguments, calling thread
+ * and time) that is written while the program serves real traffic and
+ * read back by bin/replay to drive a fresh Library with the same mix and
+ * arrival pattern.
+ */
+
+ #ifndef TRACE_HPP
+ #define TRACE_HPP
+
+ #include <chrono>
+ #include <cstddef>
+ #include <cstdint>
+ #include <fstream>
+ #include <mutex>
+ #include <span>
+ #include <string>
+ #include <vector>
+
+ /**
+  * @namespace Trace
+  * @brief Namespace containing the trace recorder and reader
+  *
+  * A trace starts with the 8 bytes "LBTRACE1", followed by one record per
+  * call:
+  *
+  *     op (1 byte) | thread (varint) | time delta in ns (varint) | arguments
+  *
+  * Integers are LEB128 varints (signed ones zigzag-encoded first) and
+  * strings are a varint length followed by the bytes. The arguments depend
+  * on the operation:
+  *
+  *     Add                       title, author, year
+  *     Remove, FindById,
+  *     Borrow, Return            id
+  *     FindByTitle               title
+  *     FindByAuthor              author
+  *     Update                    id, version, title, author, year
+  *     BorrowMany, ReturnMany    count, ids...
+  *
+  * The delta is measured from the previous record, so times are always
+  * increasing and a lookup costs about 5 bytes.
+  */
+ namespace Trace {
+     /**
+      * @enum Op
+      * @brief Recorded Library operations
+      */
+     enum class Op : std::uint8_t {
+         Add = 1,        ///< addBook / addBookAsync
+         Remove,         ///< removeBook / removeBookAsync
+         FindById,       ///< findBookById
+         FindByTitle,    ///< findBooksByTitle
+         FindByAuthor,   ///< findBooksByAuthor
+         Borrow,         ///< borrowBook / borrowBookAsync
+         Return,         ///< returnBook / returnBookAsync
+         Update,         ///< updateBook / updateBookAsync
+         BorrowMany,     ///< borrowBooks
+         ReturnMany      ///< returnBooks
+     };
+
+     /// @brief Number of Op values; Op values run from 1 to kOpCount
+     constexpr std::size_t kOpCount = 10;
+
+     /**
+      * @brief Gets the name of an operation
+      * @param op The operation
+      * @return Name such as "borrowBook"
+      */
+     const char* opName(Op op);
+
+     /**
+      * @struct Call
+      * @brief One recorded call
+      *
+      * Only the fields the operation uses are set; searches keep their
+      * text in title or author.
+      */
+     struct Call {
+         Op op = Op::FindById;
+         std::uint32_t thread = 0;      ///< Recording thread, numbered from 0
+         std::uint64_t timeNs = 0;      ///< Time since the trace started
+         int id = 0;
+         std::uint64_t version = 0;
+         int year = 0;
+         std::string title;
+         std::string author;
+         std::vector<int> ids;
+     };
+
+     /**
+      * @class Recorder
+      * @brief Appends calls to a trace file
+      *
+      * Safe to share between threads: records are encoded into a buffer
+      * under a mutex, in the order their times were taken, and written to
+      * the file in large chunks.
+      */
+     class Recorder {
+     public:
+         /**
+          * @brief Constructor; creates the file and writes the header
+          * @param path Trace file to write
+          */
+         explicit Recorder(const std::string& path);
+
+         /**
+          * @brief Writes the buffered records
+          */
+         ~Recorder();
+
+         Recorder(const Recorder&) = delete;
+         Recorder& operator=(const Recorder&) = delete;
+
+         /**
+          * @brief Checks whether the file could be created
+          * @return true if records are being written
+          */
+         bool valid() const;
+
+         /**
+          * @brief Records a call taking a book ID
+          *
+          * @param op Remove, FindById, Borrow or Return
+          * @param id The book ID
+          */
+         void record(Op op, int id);
+
+         /**
+          * @brief Records a search
+          *
+          * @param op FindByTitle or FindByAuthor
+          * @param text The searched text
+          */
+         void record(Op op, const std::string& text);
+
+         /**
+          * @brief Records a call taking several book IDs
+          *
+          * @param op BorrowMany or ReturnMany
+          * @param ids The book IDs
+          */
+         void record(Op op, std::span<const int> ids);
+
+         /**
+          * @brief Records an addBook call
+          *
+          * @param title Title of the book
+          * @param author Author of the book
+          * @param year Publication year
+          */
+         void recordAdd(const std::string& title, const std::string& author, int year);
+
+         /**
+          * @brief Records an updateBook call
+          *
+          * @param id The book ID
+          * @param version Expected version
+          * @param title New title
+          * @param author New author
+          * @param year New publication year
+          */
+         void recordUpdate(int id, std::uint64_t version, const std::string& title,
+                           const std::string& author, int year);
+
+         /**
+          * @brief Writes the buffered records to the file
+          * @return true if everything so far has been written
+          */
+         bool flush();
+
+     private:
+         std::ofstream file;
+         std::mutex mutex;
+         std::string buffer;
+         std::chrono::steady_clock::time_point start;
+         std::uint64_t lastNs;
+         bool failed;
+
+         void beginRecord(Op op);
+         void endRecord();
+         void appendVarint(std::uint64_t value);
+         void appendSigned(std::int64_t value);
+         void appendString(const std::string& text);
+     };
+
+     /**
+      * @brief Reads a whole trace into memory
+      *
+      * @param path Trace file to read
+      * @param calls Receives the calls in recorded order
+      * @return false if the file cannot be read or is not a complete trace
+      *         (reported to stderr); calls then holds the records read so far
+      */
+     bool readFile(const std::string& path, std::vector<Call>& calls);
+ }
+
+ #endif // TRACE_HPP
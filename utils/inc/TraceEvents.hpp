@@ -0,0 +1,131 @@
+/**
+ * @file TraceEvents.hpp
+ * @brief Header file declaring the Chrome trace-event profiler
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file contains the declaration of the TraceEvents namespace, which
+ * writes scoped spans (loading, saving, JSON parsing and serialization,
+ * searches) as Chrome trace-event JSON. The file opens in Perfetto
+ * (ui.perfetto.dev) or chrome://tracing and shows where the time of a slow
+ * startup or save goes, thread by thread.
+ */
+
+ #ifndef TRACE_EVENTS_HPP
+ #define TRACE_EVENTS_HPP
+
+ #include <atomic>
+ #include <cstdint>
+ #include <string>
+
+ /**
+  * @namespace TraceEvents
+  * @brief Namespace containing the span profiler
+  *
+  * Tracing is off unless start() is called, which the program does for
+  * --trace-events <file> or the LIBRARY_TRACE_EVENTS environment variable.
+  * While it is off a Span costs one relaxed atomic load. While it is on,
+  * each finished span appends one complete ("ph":"X") event to a buffer
+  * that is written to the file in large chunks.
+  *
+  * The file uses the JSON array format; the closing bracket is written by
+  * stop() (also run at exit), but the viewers accept a file without it,
+  * so a crashed run can still be inspected.
+  */
+ namespace TraceEvents {
+     /// @brief Whether spans are being written; read through enabled()
+     extern std::atomic<bool> recording;
+
+     /**
+      * @brief Checks whether spans are being written
+      * @return true between start() and stop()
+      */
+     inline bool enabled() {
+         return recording.load(std::memory_order_relaxed);
+     }
+
+     /**
+      * @brief Starts writing spans to a file
+      *
+      * stop() is registered to run at exit.
+      *
+      * @param path File to write
+      * @return false if the file cannot be created (reported to stderr)
+      */
+     bool start(const std::string& path);
+
+     /**
+      * @brief Starts writing spans if LIBRARY_TRACE_EVENTS names a file
+      * @return false if the variable is set but the file cannot be created
+      */
+     bool startFromEnvironment();
+
+     /**
+      * @brief Stops writing spans and completes the file
+      */
+     void stop();
+
+     /**
+      * @class Span
+      * @brief Records the lifetime of a scope as one trace event
+      *
+      * Names and argument keys must be string literals (or otherwise
+      * outlive the span) and need no JSON escaping.
+      */
+     class Span {
+     public:
+         /**
+          * @brief Constructor; starts the span if tracing is enabled
+          * @param name Event name, e.g. "Library::loadBooks"
+          */
+         explicit Span(const char* name) : name(name), active(enabled()) {
+             if (active) {
+                 startNs = now();
+             }
+         }
+
+         /**
+          * @brief Destructor; writes the event
+          */
+         ~Span() {
+             if (active) {
+                 finish();
+             }
+         }
+
+         Span(const Span&) = delete;
+         Span& operator=(const Span&) = delete;
+
+         /**
+          * @brief Attaches a number shown with the event (up to two per span)
+          *
+          * @param key Argument name
+          * @param value Argument value
+          */
+         void arg(const char* key, long long value) {
+             if (active && argCount < 2) {
+                 keys[argCount] = key;
+                 values[argCount] = value;
+                 ++argCount;
+             }
+         }
+
+         /**
+          * @brief Reads the clock used for all events
+          * @return Steady-clock nanoseconds
+          */
+         static std::uint64_t now();
+
+     private:
+         const char* name;
+         bool active;
+         std::uint64_t startNs = 0;
+         int argCount = 0;
+         const char* keys[2] = {};
+         long long values[2] = {};
+
+         void finish();
+     };
+ }
+
+ #endif // TRACE_EVENTS_HPP
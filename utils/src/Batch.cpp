@@ -0,0 +1,344 @@
+/**
+ * @file Batch.cpp
+ * @brief Implementation of the non-interactive batch command mode
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements the batch interpreter declared in Batch.hpp: a small
+ * tokenizer for quoted arguments, one handler per command and the
+ * tab-separated output format.
+ */
+
+ #include "Batch.hpp"
+ #include "Export.hpp"
+ #include "Latency.hpp"
+ #include "Memory.hpp"
+ #include "ThreadPool.hpp"
+ #include <charconv>
+ #include <cstdint>
+ #include <fstream>
+ #include <string>
+ #include <vector>
+
+ namespace {
+
+ /**
+  * @brief Splits a command line into arguments
+  *
+  * @param line The command line
+  * @param args Receives the arguments
+  * @return false if a quoted argument is not terminated
+  */
+ bool tokenize(const std::string& line, std::vector<std::string>& args) {
+     args.clear();
+     std::size_t i = 0;
+     while (i < line.size()) {
+         if (line[i] == ' ' || line[i] == '\t' || line[i] == '\r') {
+             ++i;
+             continue;
+         }
+
+         std::string arg;
+         if (line[i] == '"') {
+             ++i;
+             bool closed = false;
+             while (i < line.size()) {
+                 char c = line[i++];
+                 if (c == '"') {
+                     closed = true;
+                     break;
+                 }
+                 if (c == '\\' && i < line.size()) {
+                     c = line[i++];
+                 }
+                 arg += c;
+             }
+             if (!closed) {
+                 return false;
+             }
+         } else {
+             while (i < line.size() && line[i] != ' ' && line[i] != '\t' && line[i] != '\r') {
+                 arg += line[i++];
+             }
+         }
+         args.push_back(std::move(arg));
+     }
+     return true;
+ }
+
+ /**
+  * @brief Parses a whole argument as a number
+  *
+  * @param text The argument
+  * @param value Receives the number
+  * @return true if the entire argument is a valid number
+  */
+ template <typename Number>
+ bool parseNumber(const std::string& text, Number& value) {
+     const char* end = text.data() + text.size();
+     auto result = std::from_chars(text.data(), end, value);
+     return !text.empty() && result.ec == std::errc() && result.ptr == end;
+ }
+
+ /**
+  * @brief Writes a text field, escaping characters that would break the format
+  *
+  * @param out Output stream
+  * @param text The field value
+  */
+ void writeField(std::ostream& out, const std::string& text) {
+     for (char c : text) {
+         switch (c) {
+             case '\t': out << "\\t"; break;
+             case '\n': out << "\\n"; break;
+             case '\\': out << "\\\\"; break;
+             default: out << c;
+         }
+     }
+ }
+
+ /**
+  * @brief Writes one "book" record
+  *
+  * @param out Output stream
+  * @param book The book to write
+  */
+ void writeBook(std::ostream& out, const Book& book) {
+     out << "book\t" << book.getId() << '\t';
+     writeField(out, book.getTitle());
+     out << '\t';
+     writeField(out, book.getAuthor());
+     out << '\t' << book.getYear() << '\t' << (book.isAvailable() ? 1 : 0)
+         << '\t' << book.getVersion() << '\n';
+ }
+
+ /**
+  * @brief Executes a single tokenized command
+  *
+  * @param library The library to operate on
+  * @param args Command name followed by its arguments (at least one element)
+  * @param out Output stream
+  * @param changed Set to true if the command changed the catalog
+  * @return Empty string on success, otherwise the reason for the failure
+  */
+ std::string execute(Library& library, const std::vector<std::string>& args, std::ostream& out,
+                     bool& changed) {
+     const std::string& command = args[0];
+
+     if (command == "add") {
+         int year;
+         if (args.size() != 4 || !parseNumber(args[3], year)) {
+             return "usage: add \"<title>\" \"<author>\" <year>";
+         }
+         int id = library.addBook(args[1], args[2], year);
+         changed = true;
+         out << "ok\tadd\t" << id << '\n';
+         return "";
+     }
+
+     if (command == "borrow" || command == "return") {
+         std::vector<int> ids(args.size() - 1);
+         for (std::size_t i = 1; i < args.size(); ++i) {
+             if (!parseNumber(args[i], ids[i - 1])) {
+                 return "invalid id '" + args[i] + "'";
+             }
+         }
+         if (ids.empty()) {
+             return "usage: " + command + " <id> [<id> ...]";
+         }
+
+         bool borrowing = command == "borrow";
+         bool done = ids.size() == 1
+             ? (borrowing ? library.borrowBook(ids[0]) : library.returnBook(ids[0]))
+             : (borrowing ? library.borrowBooks(ids) : library.returnBooks(ids));
+         if (!done) {
+             return borrowing ? "not found or already borrowed" : "not found or not borrowed";
+         }
+         changed = true;
+         out << "ok\t" << command << '\n';
+         return "";
+     }
+
+     if (command == "remove") {
+         int id;
+         if (args.size() != 2 || !parseNumber(args[1], id)) {
+             return "usage: remove <id>";
+         }
+         if (!library.removeBook(id)) {
+             return "not found";
+         }
+         changed = true;
+         out << "ok\tremove\n";
+         return "";
+     }
+
+     if (command == "update") {
+         int id, year;
+         std::uint64_t version;
+         if (args.size() != 6 || !parseNumber(args[1], id) || !parseNumber(args[2], version) ||
+             !parseNumber(args[5], year)) {
+             return "usage: update <id> <version> \"<title>\" \"<author>\" <year>";
+         }
+         switch (library.updateBook(id, version, args[3], args[4], year)) {
+             case UpdateResult::Updated: break;
+             case UpdateResult::NotFound: return "not found";
+             case UpdateResult::Conflict: return "version conflict";
+         }
+         changed = true;
+         out << "ok\tupdate\n";
+         return "";
+     }
+
+     if (command == "find") {
+         if (args.size() != 3) {
+             return "usage: find id|title|author <value>";
+         }
+
+         std::vector<Book> books;
+         if (args[1] == "id") {
+             int id;
+             if (!parseNumber(args[2], id)) {
+                 return "invalid id '" + args[2] + "'";
+             }
+             if (std::optional<Book> book = library.findBookById(id)) {
+                 books.push_back(std::move(*book));
+             }
+         } else if (args[1] == "title") {
+             books = library.findBooksByTitle(args[2]);
+         } else if (args[1] == "author") {
+             books = library.findBooksByAuthor(args[2]);
+         } else {
+             return "usage: find id|title|author <value>";
+         }
+
+         for (const Book& book : books) {
+             writeBook(out, book);
+         }
+         out << "ok\tfind\t" << books.size() << '\n';
+         return "";
+     }
+
+     if (command == "list") {
+         if (args.size() != 1) {
+             return "usage: list";
+         }
+         // Stream straight from a pinned snapshot instead of copying the collection
+         Snapshot pinned = library.snapshot();
+         pinned.forEach([&out](const Book& book) { writeBook(out, book); });
+         out << "ok\tlist\t" << pinned.size() << '\n';
+         return "";
+     }
+
+     if (command == "stats") {
+         if (args.size() != 1) {
+             return "usage: stats";
+         }
+         std::size_t reported = 0;
+         for (std::size_t i = 0; i < Latency::kOpCount; ++i) {
+             Latency::Op op = static_cast<Latency::Op>(i);
+             Latency::Histogram histogram = Latency::histogram(op);
+             if (histogram.count() == 0) {
+                 continue;
+             }
+             out << "stat\t" << Latency::opName(op) << '\t' << histogram.count() << '\t'
+                 << histogram.percentile(0.50) << '\t' << histogram.percentile(0.90) << '\t'
+                 << histogram.percentile(0.99) << '\t' << histogram.percentile(0.999) << '\t'
+                 << histogram.max() << '\n';
+             ++reported;
+         }
+         ThreadPool::Stats pool = ThreadPool::shared().stats();
+         out << "pool\t" << pool.workers << '\t' << pool.busyWorkers << '\t' << pool.queuedTasks << '\t'
+             << pool.submitted << '\t' << pool.executed << '\t' << pool.steals << '\n';
+         out << "ok\tstats\t" << reported << '\n';
+         return "";
+     }
+
+     if (command == "memory") {
+         if (args.size() != 1) {
+             return "usage: memory";
+         }
+         for (std::size_t i = 0; i < Memory::kSubsystemCount; ++i) {
+             Memory::Subsystem subsystem = static_cast<Memory::Subsystem>(i);
+             Memory::Usage usage = Memory::usage(subsystem);
+             out << "mem\t" << Memory::subsystemName(subsystem) << '\t' << usage.liveBytes << '\t'
+                 << usage.peakBytes << '\t' << usage.liveBlocks << '\t' << usage.allocations << '\n';
+         }
+         out << "ok\tmemory\t" << Memory::kSubsystemCount << '\n';
+         return "";
+     }
+
+     if (command == "export") {
+         Export::Format format;
+         if ((args.size() != 3 && args.size() != 5) || !Export::parseFormat(args[1], format) ||
+             (args.size() == 5 && args[3] != "title" && args[3] != "author")) {
+             return "usage: export csv|jsonl|json <file> [title|author <value>]";
+         }
+         std::ofstream file(args[2], std::ios::binary | std::ios::trunc);
+         if (!file) {
+             return "cannot open '" + args[2] + "'";
+         }
+
+         std::function<bool(const Book&)> matches;
+         if (args.size() == 5) {
+             bool byTitle = args[3] == "title";
+             const std::string& text = args[4];
+             matches = [byTitle, &text](const Book& book) {
+                 return (byTitle ? book.getTitle() : book.getAuthor()).find(text) != std::string::npos;
+             };
+         }
+         std::size_t rows = Export::write(library.snapshot(), file, format, matches);
+         if (!file) {
+             return "write to '" + args[2] + "' failed";
+         }
+         out << "ok\texport\t" << rows << '\n';
+         return "";
+     }
+
+     return "unknown command";
+ }
+
+ } // namespace
+
+ namespace Batch {
+
+ /**
+  * @brief Implementation of the run function
+  *
+  * Read-only scripts leave the data file untouched.
+  *
+  * @param library The library to operate on
+  * @param in Stream the commands are read from
+  * @param out Stream the results are written to
+  * @return true if nothing changed or the final write of the data file succeeded
+  */
+ bool run(Library& library, std::istream& in, std::ostream& out) {
+     library.setAutoSave(false);
+
+     std::string line;
+     std::vector<std::string> args;
+     bool changed = false;
+     while (std::getline(in, line)) {
+         std::size_t start = line.find_first_not_of(" \t\r");
+         if (start == std::string::npos || line[start] == '#') {
+             continue;
+         }
+
+         std::string error;
+         if (!tokenize(line, args)) {
+             error = "unterminated quote";
+         } else {
+             error = execute(library, args, out, changed);
+         }
+
+         if (!error.empty()) {
+             out << "error\t";
+             writeField(out, args.empty() ? std::string() : args[0]);
+             out << '\t' << error << '\n';
+         }
+     }
+
+     library.setAutoSave(true);
+     return !changed || library.flush();
+ }
+
+ } // namespace Batch
@@ -0,0 +1,198 @@
+/**
+ * @file BookTable.cpp
+ * @brief Implementation of the buffered table renderer for books
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements the BookTable class declared in BookTable.hpp.
+ * Numbers are formatted with std::to_chars directly into the row buffer,
+ * and the buffer goes to the stream whenever it passes kChunkSize.
+ */
+
+ #include "BookTable.hpp"
+ #include <algorithm>
+ #include <charconv>
+
+ namespace {
+
+ /// @brief Buffered bytes at which the buffer is handed to the stream
+ constexpr std::size_t kChunkSize = 64 * 1024;
+
+ /// @brief Width of the "Available" column
+ constexpr std::size_t kAvailableWidth = 9;
+
+ /// @brief Separator between columns
+ constexpr std::string_view kSeparator = " | ";
+
+ /**
+  * @brief Counts the characters of UTF-8 text
+  *
+  * Continuation bytes are not counted, so multi-byte characters take one
+  * column like they do on the terminal.
+  *
+  * @param text The text
+  * @return Number of characters
+  */
+ std::size_t displayWidth(std::string_view text) {
+     std::size_t width = 0;
+     for (char c : text) {
+         if ((static_cast<unsigned char>(c) & 0xC0) != 0x80) {
+             ++width;
+         }
+     }
+     return width;
+ }
+
+ /**
+  * @brief Counts the characters of a number written in decimal
+  * @param value The number
+  * @return Number of characters, including a minus sign
+  */
+ std::size_t numberWidth(long long value) {
+     char digits[24];
+     return static_cast<std::size_t>(std::to_chars(digits, digits + sizeof(digits), value).ptr - digits);
+ }
+
+ } // namespace
+
+ /**
+  * @brief Constructor implementation
+  *
+  * Columns start as wide as their titles.
+  *
+  * @param out Stream the table is written to
+  */
+ BookTable::BookTable(std::ostream& out)
+     : out(out), idWidth(2), titleWidth(5), authorWidth(6), yearWidth(4) {
+     buffer.reserve(kChunkSize + 1024);
+ }
+
+ /**
+  * @brief Destructor implementation
+  */
+ BookTable::~BookTable() {
+     flush();
+ }
+
+ /**
+  * @brief Implementation of the measure method
+  * @param book A book that will be printed
+  */
+ void BookTable::measure(const Book& book) {
+     idWidth = std::max(idWidth, numberWidth(book.getId()));
+     yearWidth = std::max(yearWidth, numberWidth(book.getYear()));
+
+     // Text no longer in bytes than its column cannot widen it
+     const std::string& title = book.getTitle();
+     if (title.size() > titleWidth && titleWidth < kMaxTextWidth) {
+         titleWidth = std::max(titleWidth, std::min(kMaxTextWidth, displayWidth(title)));
+     }
+     const std::string& author = book.getAuthor();
+     if (author.size() > authorWidth && authorWidth < kMaxTextWidth) {
+         authorWidth = std::max(authorWidth, std::min(kMaxTextWidth, displayWidth(author)));
+     }
+ }
+
+ /**
+  * @brief Implementation of the writeHeader method
+  */
+ void BookTable::writeHeader() {
+     writeRule();
+     appendPadded("ID", idWidth);
+     append(kSeparator);
+     appendPadded("Title", titleWidth);
+     append(kSeparator);
+     appendPadded("Author", authorWidth);
+     append(kSeparator);
+     appendPadded("Year", yearWidth);
+     append(kSeparator);
+     append("Available");
+     endLine();
+     writeRule();
+ }
+
+ /**
+  * @brief Implementation of the writeRule method
+  */
+ void BookTable::writeRule() {
+     std::size_t width = idWidth + titleWidth + authorWidth + yearWidth + kAvailableWidth + 4 * kSeparator.size();
+     buffer.append(width, '-');
+     endLine();
+ }
+
+ /**
+  * @brief Implementation of the writeRow method
+  * @param book The book to write
+  */
+ void BookTable::writeRow(const Book& book) {
+     appendNumber(book.getId(), idWidth);
+     append(kSeparator);
+     appendPadded(book.getTitle(), titleWidth);
+     append(kSeparator);
+     appendPadded(book.getAuthor(), authorWidth);
+     append(kSeparator);
+     appendNumber(book.getYear(), yearWidth);
+     append(kSeparator);
+     append(book.isAvailable() ? "Yes" : "No");
+     endLine();
+ }
+
+ /**
+  * @brief Implementation of the flush method
+  */
+ void BookTable::flush() {
+     if (!buffer.empty()) {
+         out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+         buffer.clear();
+     }
+     out.flush();
+ }
+
+ /**
+  * @brief Appends text as it is
+  * @param text The text
+  */
+ void BookTable::append(std::string_view text) {
+     buffer.append(text);
+ }
+
+ /**
+  * @brief Appends text left-aligned in a column
+  *
+  * @param text The text
+  * @param width Column width in characters
+  */
+ void BookTable::appendPadded(std::string_view text, std::size_t width) {
+     buffer.append(text);
+     std::size_t used = displayWidth(text);
+     if (used < width) {
+         buffer.append(width - used, ' ');
+     }
+ }
+
+ /**
+  * @brief Appends a number right-aligned in a column
+  *
+  * @param value The number
+  * @param width Column width in characters
+  */
+ void BookTable::appendNumber(long long value, std::size_t width) {
+     char digits[24];
+     char* end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+     std::size_t used = static_cast<std::size_t>(end - digits);
+     if (used < width) {
+         buffer.append(width - used, ' ');
+     }
+     buffer.append(digits, used);
+ }
+
+ /**
+  * @brief Ends the current line and hands a full buffer to the stream
+  */
+ void BookTable::endLine() {
+     buffer += '\n';
+     if (buffer.size() >= kChunkSize) {
+         out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+         buffer.clear();
+     }
+ }
@@ -12,11 +12,142 @@
  */
 
  #include "Display.hpp"
+ #include "BookTable.hpp"
+ #include "IncrementalSearch.hpp"
+ #include "Latency.hpp"
+ #include "Memory.hpp"
+ #include <algorithm>
+ #include <chrono>
  #include <iostream>
+ #include <poll.h>
+ #include <termios.h>
+ #include <unistd.h>
  #include <string>
+ #include <vector>
  #include <limits>  // For std::numeric_limits
  #include <ctime>   // For time functions
  
+ namespace {
+ 
+ /// @brief Books per page when browsing
+ constexpr std::size_t kDefaultPageSize = 20;
+ 
+ /// @brief Largest page size the user may choose
+ constexpr std::size_t kMaxPageSize = 1000;
+ 
+ /// @brief Matches shown while searching as you type
+ constexpr std::size_t kLiveRows = 15;
+ 
+ /**
+  * @class RawTerminal
+  * @brief Puts standard input into unbuffered, unechoed mode for its lifetime
+  * 
+  * Signal keys are disabled as well, so Ctrl+C reaches the search as a key
+  * and the terminal is always restored.
+  */
+ class RawTerminal {
+ public:
+     RawTerminal() {
+         active = tcgetattr(STDIN_FILENO, &saved) == 0;
+         if (active) {
+             termios raw = saved;
+             raw.c_lflag &= ~static_cast<tcflag_t>(ICANON | ECHO | ISIG);
+             raw.c_cc[VMIN] = 1;
+             raw.c_cc[VTIME] = 0;
+             active = tcsetattr(STDIN_FILENO, TCSANOW, &raw) == 0;
+         }
+     }
+     
+     ~RawTerminal() {
+         if (active) {
+             tcsetattr(STDIN_FILENO, TCSANOW, &saved);
+         }
+     }
+     
+     RawTerminal(const RawTerminal&) = delete;
+     RawTerminal& operator=(const RawTerminal&) = delete;
+     
+     bool valid() const { return active; }
+     
+ private:
+     termios saved{};
+     bool active = false;
+ };
+ 
+ /**
+  * @brief Redraws the search-as-you-type screen
+  * 
+  * @param search The search engine
+  * @param result Latest result, or nullptr before the first one
+  * @param query The query as typed so far
+  * @param latency Milliseconds from the keystroke to this result, or negative to omit
+  */
+ void drawLiveSearch(const IncrementalSearch& search, const IncrementalSearch::Result* result,
+                     const std::string& query, double latency) {
+     // Home the cursor and clear the screen
+     std::cout << "\x1b[H\x1b[2J";
+     
+     if (result && !result->matches->empty()) {
+         BookTable table(std::cout);
+         std::size_t shown = std::min(kLiveRows, result->matches->size());
+         for (std::size_t i = 0; i < shown; ++i) {
+             table.measure(search.book((*result->matches)[i]));
+         }
+         table.writeHeader();
+         for (std::size_t i = 0; i < shown; ++i) {
+             table.writeRow(search.book((*result->matches)[i]));
+         }
+         table.writeRule();
+     }
+     
+     if (result) {
+         std::cout << result->matches->size() << (result->complete ? "" : "+") << " of " << search.size()
+                   << " books match" << (result->complete ? "" : ", still searching");
+         if (latency >= 0) {
+             std::cout << " (" << static_cast<int>(latency * 10) / 10.0 << " ms)";
+         }
+         std::cout << "\n";
+     } else {
+         std::cout << "Searching...\n";
+     }
+     std::cout << "Enter or Esc to finish. Search title or author: " << query << std::flush;
+ }
+ 
+ /**
+  * @brief Reads a positive number for a browsing command
+  * 
+  * @param value Receives the number
+  * @return false if the input was not a positive number
+  */
+ bool readCount(std::size_t& value) {
+     long long number;
+     if (!(std::cin >> number) || number <= 0) {
+         std::cin.clear();
+         std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+         return false;
+     }
+     value = static_cast<std::size_t>(number);
+     return true;
+ }
+ 
+ /**
+  * @brief Prints search results as one aligned table
+  * @param books The books to print
+  */
+ void printBooks(const std::vector<Book>& books) {
+     BookTable table(std::cout);
+     for (const auto& book : books) {
+         table.measure(book);
+     }
+     table.writeHeader();
+     for (const auto& book : books) {
+         table.writeRow(book);
+     }
+     table.writeRule();
+ }
+ 
+ } // namespace
+ 
  namespace Display {
  
  /**
@@ -34,6 +165,9 @@
      std::cout << "4. Return a book\n";
      std::cout << "5. Display all books\n";
      std::cout << "6. Remove a book\n";
+     std::cout << "7. Search as you type\n";
+     std::cout << "8. Show operation latencies\n";
+     std::cout << "9. Show memory usage\n";
      std::cout << "0. Exit\n";
      std::cout << "Enter your choice: ";
  }
@@ -126,7 +260,7 @@
      } while (!validInput);
      
      // Now we can add the book since all inputs are valid
-     if (library.addBook(title, author, year)) {
+     if (library.addBook(title, author, year) > 0) {
          std::cout << "Book added successfully.\n";
      } else {
          std::cout << "Failed to add book.\n";
@@ -164,15 +298,11 @@
              std::cin >> id;
              
              // Find and display the book
-             Book* book = library.findBookById(id);
+             std::optional<Book> book = library.findBookById(id);
              if (book) {
                  // Book found, display its details
                  std::cout << "\nBook found:\n";
-                 std::cout << "ID: " << book->getId() << "\n";
-                 std::cout << "Title: " << book->getTitle() << "\n";
-                 std::cout << "Author: " << book->getAuthor() << "\n";
-                 std::cout << "Year: " << book->getYear() << "\n";
-                 std::cout << "Available: " << (book->isAvailable() ? "Yes" : "No") << "\n";
+                 printBooks({*book});
              } else {
                  // Book not found
                  std::cout << "Book not found.\n";
@@ -187,20 +317,12 @@
              std::cout << "Enter book title: ";
              std::getline(std::cin, title);
              
-             // Find and display books with matching titles
-             auto books = library.findBooksByTitle(title);
-             if (!books.empty()) {
-                 // Books found, display their details
-                 std::cout << "\nBooks found:\n";
-                 for (const auto& book : books) {
-                     std::cout << "ID: " << book.getId() << "\n";
-                     std::cout << "Title: " << book.getTitle() << "\n";
-                     std::cout << "Author: " << book.getAuthor() << "\n";
-                     std::cout << "Year: " << book.getYear() << "\n";
-                     std::cout << "Available: " << (book.isAvailable() ? "Yes" : "No") << "\n";
-                     std::cout << "--------------------\n";
-                 }
-             } else {
+             // Page through the books with matching titles
+             std::cout << "\nBooks found:\n";
+             bool found = browseBooks(library, [&title](const Book& book) {
+                 return book.getTitle().find(title) != std::string::npos;
+             });
+             if (!found) {
                  // No books found
                  std::cout << "No books found with that title.\n";
              }
@@ -214,20 +336,12 @@
              std::cout << "Enter author name: ";
              std::getline(std::cin, author);
              
-             // Find and display books by the specified author
-             auto books = library.findBooksByAuthor(author);
-             if (!books.empty()) {
-                 // Books found, display their details
-                 std::cout << "\nBooks found:\n";
-                 for (const auto& book : books) {
-                     std::cout << "ID: " << book.getId() << "\n";
-                     std::cout << "Title: " << book.getTitle() << "\n";
-                     std::cout << "Author: " << book.getAuthor() << "\n";
-                     std::cout << "Year: " << book.getYear() << "\n";
-                     std::cout << "Available: " << (book.isAvailable() ? "Yes" : "No") << "\n";
-                     std::cout << "--------------------\n";
-                 }
-             } else {
+             // Page through the books by the specified author
+             std::cout << "\nBooks found:\n";
+             bool found = browseBooks(library, [&author](const Book& book) {
+                 return book.getAuthor().find(author) != std::string::npos;
+             });
+             if (!found) {
                  // No books found
                  std::cout << "No books found by that author.\n";
              }
@@ -239,6 +353,189 @@
      }
  }
  
+ /**
+  * @brief Implementation of the browseBooks function
+  * 
+  * Remembers the cursor of every page seen so far, so going back or
+  * jumping to a page already visited is a single fetch. Jumping further
+  * ahead walks the pages in between once to find their cursors.
+  * 
+  * @param library Reference to the Library object to browse
+  * @param matches Optional predicate selecting the books to show
+  * @return false if no book matched, true otherwise
+  */
+ bool browseBooks(const Library& library, const std::function<bool(const Book&)>& matches) {
+     std::size_t pageSize = kDefaultPageSize;
+     
+     // cursors[k] is the ID after which page k starts
+     std::vector<int> cursors{0};
+     std::size_t current = 0;
+     
+     for (;;) {
+         BookPage page = library.pageAfter(cursors[current], pageSize, matches);
+         if (page.books.empty()) {
+             if (current == 0) {
+                 return false;
+             }
+             // The rest of the listing was removed meanwhile; step back
+             cursors.resize(current);
+             --current;
+             continue;
+         }
+         if (page.hasMore && cursors.size() == current + 1) {
+             cursors.push_back(page.books.back().getId());
+         }
+         
+         printBooks(page.books);
+         std::cout << "Page " << current + 1;
+         if (!matches) {
+             // Without a filter the number of pages is known up front
+             std::size_t total = library.snapshot().size();
+             std::cout << " of " << (total + pageSize - 1) / pageSize;
+         } else if (page.hasMore) {
+             std::cout << " (more follow)";
+         } else {
+             std::cout << " (last)";
+         }
+         std::cout << "\n[n]ext, [p]revious, [j]ump <page>, [s]ize <books>, [q]uit: ";
+         
+         std::string command;
+         if (!(std::cin >> command) || command == "q") {
+             return true;
+         }
+         
+         if (command == "n") {
+             if (page.hasMore) {
+                 ++current;
+             } else {
+                 std::cout << "Already on the last page.\n";
+             }
+         } else if (command == "p") {
+             if (current > 0) {
+                 --current;
+             } else {
+                 std::cout << "Already on the first page.\n";
+             }
+         } else if (command == "j") {
+             std::size_t target;
+             if (!readCount(target)) {
+                 std::cout << "Error: Page must be a positive number.\n";
+                 continue;
+             }
+             // Discover the cursors up to the target, stopping at the last page
+             while (cursors.size() < target) {
+                 BookPage step = library.pageAfter(cursors.back(), pageSize, matches);
+                 if (!step.hasMore) {
+                     break;
+                 }
+                 cursors.push_back(step.books.back().getId());
+             }
+             current = std::min(target, cursors.size()) - 1;
+         } else if (command == "s") {
+             std::size_t size;
+             if (!readCount(size) || size > kMaxPageSize) {
+                 std::cout << "Error: Page size must be between 1 and " << kMaxPageSize << ".\n";
+                 continue;
+             }
+             // Page boundaries depend on the size; start over
+             pageSize = size;
+             cursors.assign(1, 0);
+             current = 0;
+         } else {
+             std::cout << "Invalid command.\n";
+         }
+     }
+ }
+ 
+ /**
+  * @brief Implementation of the liveSearchMenu function
+  * 
+  * Keys are read straight from the terminal. Every change to the query
+  * starts a new background search (which cancels the previous one) and
+  * redraws the screen at once with the matches shown so far; results are
+  * drawn as they arrive, with the time from the keystroke to their arrival.
+  * 
+  * @param library Reference to the Library object to search in
+  */
+ void liveSearchMenu(const Library& library) {
+     using Clock = std::chrono::steady_clock;
+     
+     RawTerminal terminal;
+     if (!isatty(STDIN_FILENO) || !terminal.valid()) {
+         std::cout << "Search as you type needs an interactive terminal.\n";
+         return;
+     }
+     
+     std::cout << "\nIndexing..." << std::flush;
+     IncrementalSearch search(library.snapshot(), kLiveRows);
+     
+     std::string query;
+     std::uint64_t pending = search.update(query);
+     Clock::time_point typed = Clock::now();
+     bool measured = false;
+     IncrementalSearch::Result shown;
+     bool haveResult = false;
+     drawLiveSearch(search, nullptr, query, -1);
+     
+     for (bool done = false; !done;) {
+         pollfd input{STDIN_FILENO, POLLIN, 0};
+         if (poll(&input, 1, 5) > 0) {
+             char keys[64];
+             ssize_t count = read(STDIN_FILENO, keys, sizeof(keys));
+             if (count <= 0) {
+                 break;
+             }
+             
+             bool changed = false;
+             for (ssize_t i = 0; i < count && !done; ++i) {
+                 unsigned char key = static_cast<unsigned char>(keys[i]);
+                 if (key == 27 && i + 1 < count && keys[i + 1] == '[') {
+                     // Skip arrow keys and other escape sequences
+                     for (i += 2; i < count && (keys[i] < 0x40 || keys[i] > 0x7E); ++i) {}
+                 } else if (key == '\n' || key == '\r' || key == 27 || key == 3 || key == 4) {
+                     done = true;
+                 } else if (key == 127 || key == 8) {
+                     // Remove one UTF-8 character
+                     while (!query.empty() && (static_cast<unsigned char>(query.back()) & 0xC0) == 0x80) {
+                         query.pop_back();
+                     }
+                     if (!query.empty()) {
+                         query.pop_back();
+                     }
+                     changed = true;
+                 } else if (key == 21) {
+                     // Ctrl+U clears the query
+                     query.clear();
+                     changed = true;
+                 } else if (key >= 0x20) {
+                     query += static_cast<char>(key);
+                     changed = true;
+                 }
+             }
+             
+             if (changed && !done) {
+                 pending = search.update(query);
+                 typed = Clock::now();
+                 measured = false;
+                 drawLiveSearch(search, haveResult ? &shown : nullptr, query, -1);
+             }
+         }
+         
+         IncrementalSearch::Result result;
+         if (!done && search.takeResult(result)) {
+             double latency = -1;
+             if (result.generation == pending && !measured) {
+                 latency = std::chrono::duration<double, std::milli>(Clock::now() - typed).count();
+                 measured = true;
+             }
+             shown = std::move(result);
+             haveResult = true;
+             drawLiveSearch(search, &shown, query, latency);
+         }
+     }
+     std::cout << "\n";
+ }
+ 
  /**
   * @brief Implementation of the borrowBookMenu function
   * 
@@ -320,4 +617,20 @@
      }
  }
  
+ /**
+  * @brief Implementation of the showStatistics function
+  */
+ void showStatistics() {
+     std::cout << "\n";
+     Latency::printTable(std::cout);
+ }
+ 
+ /**
+  * @brief Implementation of the showMemoryUsage function
+  */
+ void showMemoryUsage() {
+     std::cout << "\n";
+     Memory::printReport(std::cout);
+ }
+ 
  } // namespace Display
\ No newline at end of file
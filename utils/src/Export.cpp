@@ -0,0 +1,218 @@
+/**
+ * @file Export.cpp
+ * @brief Implementation of the machine-readable export formats
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements the Export namespace declared in Export.hpp: CSV
+ * quoting, JSON string escaping and the chunked output buffer.
+ */
+
+ #include "Export.hpp"
+ #include <charconv>
+
+ namespace {
+
+ /// @brief Buffered bytes at which the buffer is handed to the stream
+ constexpr std::size_t kChunkSize = 64 * 1024;
+
+ } // namespace
+
+ namespace Export {
+
+ /**
+  * @brief Implementation of the parseFormat function
+  *
+  * @param name The name
+  * @param format Receives the format
+  * @return false if the name is unknown
+  */
+ bool parseFormat(std::string_view name, Format& format) {
+     if (name == "csv") {
+         format = Format::Csv;
+         return true;
+     }
+     if (name == "jsonl") {
+         format = Format::Jsonl;
+         return true;
+     }
+     if (name == "json") {
+         format = Format::Json;
+         return true;
+     }
+     return false;
+ }
+
+ /**
+  * @brief Constructor implementation
+  *
+  * @param out Stream the rows are written to
+  * @param format Output format
+  */
+ Writer::Writer(std::ostream& out, Format format) : out(out), format(format), written(0), finished(false) {
+     buffer.reserve(kChunkSize + 1024);
+     if (format == Format::Csv) {
+         buffer += "id,title,author,year,available,version\n";
+     } else if (format == Format::Json) {
+         buffer += '[';
+     }
+ }
+
+ /**
+  * @brief Destructor implementation
+  */
+ Writer::~Writer() {
+     finish();
+ }
+
+ /**
+  * @brief Implementation of the write method
+  * @param book The book to write
+  */
+ void Writer::write(const Book& book) {
+     if (format == Format::Csv) {
+         appendNumber(book.getId());
+         buffer += ',';
+         appendCsvField(book.getTitle());
+         buffer += ',';
+         appendCsvField(book.getAuthor());
+         buffer += ',';
+         appendNumber(book.getYear());
+         buffer += book.isAvailable() ? ",true," : ",false,";
+         appendNumber(static_cast<long long>(book.getVersion()));
+     } else {
+         if (format == Format::Json) {
+             buffer += written == 0 ? "\n  " : ",\n  ";
+         }
+         buffer += "{\"id\":";
+         appendNumber(book.getId());
+         buffer += ",\"title\":";
+         appendJsonString(book.getTitle());
+         buffer += ",\"author\":";
+         appendJsonString(book.getAuthor());
+         buffer += ",\"year\":";
+         appendNumber(book.getYear());
+         buffer += book.isAvailable() ? ",\"available\":true,\"version\":" : ",\"available\":false,\"version\":";
+         appendNumber(static_cast<long long>(book.getVersion()));
+         buffer += '}';
+     }
+     if (format != Format::Json) {
+         buffer += '\n';
+     }
+     ++written;
+
+     if (buffer.size() >= kChunkSize) {
+         out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+         buffer.clear();
+     }
+ }
+
+ /**
+  * @brief Implementation of the finish method
+  */
+ void Writer::finish() {
+     if (finished) {
+         return;
+     }
+     finished = true;
+     if (format == Format::Json) {
+         buffer += written == 0 ? "]\n" : "\n]\n";
+     }
+     if (!buffer.empty()) {
+         out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+         buffer.clear();
+     }
+     out.flush();
+ }
+
+ /**
+  * @brief Implementation of the rows method
+  * @return Row count
+  */
+ std::size_t Writer::rows() const {
+     return written;
+ }
+
+ /**
+  * @brief Appends a CSV field, quoting it if it contains special characters
+  * @param text The field value
+  */
+ void Writer::appendCsvField(std::string_view text) {
+     if (text.find_first_of(",\"\r\n") == std::string_view::npos) {
+         buffer.append(text);
+         return;
+     }
+     buffer += '"';
+     for (char c : text) {
+         if (c == '"') {
+             buffer += '"';
+         }
+         buffer += c;
+     }
+     buffer += '"';
+ }
+
+ /**
+  * @brief Appends a JSON string literal
+  *
+  * Quotes, backslashes and control characters are escaped; other bytes,
+  * including UTF-8 sequences, are copied as they are.
+  *
+  * @param text The string value
+  */
+ void Writer::appendJsonString(std::string_view text) {
+     static const char hex[] = "0123456789abcdef";
+     buffer += '"';
+     for (char c : text) {
+         unsigned char byte = static_cast<unsigned char>(c);
+         switch (c) {
+             case '"': buffer += "\\\""; break;
+             case '\\': buffer += "\\\\"; break;
+             case '\n': buffer += "\\n"; break;
+             case '\r': buffer += "\\r"; break;
+             case '\t': buffer += "\\t"; break;
+             default:
+                 if (byte < 0x20) {
+                     buffer += "\\u00";
+                     buffer += hex[byte >> 4];
+                     buffer += hex[byte & 0x0F];
+                 } else {
+                     buffer += c;
+                 }
+         }
+     }
+     buffer += '"';
+ }
+
+ /**
+  * @brief Appends a number in decimal
+  * @param value The number
+  */
+ void Writer::appendNumber(long long value) {
+     char digits[24];
+     char* end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+     buffer.append(digits, static_cast<std::size_t>(end - digits));
+ }
+
+ /**
+  * @brief Implementation of the write function
+  *
+  * @param snapshot The pinned books
+  * @param out Stream the rows are written to
+  * @param format Output format
+  * @param matches Optional predicate selecting the books to write
+  * @return Number of books written
+  */
+ std::size_t write(const Snapshot& snapshot, std::ostream& out, Format format,
+                   const std::function<bool(const Book&)>& matches) {
+     Writer writer(out, format);
+     snapshot.forEach([&writer, &matches](const Book& book) {
+         if (!matches || matches(book)) {
+             writer.write(book);
+         }
+     });
+     writer.finish();
+     return writer.rows();
+ }
+
+ } // namespace Export
@@ -10,6 +10,8 @@
  */
 
  #include "File.hpp"
+ #include "Latency.hpp"
+ #include "TraceEvents.hpp"
  #include <fstream>
  #include <iostream>
  #include <filesystem>
@@ -111,6 +113,8 @@
   * @note Error messages are output to stderr if the file cannot be read
   */
  std::string readFile(const std::string& filename) {
+     Latency::Timer timer(Latency::Op::FileRead);
+     TraceEvents::Span span("FileUtils::readFile");
      // Check if the file exists before attempting to read
      if (!fileExists(filename)) {
          std::cerr << "File does not exist: " << filename << std::endl;
@@ -148,7 +152,10 @@
   * 
   * @note Error messages are output to stderr if the file cannot be written to
   */
- bool writeFile(const std::string& filename, const std::string& content) {
+ bool writeFile(const std::string& filename, std::string_view content) {
+     Latency::Timer timer(Latency::Op::FileWrite);
+     TraceEvents::Span span("FileUtils::writeFile");
+     span.arg("bytes", static_cast<long long>(content.size()));
      // Create parent directories if needed
      if (!createDirectories(filename)) {
          return false;
@@ -0,0 +1,195 @@
+/**
+ * @file IncrementalSearch.cpp
+ * @brief Implementation of the search-as-you-type engine
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements the IncrementalSearch class declared in
+ * IncrementalSearch.hpp. Keys are lowercased once when the snapshot is
+ * indexed, so a keystroke costs one substring search per candidate book.
+ */
+
+ #include "IncrementalSearch.hpp"
+
+ namespace {
+
+ /// @brief Books scanned between two checks for cancellation
+ constexpr std::size_t kCancelCheckInterval = 4096;
+
+ /// @brief Completed results kept for reuse
+ constexpr std::size_t kHistorySize = 16;
+
+ /**
+  * @brief Lowercases the ASCII letters of a string
+  *
+  * @param text The text (UTF-8 sequences are left alone)
+  * @return The lowercased copy
+  */
+ std::string lowercase(std::string text) {
+     for (char& c : text) {
+         if (c >= 'A' && c <= 'Z') {
+             c = static_cast<char>(c - 'A' + 'a');
+         }
+     }
+     return text;
+ }
+
+ } // namespace
+
+ /**
+  * @brief Constructor implementation
+  *
+  * @param snapshot The books to search
+  * @param previewSize Matches after which a partial result is published
+  * @param pool Pool the searches run on
+  */
+ IncrementalSearch::IncrementalSearch(Snapshot snapshot, std::size_t previewSize, ThreadPool& pool)
+     : snapshot(std::move(snapshot)), previewSize(previewSize), running(pool) {
+     books.reserve(this->snapshot.size());
+     keys.reserve(this->snapshot.size());
+     this->snapshot.forEach([this](const Book& book) {
+         books.push_back(&book);
+         keys.emplace_back(lowercase(book.getTitle() + '\n' + book.getAuthor()));
+     });
+ }
+
+ /**
+  * @brief Destructor implementation
+  */
+ IncrementalSearch::~IncrementalSearch() {
+     ++generation;
+     running.wait();
+ }
+
+ /**
+  * @brief Implementation of the update method
+  *
+  * @param query The text to search for
+  * @return Generation of the new search
+  */
+ std::uint64_t IncrementalSearch::update(std::string query) {
+     std::uint64_t mine = ++generation;
+     running.run([this, mine, query = std::move(query)]() mutable { run(mine, std::move(query)); });
+     return mine;
+ }
+
+ /**
+  * @brief Implementation of the takeResult method
+  *
+  * @param result Receives the result
+  * @return false if nothing new was published
+  */
+ bool IncrementalSearch::takeResult(Result& result) {
+     std::lock_guard<std::mutex> lock(mutex);
+     if (publications == taken) {
+         return false;
+     }
+     taken = publications;
+     result = published;
+     return true;
+ }
+
+ /**
+  * @brief Implementation of the book method
+  * @param position Position taken from Result::matches
+  * @return The book
+  */
+ const Book& IncrementalSearch::book(std::uint32_t position) const {
+     return *books[position];
+ }
+
+ /**
+  * @brief Implementation of the size method
+  * @return Book count
+  */
+ std::size_t IncrementalSearch::size() const {
+     return books.size();
+ }
+
+ /**
+  * @brief Runs one search on a pool thread
+  *
+  * @param mine Generation of this search
+  * @param query The text to search for
+  */
+ void IncrementalSearch::run(std::uint64_t mine, std::string query) {
+     std::string needle = lowercase(query);
+
+     // A query containing a completed one can only match a subset of its
+     // matches; start from the narrowest such result
+     std::shared_ptr<const Matches> base;
+     bool exact = false;
+     {
+         std::lock_guard<std::mutex> lock(mutex);
+         for (const Result& done : history) {
+             std::string known = lowercase(done.query);
+             if (known == needle) {
+                 base = done.matches;
+                 exact = true;
+                 break;
+             }
+             if (needle.find(known) != std::string::npos && (!base || done.matches->size() < base->size())) {
+                 base = done.matches;
+             }
+         }
+     }
+     if (exact) {
+         Result result;
+         result.generation = mine;
+         result.query = std::move(query);
+         result.matches = std::move(base);
+         result.complete = true;
+         publish(std::move(result));
+         return;
+     }
+
+     auto matches = std::make_shared<Matches>();
+     std::size_t candidates = base ? base->size() : books.size();
+     for (std::size_t i = 0; i < candidates; ++i) {
+         if (i % kCancelCheckInterval == 0 && generation.load(std::memory_order_relaxed) != mine) {
+             return;
+         }
+
+         std::uint32_t position = base ? (*base)[i] : static_cast<std::uint32_t>(i);
+         if (keys[position].find(needle) == std::string::npos) {
+             continue;
+         }
+         matches->push_back(position);
+
+         // Enough to fill the screen: show it while the scan goes on
+         if (matches->size() == previewSize) {
+             Result preview;
+             preview.generation = mine;
+             preview.query = query;
+             preview.matches = std::make_shared<const Matches>(*matches);
+             publish(std::move(preview));
+         }
+     }
+
+     Result result;
+     result.generation = mine;
+     result.query = std::move(query);
+     result.matches = std::move(matches);
+     result.complete = true;
+     {
+         std::lock_guard<std::mutex> lock(mutex);
+         history.push_front(result);
+         if (history.size() > kHistorySize) {
+             history.pop_back();
+         }
+     }
+     publish(std::move(result));
+ }
+
+ /**
+  * @brief Makes a result available to takeResult() unless a newer one already is
+  * @param result The result
+  */
+ void IncrementalSearch::publish(Result result) {
+     std::lock_guard<std::mutex> lock(mutex);
+     if (result.generation < published.generation) {
+         return;
+     }
+     published = std::move(result);
+     ++publications;
+ }
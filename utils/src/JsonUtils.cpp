@@ -12,12 +12,47 @@
 // utils/src/JsonUtils.cpp
 #include "JsonUtils.hpp"
 #include "File.hpp"
+#include "Latency.hpp"
+#include "TraceEvents.hpp"
+#include "Metrics.hpp"
+#include "Memory.hpp"
+#include "SlowLog.hpp"
 #include <nlohmann/json.hpp>
 #include <iostream>
 
 // Create an alias for the nlohmann::json type to improve code readability
 using json = nlohmann::json;
 
+namespace {
+
+/**
+ * @struct TrackedJson
+ * @brief nlohmann::json variant whose nodes and strings are charged to a subsystem
+ * 
+ * The data file is read and written through these, so the temporary
+ * document of a load or save shows up in the memory report.
+ * 
+ * @tparam S Subsystem charged for the document
+ */
+template <Memory::Subsystem S>
+struct TrackedJson {
+    template <typename T>
+    using Allocator = Memory::Allocator<T, S>;
+    
+    using String = std::basic_string<char, std::char_traits<char>, Allocator<char>>;
+    
+    using type = nlohmann::basic_json<std::map, std::vector, String, bool, std::int64_t, std::uint64_t,
+                                      double, Allocator>;
+};
+
+/// @brief Document parsed while loading the data file
+using LoadJson = TrackedJson<Memory::Subsystem::JsonLoad>::type;
+
+/// @brief Document built while saving the data file
+using SaveJson = TrackedJson<Memory::Subsystem::JsonSave>::type;
+
+} // namespace
+
 namespace JsonUtils {
 
 /**
@@ -37,6 +72,8 @@ namespace JsonUtils {
  * @note Error messages are output to stderr if JSON parsing fails
  */
 std::vector<Book> readBooksFromFile(const std::string& filename) {
+    Latency::Timer timer(Latency::Op::JsonReadBooks);
+    TraceEvents::Span span("JsonUtils::readBooksFromFile");
     std::vector<Book> books;
     
     // Check if the JSON file exists
@@ -56,9 +93,16 @@ std::vector<Book> readBooksFromFile(const std::string& filename) {
     
     try {
         // Parse the JSON content
-        json j = json::parse(content);
+        LoadJson j;
+        {
+            TraceEvents::Span parsing("json::parse");
+            parsing.arg("bytes", static_cast<long long>(content.size()));
+            j = LoadJson::parse(content);
+        }
         
         // Convert each JSON object to a Book object
+        TraceEvents::Span converting("JSON to Book");
+        converting.arg("books", static_cast<long long>(j.size()));
         for (const auto& bookJson : j) {
             Book book;
             // Set each property of the Book object from the corresponding JSON field
@@ -67,6 +111,8 @@ std::vector<Book> readBooksFromFile(const std::string& filename) {
             book.setAuthor(bookJson["author"]);
             book.setYear(bookJson["year"]);
             book.setAvailable(bookJson["available"]);
+            // Records written before versioning was introduced start at 1
+            book.setVersion(bookJson.value("version", std::uint64_t{1}));
             // Add the Book to our result vector
             books.push_back(book);
         }
@@ -93,26 +139,54 @@ std::vector<Book> readBooksFromFile(const std::string& filename) {
  *         false if the file couldn't be written
  */
 bool writeBooksToFile(const std::string& filename, const std::vector<Book>& books) {
+    Latency::Timer timer(Latency::Op::JsonWriteBooks);
+    TraceEvents::Span span("JsonUtils::writeBooksToFile");
+    span.arg("books", static_cast<long long>(books.size()));
+    
     // Create an empty JSON array
-    json j = json::array();
+    SaveJson j = SaveJson::array();
     
     // Convert each Book object to a JSON object and add it to the array
-    for (const auto& book : books) {
-        // Create a JSON object for the current book
-        json bookJson;
-        // Set JSON fields from Book properties
-        bookJson["id"] = book.getId();
-        bookJson["title"] = book.getTitle();
-        bookJson["author"] = book.getAuthor();
-        bookJson["year"] = book.getYear();
-        bookJson["available"] = book.isAvailable();
-        // Add the book JSON object to the array
-        j.push_back(bookJson);
+    {
+        TraceEvents::Span converting("Book to JSON");
+        for (const auto& book : books) {
+            // Create a JSON object for the current book
+            SaveJson bookJson;
+            // Set JSON fields from Book properties
+            bookJson["id"] = book.getId();
+            bookJson["title"] = book.getTitle();
+            bookJson["author"] = book.getAuthor();
+            bookJson["year"] = book.getYear();
+            bookJson["available"] = book.isAvailable();
+            bookJson["version"] = book.getVersion();
+            // Add the book JSON object to the array
+            j.push_back(bookJson);
+        }
     }
     
     // Write the JSON array to the file with 4-space indentation for readability
     // The dump(4) method creates a pretty-printed JSON string
-    return FileUtils::writeFile(filename, j.dump(4));
+    SaveJson::string_t content;
+    {
+        TraceEvents::Span dumping("json::dump");
+        content = j.dump(4);
+    }
+    SlowLog::mark(SlowLog::Phase::Serialize);
+    bool written = FileUtils::writeFile(filename, content);
+    SlowLog::mark(SlowLog::Phase::Write);
+    if (!written) {
+        return false;
+    }
+    SlowLog::addBytesWritten(content.size());
+    
+    static Metrics::Histogram& saveBytes = Metrics::registry().histogram(
+        "library_save_bytes", "Size of each data file written",
+        {1e3, 4e3, 16e3, 64e3, 256e3, 1e6, 4e6, 16e6, 64e6, 256e6, 1e9});
+    static Metrics::Counter& writtenBytes = Metrics::registry().counter(
+        "library_written_bytes_total", "Bytes of data files written");
+    saveBytes.observe(static_cast<double>(content.size()));
+    writtenBytes.inc(content.size());
+    return true;
 }
 
 /**
@@ -134,6 +208,7 @@ std::string bookToJson(const Book& book) {
     j["author"] = book.getAuthor();
     j["year"] = book.getYear();
     j["available"] = book.isAvailable();
+    j["version"] = book.getVersion();
     
     // Convert the JSON object to a string with 4-space indentation
     return j.dump(4);
@@ -165,6 +240,7 @@ Book jsonToBook(const std::string& jsonStr) {
         book.setAuthor(j["author"]);
         book.setYear(j["year"]);
         book.setAvailable(j["available"]);
+        book.setVersion(j.value("version", std::uint64_t{1}));
     } catch (const std::exception& e) {
         // Log any JSON parsing errors
         std::cerr << "Error parsing JSON: " << e.what() << std::endl;
@@ -0,0 +1,290 @@
+/**
+ * @file Latency.cpp
+ * @brief Implementation of the built-in latency histograms
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements the Latency namespace declared in Latency.hpp: the
+ * bucket mapping, the per-thread counter blocks and their registry, and
+ * the merged view read by reporters.
+ */
+
+ #include "Latency.hpp"
+ #include <algorithm>
+ #include <atomic>
+ #include <bit>
+ #include <iomanip>
+ #include <memory>
+ #include <mutex>
+ #include <vector>
+
+ namespace {
+
+ using Latency::kBuckets;
+ using Latency::kOpCount;
+
+ /**
+  * @struct Block
+  * @brief Counters written by one thread at a time
+  *
+  * Only the owning thread writes, so increments are a relaxed load and
+  * store rather than a read-modify-write; readers may see a count that is
+  * one recording behind, never a torn one.
+  */
+ struct Block {
+     std::atomic<std::uint64_t> counts[kOpCount][kBuckets] = {};
+     std::atomic<std::uint64_t> sums[kOpCount] = {};
+     std::atomic<std::uint64_t> maxima[kOpCount] = {};
+ };
+
+ /**
+  * @class Registry
+  * @brief Owns every block ever handed out
+  */
+ class Registry {
+ public:
+     /**
+      * @brief Gets a block for a new thread, reusing one of an exited thread
+      * @return The block
+      */
+     Block* acquire() {
+         std::lock_guard<std::mutex> lock(mutex);
+         if (!idle.empty()) {
+             Block* block = idle.back();
+             idle.pop_back();
+             return block;
+         }
+         blocks.push_back(std::make_unique<Block>());
+         return blocks.back().get();
+     }
+
+     /**
+      * @brief Makes the block of an exiting thread available again
+      * @param block The block
+      */
+     void release(Block* block) {
+         std::lock_guard<std::mutex> lock(mutex);
+         idle.push_back(block);
+     }
+
+     /**
+      * @brief Calls a function for every block
+      * @param fn Receives each block
+      */
+     template <typename Fn>
+     void forEach(Fn&& fn) {
+         std::lock_guard<std::mutex> lock(mutex);
+         for (const auto& block : blocks) {
+             fn(*block);
+         }
+     }
+
+ private:
+     std::mutex mutex;
+     std::vector<std::unique_ptr<Block>> blocks;
+     std::vector<Block*> idle;
+ };
+
+ /**
+  * @brief Gets the registry
+  *
+  * Deliberately never destroyed: pool threads may still record while
+  * static objects are torn down at exit.
+  *
+  * @return The registry
+  */
+ Registry& registry() {
+     static Registry* instance = new Registry();
+     return *instance;
+ }
+
+ /**
+  * @struct ThreadBlock
+  * @brief The calling thread's block, acquired on first use
+  */
+ struct ThreadBlock {
+     Block* block = nullptr;
+
+     ~ThreadBlock() {
+         if (block) {
+             registry().release(block);
+         }
+     }
+ };
+
+ /**
+  * @brief Formats nanoseconds as microseconds
+  * @param ns Nanoseconds
+  * @return Microseconds
+  */
+ double micros(std::uint64_t ns) {
+     return static_cast<double>(ns) / 1000.0;
+ }
+
+ } // namespace
+
+ namespace Latency {
+
+ /**
+  * @brief Implementation of the opName function
+  * @param op The operation
+  * @return Name of the operation
+  */
+ const char* opName(Op op) {
+     switch (op) {
+         case Op::AddBook: return "addBook";
+         case Op::RemoveBook: return "removeBook";
+         case Op::FindBookById: return "findBookById";
+         case Op::FindBooksByTitle: return "findBooksByTitle";
+         case Op::FindBooksByAuthor: return "findBooksByAuthor";
+         case Op::BorrowBook: return "borrowBook";
+         case Op::ReturnBook: return "returnBook";
+         case Op::UpdateBook: return "updateBook";
+         case Op::BorrowBooks: return "borrowBooks";
+         case Op::ReturnBooks: return "returnBooks";
+         case Op::GetAllBooks: return "getAllBooks";
+         case Op::PageAfter: return "pageAfter";
+         case Op::AddBookAsync: return "addBookAsync";
+         case Op::RemoveBookAsync: return "removeBookAsync";
+         case Op::BorrowBookAsync: return "borrowBookAsync";
+         case Op::ReturnBookAsync: return "returnBookAsync";
+         case Op::UpdateBookAsync: return "updateBookAsync";
+         case Op::Flush: return "flush";
+         case Op::LoadBooks: return "loadBooks";
+         case Op::SaveBooks: return "saveBooks";
+         case Op::JsonReadBooks: return "JsonUtils::readBooksFromFile";
+         case Op::JsonWriteBooks: return "JsonUtils::writeBooksToFile";
+         case Op::FileRead: return "FileUtils::readFile";
+         case Op::FileWrite: return "FileUtils::writeFile";
+         case Op::Count: break;
+     }
+     return "unknown";
+ }
+
+ /**
+  * @brief Implementation of the record function
+  *
+  * @param op The operation
+  * @param ns Latency in nanoseconds
+  */
+ void record(Op op, std::uint64_t ns) {
+     thread_local ThreadBlock local;
+     if (!local.block) {
+         local.block = registry().acquire();
+     }
+     Block& block = *local.block;
+     std::size_t index = static_cast<std::size_t>(op);
+
+     auto& count = block.counts[index][Histogram::bucketOf(ns)];
+     count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+     block.sums[index].store(block.sums[index].load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+     if (ns > block.maxima[index].load(std::memory_order_relaxed)) {
+         block.maxima[index].store(ns, std::memory_order_relaxed);
+     }
+ }
+
+ /**
+  * @brief Implementation of the bucketOf method
+  *
+  * Values below 64 are their own bucket. Above, the bucket is given by the
+  * position of the highest set bit (which power of two) and the five bits
+  * below it (which of the 32 sub-buckets).
+  *
+  * @param ns Nanoseconds
+  * @return Bucket index
+  */
+ std::size_t Histogram::bucketOf(std::uint64_t ns) {
+     if (ns < 64) {
+         return static_cast<std::size_t>(ns);
+     }
+     std::size_t shift = static_cast<std::size_t>(std::bit_width(ns)) - 6;
+     std::size_t bucket = shift * 32 + static_cast<std::size_t>(ns >> shift);
+     return std::min(bucket, kBuckets - 1);
+ }
+
+ /**
+  * @brief Implementation of the bucketUpperBound method
+  * @param bucket Bucket index
+  * @return Largest value in the bucket
+  */
+ std::uint64_t Histogram::bucketUpperBound(std::size_t bucket) {
+     if (bucket < 64) {
+         return bucket;
+     }
+     std::size_t shift = bucket / 32 - 1;
+     std::uint64_t mantissa = bucket % 32 + 32;
+     return ((mantissa + 1) << shift) - 1;
+ }
+
+ /**
+  * @brief Implementation of the percentile method
+  * @param fraction Percentile as a fraction
+  * @return Upper bound of the bucket holding that rank
+  */
+ std::uint64_t Histogram::percentile(double fraction) const {
+     if (total == 0) {
+         return 0;
+     }
+     // Rank of the wanted latency, counting from 1
+     std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(fraction * static_cast<double>(total) + 0.5));
+     std::uint64_t seen = 0;
+     for (std::size_t bucket = 0; bucket < kBuckets; ++bucket) {
+         seen += counts[bucket];
+         if (seen >= rank) {
+             return std::min(bucketUpperBound(bucket), maxNs);
+         }
+     }
+     return maxNs;
+ }
+
+ /**
+  * @brief Implementation of the histogram function
+  * @param op The operation
+  * @return The merged histogram
+  */
+ Histogram histogram(Op op) {
+     Histogram merged;
+     std::size_t index = static_cast<std::size_t>(op);
+     registry().forEach([&merged, index](const Block& block) {
+         for (std::size_t bucket = 0; bucket < kBuckets; ++bucket) {
+             std::uint64_t count = block.counts[index][bucket].load(std::memory_order_relaxed);
+             merged.counts[bucket] += count;
+             merged.total += count;
+         }
+         merged.sumNs += block.sums[index].load(std::memory_order_relaxed);
+         merged.maxNs = std::max(merged.maxNs, block.maxima[index].load(std::memory_order_relaxed));
+     });
+     return merged;
+ }
+
+ /**
+  * @brief Implementation of the printTable function
+  * @param out Destination stream
+  */
+ void printTable(std::ostream& out) {
+     out << std::left << std::setw(30) << "operation" << std::right << std::setw(10) << "count"
+         << std::setw(11) << "p50 us" << std::setw(11) << "p90 us" << std::setw(11) << "p99 us"
+         << std::setw(11) << "p99.9 us" << std::setw(12) << "max us" << "\n";
+     out << std::fixed << std::setprecision(1);
+     bool any = false;
+     for (std::size_t i = 0; i < kOpCount; ++i) {
+         Histogram h = histogram(static_cast<Op>(i));
+         if (h.count() == 0) {
+             continue;
+         }
+         any = true;
+         out << std::left << std::setw(30) << opName(static_cast<Op>(i)) << std::right
+             << std::setw(10) << h.count()
+             << std::setw(11) << micros(h.percentile(0.50))
+             << std::setw(11) << micros(h.percentile(0.90))
+             << std::setw(11) << micros(h.percentile(0.99))
+             << std::setw(11) << micros(h.percentile(0.999))
+             << std::setw(12) << micros(h.max()) << "\n";
+     }
+     if (!any) {
+         out << "(no operations recorded yet)\n";
+     }
+     out << std::defaultfloat;
+ }
+
+ } // namespace Latency
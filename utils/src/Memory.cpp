@@ -0,0 +1,151 @@
+/**
+ * @file Memory.cpp
+ * @brief Implementation of the memory accounting
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements the Memory namespace declared in Memory.hpp: the
+ * shared counters and the report.
+ */
+
+ #include "Memory.hpp"
+ #include <atomic>
+ #include <iomanip>
+ #include <ios>
+
+ namespace {
+
+ using Memory::kSubsystemCount;
+
+ /**
+  * @struct Counters
+  * @brief Counters of one subsystem, on a cache line of their own
+  */
+ struct alignas(64) Counters {
+     std::atomic<std::int64_t> liveBytes{0};
+     std::atomic<std::int64_t> peakBytes{0};
+     std::atomic<std::int64_t> liveBlocks{0};
+     std::atomic<std::uint64_t> allocations{0};
+ };
+
+ /// @brief Counters of every subsystem
+ Counters counters[kSubsystemCount];
+
+ /**
+  * @brief Formats bytes as kibibytes
+  * @param bytes Bytes
+  * @return Kibibytes
+  */
+ double kibibytes(std::int64_t bytes) {
+     return static_cast<double>(bytes) / 1024.0;
+ }
+
+ } // namespace
+
+ namespace Memory {
+
+ /**
+  * @brief Implementation of the subsystemName function
+  * @param subsystem The subsystem
+  * @return Name of the subsystem
+  */
+ const char* subsystemName(Subsystem subsystem) {
+     switch (subsystem) {
+         case Subsystem::Storage: return "storage";
+         case Subsystem::Strings: return "strings";
+         case Subsystem::JsonLoad: return "json load";
+         case Subsystem::JsonSave: return "json save";
+         case Subsystem::Indexes: return "indexes";
+         case Subsystem::Caches: return "caches";
+         case Subsystem::Count: break;
+     }
+     return "unknown";
+ }
+
+ /**
+  * @brief Implementation of the allocated function
+  *
+  * @param subsystem The owner
+  * @param bytes Total size of the blocks
+  * @param blocks Number of blocks
+  */
+ void allocated(Subsystem subsystem, std::size_t bytes, std::size_t blocks) {
+     Counters& c = counters[static_cast<std::size_t>(subsystem)];
+     std::int64_t live = c.liveBytes.fetch_add(static_cast<std::int64_t>(bytes), std::memory_order_relaxed) +
+                         static_cast<std::int64_t>(bytes);
+     c.liveBlocks.fetch_add(static_cast<std::int64_t>(blocks), std::memory_order_relaxed);
+     c.allocations.fetch_add(blocks, std::memory_order_relaxed);
+
+     std::int64_t peak = c.peakBytes.load(std::memory_order_relaxed);
+     while (live > peak && !c.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+ }
+
+ /**
+  * @brief Implementation of the released function
+  *
+  * @param subsystem The owner
+  * @param bytes Total size of the blocks
+  * @param blocks Number of blocks
+  */
+ void released(Subsystem subsystem, std::size_t bytes, std::size_t blocks) {
+     Counters& c = counters[static_cast<std::size_t>(subsystem)];
+     c.liveBytes.fetch_sub(static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+     c.liveBlocks.fetch_sub(static_cast<std::int64_t>(blocks), std::memory_order_relaxed);
+ }
+
+ /**
+  * @brief Implementation of the usage function
+  * @param subsystem The subsystem
+  * @return Its counters
+  */
+ Usage usage(Subsystem subsystem) {
+     const Counters& c = counters[static_cast<std::size_t>(subsystem)];
+     Usage result;
+     result.liveBytes = c.liveBytes.load(std::memory_order_relaxed);
+     result.peakBytes = c.peakBytes.load(std::memory_order_relaxed);
+     result.liveBlocks = c.liveBlocks.load(std::memory_order_relaxed);
+     result.allocations = c.allocations.load(std::memory_order_relaxed);
+     return result;
+ }
+
+ /**
+  * @brief Implementation of the resetPeaks function
+  */
+ void resetPeaks() {
+     for (Counters& c : counters) {
+         c.peakBytes.store(c.liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+     }
+ }
+
+ /**
+  * @brief Implementation of the printReport function
+  *
+  * The formatting of the stream is restored afterwards.
+  *
+  * @param out Destination stream
+  */
+ void printReport(std::ostream& out) {
+     std::ios format(nullptr);
+     format.copyfmt(out);
+     out << std::left << std::setw(12) << "subsystem" << std::right << std::setw(14) << "live KiB"
+         << std::setw(14) << "peak KiB" << std::setw(14) << "live blocks" << std::setw(14) << "allocations" << "\n";
+     out << std::fixed << std::setprecision(1);
+     Usage total;
+     for (std::size_t i = 0; i < kSubsystemCount; ++i) {
+         Usage u = usage(static_cast<Subsystem>(i));
+         total.liveBytes += u.liveBytes;
+         total.peakBytes += u.peakBytes;
+         total.liveBlocks += u.liveBlocks;
+         total.allocations += u.allocations;
+         out << std::left << std::setw(12) << subsystemName(static_cast<Subsystem>(i)) << std::right
+             << std::setw(14) << kibibytes(u.liveBytes) << std::setw(14) << kibibytes(u.peakBytes)
+             << std::setw(14) << u.liveBlocks << std::setw(14) << u.allocations << "\n";
+     }
+     // Peaks of different subsystems need not coincide, so their sum is an upper bound
+     out << std::left << std::setw(12) << "total" << std::right
+         << std::setw(14) << kibibytes(total.liveBytes) << std::setw(14) << kibibytes(total.peakBytes)
+         << std::setw(14) << total.liveBlocks << std::setw(14) << total.allocations << "\n";
+     out.copyfmt(format);
+ }
+
+ } // namespace Memory
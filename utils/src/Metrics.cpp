@@ -0,0 +1,285 @@
+/**
+ * @file Metrics.cpp
+ * @brief Implementation of the metrics registry
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements the Metrics namespace declared in Metrics.hpp:
+ * histogram buckets, registration and the Prometheus text exposition,
+ * including the conversion of the Latency histograms.
+ */
+
+ #include "Metrics.hpp"
+ #include "Latency.hpp"
+ #include "Memory.hpp"
+ #include <algorithm>
+ #include <charconv>
+ #include <cmath>
+
+ namespace {
+
+ /// @brief Bucket bounds of the operation latency histograms, in seconds
+ const double kLatencyBounds[] = {
+     1e-6, 5e-6, 1e-5, 5e-5, 1e-4, 5e-4, 1e-3, 5e-3, 1e-2, 5e-2, 0.1, 0.5, 1, 5, 10
+ };
+
+ /**
+  * @brief Formats a number the way the exposition format expects
+  * @param value The number
+  * @return Shortest exact text, "+Inf", "-Inf" or "NaN"
+  */
+ std::string formatNumber(double value) {
+     if (std::isnan(value)) {
+         return "NaN";
+     }
+     if (std::isinf(value)) {
+         return value > 0 ? "+Inf" : "-Inf";
+     }
+     char text[32];
+     char* end = std::to_chars(text, text + sizeof(text), value).ptr;
+     return std::string(text, end);
+ }
+
+ /**
+  * @brief Writes the HELP and TYPE lines of a metric
+  *
+  * @param out Destination stream
+  * @param name Metric name
+  * @param help Description
+  * @param type counter, gauge or histogram
+  */
+ void writeHeader(std::ostream& out, const std::string& name, const std::string& help, const char* type) {
+     out << "# HELP " << name << ' ' << help << "\n# TYPE " << name << ' ' << type << '\n';
+ }
+
+ /**
+  * @brief Writes the Latency histograms as labelled Prometheus metrics
+  *
+  * Cumulative bucket counts include every HDR bucket whose upper bound is
+  * within the Prometheus bound, so they are exact up to the 3% bucket
+  * width of Latency.hpp.
+  *
+  * @param out Destination stream
+  */
+ void writeLatencies(std::ostream& out) {
+     std::vector<Latency::Histogram> histograms;
+     for (std::size_t i = 0; i < Latency::kOpCount; ++i) {
+         histograms.push_back(Latency::histogram(static_cast<Latency::Op>(i)));
+     }
+
+     writeHeader(out, "library_operations_total", "Library operations and data file accesses by operation", "counter");
+     for (std::size_t i = 0; i < Latency::kOpCount; ++i) {
+         out << "library_operations_total{op=\"" << Latency::opName(static_cast<Latency::Op>(i)) << "\"} "
+             << histograms[i].count() << '\n';
+     }
+
+     writeHeader(out, "library_operation_duration_seconds", "Latency of library operations and data file accesses",
+                 "histogram");
+     for (std::size_t i = 0; i < Latency::kOpCount; ++i) {
+         const Latency::Histogram& histogram = histograms[i];
+         if (histogram.count() == 0) {
+             continue;
+         }
+         std::string label = std::string("op=\"") + Latency::opName(static_cast<Latency::Op>(i)) + "\"";
+         std::size_t bucket = 0;
+         std::uint64_t cumulative = 0;
+         for (double bound : kLatencyBounds) {
+             while (bucket < Latency::kBuckets &&
+                    static_cast<double>(Latency::Histogram::bucketUpperBound(bucket)) <= bound * 1e9) {
+                 cumulative += histogram.bucketCount(bucket++);
+             }
+             out << "library_operation_duration_seconds_bucket{" << label << ",le=\"" << formatNumber(bound)
+                 << "\"} " << cumulative << '\n';
+         }
+         out << "library_operation_duration_seconds_bucket{" << label << ",le=\"+Inf\"} " << histogram.count() << '\n'
+             << "library_operation_duration_seconds_sum{" << label << "} "
+             << formatNumber(static_cast<double>(histogram.sum()) / 1e9) << '\n'
+             << "library_operation_duration_seconds_count{" << label << "} " << histogram.count() << '\n';
+     }
+ }
+
+ /**
+  * @brief Writes the memory accounting as labelled Prometheus metrics
+  * @param out Destination stream
+  */
+ void writeMemory(std::ostream& out) {
+     writeHeader(out, "library_memory_bytes", "Heap bytes held, by subsystem", "gauge");
+     for (std::size_t i = 0; i < Memory::kSubsystemCount; ++i) {
+         Memory::Subsystem subsystem = static_cast<Memory::Subsystem>(i);
+         out << "library_memory_bytes{subsystem=\"" << Memory::subsystemName(subsystem) << "\"} "
+             << Memory::usage(subsystem).liveBytes << '\n';
+     }
+     writeHeader(out, "library_memory_allocations_total", "Heap allocations made, by subsystem", "counter");
+     for (std::size_t i = 0; i < Memory::kSubsystemCount; ++i) {
+         Memory::Subsystem subsystem = static_cast<Memory::Subsystem>(i);
+         out << "library_memory_allocations_total{subsystem=\"" << Memory::subsystemName(subsystem) << "\"} "
+             << Memory::usage(subsystem).allocations << '\n';
+     }
+ }
+
+ } // namespace
+
+ namespace Metrics {
+
+ /**
+  * @brief Constructor implementation
+  * @param bounds Upper bounds of the buckets
+  */
+ Histogram::Histogram(std::vector<double> bounds)
+     : bounds(std::move(bounds)), counts(new std::atomic<std::uint64_t>[this->bounds.size() + 1]) {
+     std::sort(this->bounds.begin(), this->bounds.end());
+     for (std::size_t i = 0; i <= this->bounds.size(); ++i) {
+         counts[i].store(0, std::memory_order_relaxed);
+     }
+ }
+
+ /**
+  * @brief Implementation of the observe method
+  * @param value The value
+  */
+ void Histogram::observe(double value) {
+     std::size_t bucket = static_cast<std::size_t>(
+         std::lower_bound(bounds.begin(), bounds.end(), value) - bounds.begin());
+     counts[bucket].fetch_add(1, std::memory_order_relaxed);
+     sum.fetch_add(value, std::memory_order_relaxed);
+ }
+
+ /**
+  * @brief Implementation of the write method
+  *
+  * @param out Destination stream
+  * @param name Metric name
+  */
+ void Histogram::write(std::ostream& out, const std::string& name) const {
+     std::uint64_t cumulative = 0;
+     for (std::size_t i = 0; i < bounds.size(); ++i) {
+         cumulative += counts[i].load(std::memory_order_relaxed);
+         out << name << "_bucket{le=\"" << formatNumber(bounds[i]) << "\"} " << cumulative << '\n';
+     }
+     cumulative += counts[bounds.size()].load(std::memory_order_relaxed);
+     out << name << "_bucket{le=\"+Inf\"} " << cumulative << '\n'
+         << name << "_sum " << formatNumber(sum.load(std::memory_order_relaxed)) << '\n'
+         << name << "_count " << cumulative << '\n';
+ }
+
+ /**
+  * @brief Finds a registered metric; the caller holds the mutex
+  * @param name Metric name
+  * @return The entry, or nullptr
+  */
+ Registry::Entry* Registry::find(const std::string& name) {
+     for (Entry& entry : entries) {
+         if (entry.name == name) {
+             return &entry;
+         }
+     }
+     return nullptr;
+ }
+
+ /**
+  * @brief Implementation of the counter method
+  *
+  * @param name Metric name
+  * @param help Description
+  * @return The counter
+  */
+ Counter& Registry::counter(const std::string& name, const std::string& help) {
+     std::lock_guard<std::mutex> lock(mutex);
+     if (Entry* entry = find(name); entry && entry->counter) {
+         return *entry->counter;
+     }
+     entries.push_back(Entry{name, help, std::make_unique<Counter>(), nullptr, nullptr, {}});
+     return *entries.back().counter;
+ }
+
+ /**
+  * @brief Implementation of the gauge method
+  *
+  * @param name Metric name
+  * @param help Description
+  * @return The gauge
+  */
+ Gauge& Registry::gauge(const std::string& name, const std::string& help) {
+     std::lock_guard<std::mutex> lock(mutex);
+     if (Entry* entry = find(name); entry && entry->gauge) {
+         return *entry->gauge;
+     }
+     entries.push_back(Entry{name, help, nullptr, std::make_unique<Gauge>(), nullptr, {}});
+     return *entries.back().gauge;
+ }
+
+ /**
+  * @brief Implementation of the histogram method
+  *
+  * @param name Metric name
+  * @param help Description
+  * @param bounds Upper bounds of the buckets
+  * @return The histogram
+  */
+ Histogram& Registry::histogram(const std::string& name, const std::string& help, std::vector<double> bounds) {
+     std::lock_guard<std::mutex> lock(mutex);
+     if (Entry* entry = find(name); entry && entry->histogram) {
+         return *entry->histogram;
+     }
+     entries.push_back(Entry{name, help, nullptr, nullptr, std::make_unique<Histogram>(std::move(bounds)), {}});
+     return *entries.back().histogram;
+ }
+
+ /**
+  * @brief Implementation of the gaugeFunction method
+  *
+  * @param name Metric name
+  * @param help Description
+  * @param read Computes the value
+  */
+ void Registry::gaugeFunction(const std::string& name, const std::string& help, std::function<double()> read) {
+     std::lock_guard<std::mutex> lock(mutex);
+     if (Entry* entry = find(name); entry && entry->read) {
+         entry->help = help;
+         entry->read = std::move(read);
+         return;
+     }
+     entries.push_back(Entry{name, help, nullptr, nullptr, nullptr, std::move(read)});
+ }
+
+ /**
+  * @brief Implementation of the writeText method
+  * @param out Destination stream
+  */
+ void Registry::writeText(std::ostream& out) {
+     {
+         std::lock_guard<std::mutex> lock(mutex);
+         for (const Entry& entry : entries) {
+             if (entry.counter) {
+                 writeHeader(out, entry.name, entry.help, "counter");
+                 out << entry.name << ' ' << entry.counter->value() << '\n';
+             } else if (entry.gauge) {
+                 writeHeader(out, entry.name, entry.help, "gauge");
+                 out << entry.name << ' ' << formatNumber(entry.gauge->value()) << '\n';
+             } else if (entry.histogram) {
+                 writeHeader(out, entry.name, entry.help, "histogram");
+                 entry.histogram->write(out, entry.name);
+             } else if (entry.read) {
+                 writeHeader(out, entry.name, entry.help, "gauge");
+                 out << entry.name << ' ' << formatNumber(entry.read()) << '\n';
+             }
+         }
+     }
+     writeLatencies(out);
+     writeMemory(out);
+ }
+
+ /**
+  * @brief Implementation of the registry function
+  *
+  * Deliberately never destroyed, like the Latency blocks: metrics may be
+  * updated while static objects are torn down at exit.
+  *
+  * @return The registry
+  */
+ Registry& registry() {
+     static Registry* instance = new Registry();
+     return *instance;
+ }
+
+ } // namespace Metrics
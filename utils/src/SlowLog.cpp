@@ -0,0 +1,255 @@
+/**
+ * @file SlowLog.cpp
+ * @brief Implementation of the slow-operation log
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements the SlowLog namespace declared in SlowLog.hpp: the
+ * log file and its rotation, and the formatting of a slow operation.
+ */
+
+ #include "SlowLog.hpp"
+ #include "Metrics.hpp"
+ #include <algorithm>
+ #include <cstdio>
+ #include <cstdlib>
+ #include <ctime>
+ #include <filesystem>
+ #include <fstream>
+ #include <iostream>
+ #include <mutex>
+
+ namespace fs = std::filesystem;
+
+ namespace {
+
+ /// @brief Guards everything below
+ std::mutex mutex;
+
+ /// @brief The log file
+ std::ofstream file;
+
+ /// @brief Path of the log file
+ std::string logPath;
+
+ /// @brief Bytes in the current log file
+ std::uint64_t fileBytes = 0;
+
+ /// @brief Size at which the file is rotated
+ std::uint64_t rotateBytes = 0;
+
+ /// @brief Rotated files kept
+ int keepFiles = 0;
+
+ /// @brief Source of thread numbers
+ std::atomic<int> nextThread{1};
+
+ /**
+  * @brief Gets the number of the calling thread, assigned on first use
+  * @return Thread number
+  */
+ int threadNumber() {
+     thread_local int number = nextThread.fetch_add(1);
+     return number;
+ }
+
+ /**
+  * @brief Formats nanoseconds as milliseconds with microsecond precision
+  * @param ns Nanoseconds
+  * @return e.g. "1203.551"
+  */
+ std::string millis(std::uint64_t ns) {
+     char text[32];
+     std::snprintf(text, sizeof(text), "%.3f", static_cast<double>(ns) / 1e6);
+     return text;
+ }
+
+ /**
+  * @brief Moves the full log to <path>.1 and starts a new one; the caller holds the mutex
+  */
+ void rotate() {
+     file.close();
+     std::error_code error;
+     fs::remove(logPath + "." + std::to_string(keepFiles), error);
+     for (int i = keepFiles - 1; i >= 1; --i) {
+         fs::rename(logPath + "." + std::to_string(i), logPath + "." + std::to_string(i + 1), error);
+     }
+     if (keepFiles > 0) {
+         fs::rename(logPath, logPath + ".1", error);
+     } else {
+         fs::remove(logPath, error);
+     }
+     file.open(logPath, std::ios::binary | std::ios::app);
+     fileBytes = 0;
+     if (!file) {
+         std::cerr << "Error reopening slow-operation log " << logPath << std::endl;
+     }
+ }
+
+ } // namespace
+
+ namespace SlowLog {
+
+ std::atomic<std::uint64_t> thresholdNs{0};
+
+ thread_local State* current = nullptr;
+
+ /**
+  * @brief Implementation of the phaseName function
+  * @param phase The phase
+  * @return Name of the phase
+  */
+ const char* phaseName(Phase phase) {
+     switch (phase) {
+         case Phase::Wait: return "wait";
+         case Phase::Lookup: return "lookup";
+         case Phase::Mutate: return "mutate";
+         case Phase::Serialize: return "serialize";
+         case Phase::Write: return "write";
+         case Phase::Count: break;
+     }
+     return "unknown";
+ }
+
+ /**
+  * @brief Implementation of the numeric arg method
+  *
+  * @param key Argument name
+  * @param value Argument value
+  */
+ void Entry::arg(const char* key, long long value) {
+     args += ' ';
+     args += key;
+     args += '=';
+     args += std::to_string(value);
+ }
+
+ /**
+  * @brief Implementation of the text arg method
+  *
+  * Quotes, backslashes and control characters are escaped, so every
+  * entry stays on one line.
+  *
+  * @param key Argument name
+  * @param value Argument value
+  */
+ void Entry::arg(const char* key, std::string_view value) {
+     args += ' ';
+     args += key;
+     args += "=\"";
+     for (char c : value) {
+         if (c == '"' || c == '\\') {
+             args += '\\';
+             args += c;
+         } else if (static_cast<unsigned char>(c) < 0x20) {
+             char escaped[8];
+             std::snprintf(escaped, sizeof(escaped), "\\x%02x", static_cast<unsigned char>(c));
+             args += escaped;
+         } else {
+             args += c;
+         }
+     }
+     args += '"';
+ }
+
+ /**
+  * @brief Implementation of the start function
+  *
+  * stop() is registered to run at exit.
+  *
+  * @param path Log file, appended to
+  * @param thresholdMs Operations taking at least this long are logged
+  * @param maxBytes Size at which the file is rotated
+  * @param keep Rotated files kept
+  * @return false if the file cannot be opened
+  */
+ bool start(const std::string& path, double thresholdMs, std::uint64_t maxBytes, int keep) {
+     std::lock_guard<std::mutex> lock(mutex);
+     if (file.is_open()) {
+         file.close();
+     }
+     file.open(path, std::ios::binary | std::ios::app);
+     if (!file) {
+         std::cerr << "Error opening slow-operation log " << path << std::endl;
+         return false;
+     }
+     std::error_code error;
+     std::uintmax_t size = fs::file_size(path, error);
+     logPath = path;
+     fileBytes = error ? 0 : static_cast<std::uint64_t>(size);
+     rotateBytes = maxBytes;
+     keepFiles = keep;
+     // At least 1 ns, since 0 means off
+     thresholdNs = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(thresholdMs * 1e6));
+
+     static bool registered = false;
+     if (!registered) {
+         registered = true;
+         std::atexit(stop);
+     }
+     return true;
+ }
+
+ /**
+  * @brief Implementation of the stop function
+  */
+ void stop() {
+     std::lock_guard<std::mutex> lock(mutex);
+     thresholdNs = 0;
+     file.close();
+ }
+
+ /**
+  * @brief Implementation of the write function
+  *
+  * The line is formatted before the mutex is taken. Phases add up to the
+  * total together with "other", the time outside any marked phase.
+  *
+  * @param state Its timing
+  * @param entry Its context
+  */
+ void write(const State& state, const Entry& entry) {
+     static Metrics::Counter& slowOperations = Metrics::registry().counter(
+         "library_slow_operations_total", "Library operations logged as slow");
+     slowOperations.inc();
+
+     std::timespec wall;
+     std::timespec_get(&wall, TIME_UTC);
+     std::tm utc;
+     gmtime_r(&wall.tv_sec, &utc);
+     char timestamp[48];
+     std::size_t length = std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%S", &utc);
+     std::snprintf(timestamp + length, sizeof(timestamp) - length, ".%03ldZ", wall.tv_nsec / 1000000);
+
+     std::string line = "time=";
+     line += timestamp;
+     line += " op=";
+     line += Latency::opName(state.op);
+     line += " total_ms=" + millis(state.totalNs);
+     line += entry.args;
+     line += " books=" + std::to_string(entry.bookCount);
+     line += " bytes_written=" + std::to_string(state.bytesWritten);
+     std::uint64_t marked = 0;
+     for (std::size_t i = 0; i < kPhaseCount; ++i) {
+         line += ' ';
+         line += phaseName(static_cast<Phase>(i));
+         line += "_ms=" + millis(state.phaseNs[i]);
+         marked += state.phaseNs[i];
+     }
+     line += " other_ms=" + millis(state.totalNs > marked ? state.totalNs - marked : 0);
+     line += " thread=" + std::to_string(threadNumber());
+     line += '\n';
+
+     std::lock_guard<std::mutex> lock(mutex);
+     if (!file.is_open()) {
+         return;
+     }
+     file << line;
+     file.flush();
+     fileBytes += line.size();
+     if (fileBytes >= rotateBytes) {
+         rotate();
+     }
+ }
+
+ } // namespace SlowLog
@@ -0,0 +1,354 @@
+/**
+ * @file ThreadPool.cpp
+ * @brief Implementation of the work-stealing thread pool
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements the ThreadPool and TaskGroup classes declared in
+ * ThreadPool.hpp. Each deque is protected by its own small mutex; owners
+ * work at the back and thieves at the front, so the two rarely collide.
+ */
+
+ #include "ThreadPool.hpp"
+ #include <chrono>
+ #include <iostream>
+
+ #ifdef __linux__
+ #include <pthread.h>
+ #include <sched.h>
+ #endif
+
+ namespace {
+
+ /// @brief Pool that owns the calling thread, if it is a worker
+ thread_local ThreadPool* currentPool = nullptr;
+
+ /// @brief Index of the calling worker inside currentPool
+ thread_local std::size_t currentIndex = 0;
+
+ /// @brief Settings for the shared pool, read when it is first created
+ std::atomic<std::size_t> sharedThreads{0};
+ std::atomic<bool> sharedPinning{false};
+
+ } // namespace
+
+ /**
+  * @brief Constructor implementation
+  *
+  * Creates all deques before starting any thread, so a worker that starts
+  * stealing immediately never sees a half-built pool.
+  *
+  * @param threads Number of workers; 0 selects the hardware concurrency
+  * @param pinThreads If true, worker i is pinned to CPU i (Linux only)
+  */
+ ThreadPool::ThreadPool(std::size_t threads, bool pinThreads) {
+     if (threads == 0) {
+         threads = std::max(1u, std::thread::hardware_concurrency());
+     }
+
+     for (std::size_t i = 0; i < threads; ++i) {
+         workers.push_back(std::make_unique<Worker>());
+     }
+     for (std::size_t i = 0; i < threads; ++i) {
+         workers[i]->thread = std::thread(&ThreadPool::workerLoop, this, i, pinThreads);
+     }
+ }
+
+ /**
+  * @brief Destructor implementation
+  *
+  * Workers keep running until every queued task has been executed.
+  */
+ ThreadPool::~ThreadPool() {
+     {
+         std::lock_guard<std::mutex> lock(sleepMutex);
+         stopping = true;
+     }
+     wake.notify_all();
+
+     for (auto& worker : workers) {
+         worker->thread.join();
+     }
+ }
+
+ /**
+  * @brief Implementation of the shared method
+  * @return Reference to the shared pool
+  */
+ ThreadPool& ThreadPool::shared() {
+     static ThreadPool pool(sharedThreads.load(), sharedPinning.load());
+     return pool;
+ }
+
+ /**
+  * @brief Implementation of the io method
+  * @return Reference to the I/O pool
+  */
+ ThreadPool& ThreadPool::io() {
+     static ThreadPool pool(1);
+     return pool;
+ }
+
+ /**
+  * @brief Implementation of the configureShared method
+  *
+  * @param threads Number of workers; 0 selects the hardware concurrency
+  * @param pinThreads Whether to pin workers to CPUs
+  */
+ void ThreadPool::configureShared(std::size_t threads, bool pinThreads) {
+     sharedThreads = threads;
+     sharedPinning = pinThreads;
+ }
+
+ /**
+  * @brief Implementation of the submit method
+  *
+  * Workers push onto their own deque; other threads pick one round-robin.
+  * The sleep mutex is taken before notifying so a worker that is about to
+  * sleep cannot miss the new task.
+  *
+  * @param task The work to run
+  */
+ void ThreadPool::submit(Task task) {
+     std::size_t index = currentPool == this
+         ? currentIndex
+         : nextQueue.fetch_add(1, std::memory_order_relaxed) % workers.size();
+
+     {
+         std::lock_guard<std::mutex> lock(workers[index]->mutex);
+         workers[index]->tasks.push_back(std::move(task));
+     }
+     queued.fetch_add(1);
+     submitted.fetch_add(1, std::memory_order_relaxed);
+
+     {
+         std::lock_guard<std::mutex> lock(sleepMutex);
+     }
+     wake.notify_one();
+ }
+
+ /**
+  * @brief Implementation of the popLocal method
+  *
+  * @param index Worker whose deque to pop
+  * @param task Receives the task
+  * @return true if a task was taken
+  */
+ bool ThreadPool::popLocal(std::size_t index, Task& task) {
+     std::lock_guard<std::mutex> lock(workers[index]->mutex);
+     if (workers[index]->tasks.empty()) {
+         return false;
+     }
+     task = std::move(workers[index]->tasks.back());
+     workers[index]->tasks.pop_back();
+     return true;
+ }
+
+ /**
+  * @brief Implementation of the steal method
+  *
+  * Visits the other deques starting after the thief and takes the oldest
+  * task of the first non-empty one.
+  *
+  * @param thief Index of the stealing worker, or size() for outside threads
+  * @param task Receives the task
+  * @return true if a task was stolen
+  */
+ bool ThreadPool::steal(std::size_t thief, Task& task) {
+     for (std::size_t offset = 1; offset <= workers.size(); ++offset) {
+         std::size_t victim = (thief + offset) % workers.size();
+         if (victim == thief) {
+             continue;
+         }
+
+         std::lock_guard<std::mutex> lock(workers[victim]->mutex);
+         if (!workers[victim]->tasks.empty()) {
+             task = std::move(workers[victim]->tasks.front());
+             workers[victim]->tasks.pop_front();
+             steals.fetch_add(1, std::memory_order_relaxed);
+             return true;
+         }
+     }
+     return false;
+ }
+
+ /**
+  * @brief Implementation of the execute method
+  *
+  * @param task The task to run
+  */
+ void ThreadPool::execute(Task& task) {
+     queued.fetch_sub(1);
+     busy.fetch_add(1, std::memory_order_relaxed);
+     try {
+         task();
+     } catch (const std::exception& e) {
+         std::cerr << "Unhandled exception in pool task: " << e.what() << std::endl;
+     } catch (...) {
+         std::cerr << "Unhandled exception in pool task" << std::endl;
+     }
+     busy.fetch_sub(1, std::memory_order_relaxed);
+     executed.fetch_add(1, std::memory_order_relaxed);
+ }
+
+ /**
+  * @brief Implementation of the runPendingTask method
+  *
+  * @return true if a task was run, false if every deque was empty
+  */
+ bool ThreadPool::runPendingTask() {
+     Task task;
+     bool found = currentPool == this
+         ? popLocal(currentIndex, task) || steal(currentIndex, task)
+         : steal(workers.size(), task);
+
+     if (found) {
+         execute(task);
+     }
+     return found;
+ }
+
+ /**
+  * @brief Implementation of the isWorker method
+  * @return true on a worker of this pool
+  */
+ bool ThreadPool::isWorker() const {
+     return currentPool == this;
+ }
+
+ /**
+  * @brief Implementation of the workerLoop method
+  *
+  * @param index Index of this worker
+  * @param pin Whether to pin this thread to CPU index
+  */
+ void ThreadPool::workerLoop(std::size_t index, bool pin) {
+     currentPool = this;
+     currentIndex = index;
+
+ #ifdef __linux__
+     if (pin) {
+         cpu_set_t cpus;
+         CPU_ZERO(&cpus);
+         CPU_SET(index % std::max(1u, std::thread::hardware_concurrency()), &cpus);
+         pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+     }
+ #else
+     (void)pin;
+ #endif
+
+     for (;;) {
+         Task task;
+         if (popLocal(index, task) || steal(index, task)) {
+             execute(task);
+             continue;
+         }
+
+         std::unique_lock<std::mutex> lock(sleepMutex);
+         wake.wait(lock, [this] { return stopping || queued.load() > 0; });
+         if (stopping && queued.load() == 0) {
+             return;
+         }
+     }
+ }
+
+ /**
+  * @brief Implementation of the size method
+  * @return Worker count
+  */
+ std::size_t ThreadPool::size() const {
+     return workers.size();
+ }
+
+ /**
+  * @brief Implementation of the stats method
+  * @return Snapshot of the pool statistics
+  */
+ ThreadPool::Stats ThreadPool::stats() const {
+     Stats result;
+     result.workers = workers.size();
+     result.busyWorkers = busy.load(std::memory_order_relaxed);
+     result.queuedTasks = queued.load(std::memory_order_relaxed);
+     result.submitted = submitted.load(std::memory_order_relaxed);
+     result.executed = executed.load(std::memory_order_relaxed);
+     result.steals = steals.load(std::memory_order_relaxed);
+     return result;
+ }
+
+ /**
+  * @brief TaskGroup constructor implementation
+  * @param pool The pool that runs the tasks
+  */
+ TaskGroup::TaskGroup(ThreadPool& pool) : pool(pool) {}
+
+ /**
+  * @brief TaskGroup destructor implementation
+  */
+ TaskGroup::~TaskGroup() {
+     try {
+         wait();
+     } catch (...) {
+         // Errors must be collected by calling wait() explicitly
+     }
+ }
+
+ /**
+  * @brief Implementation of the TaskGroup::run method
+  *
+  * The completion count is decremented under the group mutex, so wait()
+  * cannot return (and the group be destroyed) while a task still touches it.
+  *
+  * @param task The work to run
+  */
+ void TaskGroup::run(ThreadPool::Task task) {
+     {
+         std::lock_guard<std::mutex> lock(mutex);
+         ++pending;
+     }
+
+     pool.submit([this, task = std::move(task)] {
+         std::exception_ptr failure;
+         try {
+             task();
+         } catch (...) {
+             failure = std::current_exception();
+         }
+
+         std::lock_guard<std::mutex> lock(mutex);
+         if (failure && !error) {
+             error = failure;
+         }
+         if (--pending == 0) {
+             done.notify_all();
+         }
+     });
+ }
+
+ /**
+  * @brief Implementation of the TaskGroup::wait method
+  *
+  * Helps the pool while tasks are outstanding and only sleeps (briefly)
+  * when there is nothing left to run.
+  */
+ void TaskGroup::wait() {
+     for (;;) {
+         {
+             std::unique_lock<std::mutex> lock(mutex);
+             if (pending == 0) {
+                 break;
+             }
+         }
+
+         if (!pool.runPendingTask()) {
+             std::unique_lock<std::mutex> lock(mutex);
+             done.wait_for(lock, std::chrono::milliseconds(1), [this] { return pending == 0; });
+         }
+     }
+
+     std::lock_guard<std::mutex> lock(mutex);
+     if (error) {
+         std::exception_ptr failure = error;
+         error = nullptr;
+         std::rethrow_exception(failure);
+     }
+ }
@@ -0,0 +1,389 @@
+/**
+ * @file Trace.cpp
+ * @brief Implementation of the workload trace format
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements the Trace namespace declared in Trace.hpp: varint
+ * encoding, the buffered recorder and the reader.
+ */
+
+ #include "Trace.hpp"
+ #include <atomic>
+ #include <cstring>
+ #include <iostream>
+ #include <iterator>
+
+ namespace {
+
+ /// @brief First bytes of every trace file
+ constexpr char kMagic[8] = {'L', 'B', 'T', 'R', 'A', 'C', 'E', '1'};
+
+ /// @brief Buffered bytes at which the buffer is written to the file
+ constexpr std::size_t kChunkSize = 64 * 1024;
+
+ /// @brief Source of thread numbers
+ std::atomic<std::uint32_t> nextThread{0};
+
+ /**
+  * @brief Gets the number of the calling thread, assigned on first use
+  * @return Small number identifying the thread
+  */
+ std::uint32_t threadNumber() {
+     thread_local std::uint32_t number = nextThread.fetch_add(1);
+     return number;
+ }
+
+ /**
+  * @class Decoder
+  * @brief Reads varints and strings from a byte range
+  */
+ class Decoder {
+ public:
+     Decoder(const char* begin, const char* end) : position(begin), end(end) {}
+
+     bool atEnd() const { return position == end; }
+
+     bool byte(std::uint8_t& value) {
+         if (position == end) {
+             return false;
+         }
+         value = static_cast<std::uint8_t>(*position++);
+         return true;
+     }
+
+     bool varint(std::uint64_t& value) {
+         value = 0;
+         for (int shift = 0; shift < 64; shift += 7) {
+             std::uint8_t next;
+             if (!byte(next)) {
+                 return false;
+             }
+             value |= static_cast<std::uint64_t>(next & 0x7F) << shift;
+             if ((next & 0x80) == 0) {
+                 return true;
+             }
+         }
+         return false;
+     }
+
+     bool number(int& value) {
+         std::uint64_t raw;
+         if (!varint(raw)) {
+             return false;
+         }
+         value = static_cast<int>(static_cast<std::int64_t>(raw >> 1) ^ -static_cast<std::int64_t>(raw & 1));
+         return true;
+     }
+
+     bool text(std::string& value) {
+         std::uint64_t length;
+         if (!varint(length) || length > static_cast<std::uint64_t>(end - position)) {
+             return false;
+         }
+         value.assign(position, static_cast<std::size_t>(length));
+         position += length;
+         return true;
+     }
+
+ private:
+     const char* position;
+     const char* end;
+ };
+
+ /**
+  * @brief Decodes the arguments of one record
+  *
+  * @param decoder Positioned after the record's time delta
+  * @param call Receives the arguments; call.op must be set
+  * @return false if the record is truncated or the operation unknown
+  */
+ bool decodeArguments(Decoder& decoder, Trace::Call& call) {
+     using Trace::Op;
+     switch (call.op) {
+         case Op::Add:
+             return decoder.text(call.title) && decoder.text(call.author) && decoder.number(call.year);
+         case Op::Remove:
+         case Op::FindById:
+         case Op::Borrow:
+         case Op::Return:
+             return decoder.number(call.id);
+         case Op::FindByTitle:
+             return decoder.text(call.title);
+         case Op::FindByAuthor:
+             return decoder.text(call.author);
+         case Op::Update:
+             return decoder.number(call.id) && decoder.varint(call.version) && decoder.text(call.title) &&
+                    decoder.text(call.author) && decoder.number(call.year);
+         case Op::BorrowMany:
+         case Op::ReturnMany: {
+             std::uint64_t count;
+             if (!decoder.varint(count)) {
+                 return false;
+             }
+             for (std::uint64_t i = 0; i < count; ++i) {
+                 int id;
+                 if (!decoder.number(id)) {
+                     return false;
+                 }
+                 call.ids.push_back(id);
+             }
+             return true;
+         }
+     }
+     return false;
+ }
+
+ } // namespace
+
+ namespace Trace {
+
+ /**
+  * @brief Implementation of the opName function
+  * @param op The operation
+  * @return Name of the Library method
+  */
+ const char* opName(Op op) {
+     switch (op) {
+         case Op::Add: return "addBook";
+         case Op::Remove: return "removeBook";
+         case Op::FindById: return "findBookById";
+         case Op::FindByTitle: return "findBooksByTitle";
+         case Op::FindByAuthor: return "findBooksByAuthor";
+         case Op::Borrow: return "borrowBook";
+         case Op::Return: return "returnBook";
+         case Op::Update: return "updateBook";
+         case Op::BorrowMany: return "borrowBooks";
+         case Op::ReturnMany: return "returnBooks";
+     }
+     return "unknown";
+ }
+
+ /**
+  * @brief Constructor implementation
+  * @param path Trace file to write
+  */
+ Recorder::Recorder(const std::string& path)
+     : file(path, std::ios::binary | std::ios::trunc), start(std::chrono::steady_clock::now()),
+       lastNs(0), failed(!file) {
+     if (failed) {
+         std::cerr << "Error creating trace file " << path << std::endl;
+         return;
+     }
+     buffer.reserve(kChunkSize + 1024);
+     buffer.append(kMagic, sizeof(kMagic));
+ }
+
+ /**
+  * @brief Destructor implementation
+  */
+ Recorder::~Recorder() {
+     flush();
+ }
+
+ /**
+  * @brief Implementation of the valid method
+  * @return true if records are being written
+  */
+ bool Recorder::valid() const {
+     return !failed;
+ }
+
+ /**
+  * @brief Implementation of the record method for calls taking an ID
+  *
+  * @param op The operation
+  * @param id The book ID
+  */
+ void Recorder::record(Op op, int id) {
+     std::lock_guard<std::mutex> lock(mutex);
+     beginRecord(op);
+     appendSigned(id);
+     endRecord();
+ }
+
+ /**
+  * @brief Implementation of the record method for searches
+  *
+  * @param op The operation
+  * @param text The searched text
+  */
+ void Recorder::record(Op op, const std::string& text) {
+     std::lock_guard<std::mutex> lock(mutex);
+     beginRecord(op);
+     appendString(text);
+     endRecord();
+ }
+
+ /**
+  * @brief Implementation of the record method for calls taking several IDs
+  *
+  * @param op The operation
+  * @param ids The book IDs
+  */
+ void Recorder::record(Op op, std::span<const int> ids) {
+     std::lock_guard<std::mutex> lock(mutex);
+     beginRecord(op);
+     appendVarint(ids.size());
+     for (int id : ids) {
+         appendSigned(id);
+     }
+     endRecord();
+ }
+
+ /**
+  * @brief Implementation of the recordAdd method
+  *
+  * @param title Title of the book
+  * @param author Author of the book
+  * @param year Publication year
+  */
+ void Recorder::recordAdd(const std::string& title, const std::string& author, int year) {
+     std::lock_guard<std::mutex> lock(mutex);
+     beginRecord(Op::Add);
+     appendString(title);
+     appendString(author);
+     appendSigned(year);
+     endRecord();
+ }
+
+ /**
+  * @brief Implementation of the recordUpdate method
+  *
+  * @param id The book ID
+  * @param version Expected version
+  * @param title New title
+  * @param author New author
+  * @param year New publication year
+  */
+ void Recorder::recordUpdate(int id, std::uint64_t version, const std::string& title,
+                             const std::string& author, int year) {
+     std::lock_guard<std::mutex> lock(mutex);
+     beginRecord(Op::Update);
+     appendSigned(id);
+     appendVarint(version);
+     appendString(title);
+     appendString(author);
+     appendSigned(year);
+     endRecord();
+ }
+
+ /**
+  * @brief Implementation of the flush method
+  * @return true if everything so far has been written
+  */
+ bool Recorder::flush() {
+     std::lock_guard<std::mutex> lock(mutex);
+     if (!failed && !buffer.empty()) {
+         file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+         file.flush();
+         buffer.clear();
+         failed = !file;
+     }
+     return !failed;
+ }
+
+ /**
+  * @brief Starts a record: operation, thread and time delta
+  *
+  * The time is taken under the mutex, so deltas are never negative.
+  *
+  * @param op The operation
+  */
+ void Recorder::beginRecord(Op op) {
+     auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+     std::uint64_t nowNs = static_cast<std::uint64_t>(now.count());
+     buffer += static_cast<char>(op);
+     appendVarint(threadNumber());
+     appendVarint(nowNs - lastNs);
+     lastNs = nowNs;
+ }
+
+ /**
+  * @brief Ends a record, writing the buffer once a chunk is full
+  */
+ void Recorder::endRecord() {
+     if (buffer.size() < kChunkSize) {
+         return;
+     }
+     if (!failed) {
+         file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+         failed = !file;
+     }
+     buffer.clear();
+ }
+
+ /**
+  * @brief Appends an unsigned LEB128 varint
+  * @param value The value
+  */
+ void Recorder::appendVarint(std::uint64_t value) {
+     while (value >= 0x80) {
+         buffer += static_cast<char>((value & 0x7F) | 0x80);
+         value >>= 7;
+     }
+     buffer += static_cast<char>(value);
+ }
+
+ /**
+  * @brief Appends a zigzag-encoded signed varint
+  * @param value The value
+  */
+ void Recorder::appendSigned(std::int64_t value) {
+     appendVarint((static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+ }
+
+ /**
+  * @brief Appends a length-prefixed string
+  * @param text The string
+  */
+ void Recorder::appendString(const std::string& text) {
+     appendVarint(text.size());
+     buffer.append(text);
+ }
+
+ /**
+  * @brief Implementation of the readFile function
+  *
+  * @param path Trace file to read
+  * @param calls Receives the calls in recorded order
+  * @return false if the file cannot be read or is not a complete trace
+  */
+ bool readFile(const std::string& path, std::vector<Call>& calls) {
+     calls.clear();
+     std::ifstream file(path, std::ios::binary);
+     if (!file) {
+         std::cerr << "Cannot open trace file " << path << std::endl;
+         return false;
+     }
+     std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+     if (content.size() < sizeof(kMagic) || std::memcmp(content.data(), kMagic, sizeof(kMagic)) != 0) {
+         std::cerr << path << " is not a trace file" << std::endl;
+         return false;
+     }
+
+     Decoder decoder(content.data() + sizeof(kMagic), content.data() + content.size());
+     std::uint64_t timeNs = 0;
+     while (!decoder.atEnd()) {
+         Call call;
+         std::uint8_t op;
+         std::uint64_t thread;
+         std::uint64_t delta;
+         bool complete = decoder.byte(op) && op >= 1 && op <= kOpCount && decoder.varint(thread) &&
+                         decoder.varint(delta);
+         if (complete) {
+             call.op = static_cast<Op>(op);
+             call.thread = static_cast<std::uint32_t>(thread);
+             call.timeNs = timeNs += delta;
+             complete = decodeArguments(decoder, call);
+         }
+         if (!complete) {
+             std::cerr << path << " is truncated or corrupt after " << calls.size() << " calls" << std::endl;
+             return false;
+         }
+         calls.push_back(std::move(call));
+     }
+     return true;
+ }
+
+ } // namespace Trace
@@ -0,0 +1,165 @@
+/**
+ * @file TraceEvents.cpp
+ * @brief Implementation of the Chrome trace-event profiler
+ * @author Your Name
+ * @date February 27, 2025
+ *
+ * This file implements the TraceEvents namespace declared in
+ * TraceEvents.hpp: the shared event buffer, its file and the event
+ * formatting.
+ */
+
+ #include "TraceEvents.hpp"
+ #include <chrono>
+ #include <cstdio>
+ #include <cstdlib>
+ #include <fstream>
+ #include <iostream>
+ #include <mutex>
+
+ namespace {
+
+ /// @brief Buffered bytes at which the buffer is written to the file
+ constexpr std::size_t kChunkSize = 64 * 1024;
+
+ /// @brief Guards everything below
+ std::mutex mutex;
+
+ /// @brief The trace file
+ std::ofstream file;
+
+ /// @brief Events not yet written to the file
+ std::string buffer;
+
+ /// @brief Time the trace started, in steady-clock nanoseconds
+ std::uint64_t originNs = 0;
+
+ /// @brief Source of thread numbers
+ std::atomic<int> nextThread{1};
+
+ /**
+  * @brief Gets the number of the calling thread, assigned on first use
+  * @return Thread number, shown as the tid of its events
+  */
+ int threadNumber() {
+     thread_local int number = nextThread.fetch_add(1);
+     return number;
+ }
+
+ /**
+  * @brief Writes the buffer to the file; the caller holds the mutex
+  */
+ void writeBuffer() {
+     file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+     buffer.clear();
+ }
+
+ } // namespace
+
+ namespace TraceEvents {
+
+ std::atomic<bool> recording{false};
+
+ /**
+  * @brief Implementation of the start function
+  * @param path File to write
+  * @return false if the file cannot be created
+  */
+ bool start(const std::string& path) {
+     std::lock_guard<std::mutex> lock(mutex);
+     if (recording.load()) {
+         return true;
+     }
+     file.open(path, std::ios::binary | std::ios::trunc);
+     if (!file) {
+         std::cerr << "Error creating trace event file " << path << std::endl;
+         return false;
+     }
+     originNs = Span::now();
+     buffer.reserve(kChunkSize + 1024);
+     buffer = "[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+              "\"args\":{\"name\":\"library_management_system\"}}";
+     recording = true;
+
+     static bool registered = false;
+     if (!registered) {
+         registered = true;
+         std::atexit(stop);
+     }
+     return true;
+ }
+
+ /**
+  * @brief Implementation of the startFromEnvironment function
+  * @return false if the variable names a file that cannot be created
+  */
+ bool startFromEnvironment() {
+     const char* path = std::getenv("LIBRARY_TRACE_EVENTS");
+     if (!path || *path == '\0') {
+         return true;
+     }
+     return start(path);
+ }
+
+ /**
+  * @brief Implementation of the stop function
+  */
+ void stop() {
+     std::lock_guard<std::mutex> lock(mutex);
+     if (!recording.load()) {
+         return;
+     }
+     recording = false;
+     buffer += "\n]\n";
+     writeBuffer();
+     file.close();
+ }
+
+ /**
+  * @brief Implementation of the now method
+  * @return Steady-clock nanoseconds
+  */
+ std::uint64_t Span::now() {
+     return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+         std::chrono::steady_clock::now().time_since_epoch()).count());
+ }
+
+ /**
+  * @brief Formats the event and appends it to the buffer
+  *
+  * The event is formatted before the mutex is taken; only the append
+  * (and, once per chunk, the write) happens under it.
+  */
+ void Span::finish() {
+     std::uint64_t endNs = now();
+     char event[512];
+     int length = std::snprintf(event, sizeof(event),
+                                ",\n{\"name\":\"%s\",\"cat\":\"library\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                                "\"ts\":%.3f,\"dur\":%.3f",
+                                name, threadNumber(),
+                                static_cast<double>(startNs - originNs) / 1000.0,
+                                static_cast<double>(endNs - startNs) / 1000.0);
+     for (int i = 0; i < argCount && length > 0 && static_cast<std::size_t>(length) < sizeof(event); ++i) {
+         length += std::snprintf(event + length, sizeof(event) - static_cast<std::size_t>(length),
+                                 "%s\"%s\":%lld", i == 0 ? ",\"args\":{" : ",", keys[i], values[i]);
+     }
+     if (length <= 0 || static_cast<std::size_t>(length) + 2 >= sizeof(event)) {
+         return;
+     }
+     if (argCount > 0) {
+         event[length++] = '}';
+     }
+     event[length++] = '}';
+
+     std::lock_guard<std::mutex> lock(mutex);
+     // Tracing may have stopped (or restarted) while the span was open
+     if (!recording.load() || startNs < originNs) {
+         return;
+     }
+     buffer.append(event, static_cast<std::size_t>(length));
+     if (buffer.size() >= kChunkSize) {
+         writeBuffer();
+     }
+ }
+
+ } // namespace TraceEvents